@@ -165,6 +165,9 @@ def addCommonOptions(parser):
     parser.add_option("-V", "--virtualisation", action="store_true")
 
     parser.add_option("--fastmem", action="store_true")
+    parser.add_option("--block-cache", action="store_true",
+                      help="Reuse decoded basic blocks in the fast-forward "
+                      "CPU")
 
     # dist-gem5 options
     parser.add_option("--dist", action="store_true",
@@ -227,12 +230,26 @@ def addCommonOptions(parser):
                       help="Enable basic block profiling for SimPoints")
     parser.add_option("--simpoint-interval", type="int", default=10000000,
                       help="SimPoint interval in num of instructions")
+    parser.add_option("--simpoint-max-k", type="int", default=0,
+                      help="""Pick SimPoints among up to this many clusters
+                      of the intervals at the end of profiling""")
     parser.add_option("--take-simpoint-checkpoints", action="store", type="string",
         help="<simpoint file,weight file,interval-length,warmup-length>")
     parser.add_option("--restore-simpoint-checkpoint", action="store_true",
         help="restore from a simpoint checkpoint taken with " +
              "--take-simpoint-checkpoints")
 
+    # LoopPoint options
+    parser.add_option("--looppoint-profile", action="store_true",
+        help="Profile the regions of a multi-threaded program for LoopPoint")
+    parser.add_option("--looppoint-region-length", type="int", default=None,
+        help="LoopPoint region length in num of insts of all the threads")
+    parser.add_option("--take-looppoint-checkpoints", action="store",
+        type="string", help="<regions file>[,<simpoints file>]")
+    parser.add_option("--looppoint-end", action="store", type="string",
+        help="<pc>:<count> of the marker ending the region restored " +
+             "from a checkpoint taken with --take-looppoint-checkpoints")
+
     # Checkpointing options
     ###Note that performing checkpointing via python script files will override
     ###checkpoint instructions built into binaries.
@@ -263,6 +280,11 @@ def addCommonOptions(parser):
     parser.add_option("--repeat-switch", action="store", type="int",
         default=None,
         help="switch back and forth between CPUs with period <N>")
+    parser.add_option("--sampling", action="store", type="string",
+        default=None,
+        help="Sample the run on the detailed CPU: fast-forward, warm up "
+        "and measure every <period>, given as <period>,<warmup>,<measure> "
+        "instructions")
     parser.add_option("-s", "--standard-switch", action="store", type="int",
         default=None,
         help="switch from timing to Detailed CPU after warmup period of <N>")
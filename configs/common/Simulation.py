@@ -78,7 +78,7 @@ def setCPUClass(options):
         if options.restore_with_cpu != options.cpu_type:
             CPUClass = TmpClass
             TmpClass, test_mem_mode = getCPUClass(options.restore_with_cpu)
-    elif options.fast_forward:
+    elif options.fast_forward or options.sampling:
         CPUClass = TmpClass
         TmpClass = AtomicSimpleCPU
         test_mem_mode = 'atomic'
@@ -401,6 +401,95 @@ def restoreSimpointCheckpoint():
     print 'Exiting @ tick %i because %s' % (m5.curTick(), exit_cause)
     sys.exit(exit_event.getCode())
 
+def parseLoopPointRegions(options):
+    """Read the regions to take checkpoints of, which are all the regions
+    found when profiling, or those picked in a SimPoint file"""
+    files = options.take_looppoint_checkpoints.split(",")
+
+    regions = []
+    for line in open(files[0]):
+        if line.startswith("#"):
+            continue
+        region, start_pc, start_count, end_pc, end_count, insts = \
+            line.split()
+        regions.append((int(region), int(start_pc, 0), int(start_count),
+                        int(end_pc, 0), int(end_count)))
+
+    if len(files) > 1:
+        picked = set(int(line.split()[0]) for line in open(files[1]))
+        regions = [r for r in regions if r[0] in picked]
+
+    return regions
+
+def addLoopPoint(options, testsys):
+    if options.take_looppoint_checkpoints and options.looppoint_end:
+        fatal("Can't specify both --take-looppoint-checkpoints and "
+              "--looppoint-end")
+
+    # Follow the threads on the CPUs they are switched to as well, e.g.
+    # the detailed CPUs of --restore-with-cpu
+    switch_cpus = []
+    for name in ["switch_cpus", "switch_cpus_1", "repeat_switch_cpus"]:
+        cpus = getattr(testsys, name, None)
+        if cpus:
+            switch_cpus += cpus
+
+    testsys.looppoint = LoopPoint(cpus = testsys.cpu,
+                                  switch_cpus = switch_cpus)
+    looppoint = testsys.looppoint
+    if options.looppoint_region_length:
+        looppoint.region_length = options.looppoint_region_length
+    if not options.looppoint_profile:
+        looppoint.profile_file = ""
+        looppoint.regions_file = ""
+
+    # Exit at the markers starting the regions to take checkpoints of,
+    # except for a region starting with the program, or at the marker
+    # ending the region restored
+    regions = []
+    if options.take_looppoint_checkpoints:
+        regions = parseLoopPointRegions(options)
+        starts = [(r[1], r[2]) for r in regions if r[1] != 0 or r[2] != 0]
+        looppoint.exit_pcs = [pc for (pc, count) in starts]
+        looppoint.exit_counts = [count for (pc, count) in starts]
+    elif options.looppoint_end:
+        pc, count = options.looppoint_end.split(":")
+        looppoint.exit_pcs = [int(pc, 0)]
+        looppoint.exit_counts = [int(count)]
+
+    return regions
+
+def takeLoopPointCheckpoints(regions, cptdir):
+    num_checkpoints = 0
+    exit_cause = "all LoopPoint checkpoints taken"
+    code = 0
+    for (region, start_pc, start_count, end_pc, end_count) in regions:
+        # The markers are reached in the order of the regions
+        if start_pc != 0 or start_count != 0:
+            exit_event = m5.simulate()
+
+            # skip checkpoint instructions should they exist
+            while exit_event.getCause() == "checkpoint":
+                print "Found 'checkpoint' exit event...ignoring..."
+                exit_event = m5.simulate()
+
+            exit_cause = exit_event.getCause()
+            code = exit_event.getCode()
+            if exit_cause != "looppoint marker reached":
+                break
+
+        # The name holds the marker to pass to --looppoint-end
+        m5.checkpoint(joinpath(cptdir,
+            "cpt.looppoint_%02d_region_%d_end_%#x_%d"
+            % (num_checkpoints, region, end_pc, end_count)))
+        print "Checkpoint #%d written. region:%d end marker:%#x:%d" % \
+            (num_checkpoints, region, end_pc, end_count)
+        num_checkpoints += 1
+
+    print 'Exiting @ tick %i because %s' % (m5.curTick(), exit_cause)
+    print "%d checkpoints taken" % num_checkpoints
+    sys.exit(code)
+
 def repeatSwitch(testsys, repeat_switch_cpu_list, maxtick, switch_freq):
     print "starting switch loop"
     while True:
@@ -421,6 +510,22 @@ def repeatSwitch(testsys, repeat_switch_cpu_list, maxtick, switch_freq):
             exit_event = m5.simulate(maxtick - m5.curTick())
             return exit_event
 
+def runSampling(testsys, switch_cpu_list, maxtick):
+    """Switch CPUs whenever the sampling controller asks for it."""
+    to_fast_list = [(new_cpu, old_cpu) for old_cpu, new_cpu in switch_cpu_list]
+
+    print "starting sampling loop"
+    while True:
+        exit_event = m5.simulate(maxtick - m5.curTick())
+        exit_cause = exit_event.getCause()
+
+        if exit_cause == "sampling: switch to detailed":
+            m5.switchCpus(testsys, switch_cpu_list, verbose=False)
+        elif exit_cause == "sampling: switch to fast":
+            m5.switchCpus(testsys, to_fast_list, verbose=False)
+        else:
+            return exit_event
+
 def run(options, root, testsys, cpu_class):
     if options.checkpoint_dir:
         cptdir = options.checkpoint_dir
@@ -441,6 +546,13 @@ def run(options, root, testsys, cpu_class):
     if options.repeat_switch and options.take_checkpoints:
         fatal("Can't specify both --repeat-switch and --take-checkpoints")
 
+    if options.sampling and (options.fast_forward or
+                             options.checkpoint_restore != None or
+                             options.standard_switch or
+                             options.repeat_switch):
+        fatal("Can't combine --sampling with --fast-forward, "
+              "--checkpoint-restore, --standard-switch or --repeat-switch")
+
     np = options.num_cpus
     switch_cpus = None
 
@@ -459,6 +571,8 @@ def run(options, root, testsys, cpu_class):
         for i in xrange(np):
             if options.fast_forward:
                 testsys.cpu[i].max_insts_any_thread = int(options.fast_forward)
+                if options.block_cache:
+                    testsys.cpu[i].block_cache = True
             switch_cpus[i].system = testsys
             switch_cpus[i].workload = testsys.cpu[i].workload
             switch_cpus[i].clk_domain = testsys.cpu[i].clk_domain
@@ -479,6 +593,18 @@ def run(options, root, testsys, cpu_class):
         testsys.switch_cpus = switch_cpus
         switch_cpu_list = [(testsys.cpu[i], switch_cpus[i]) for i in xrange(np)]
 
+    if options.sampling:
+        try:
+            period, warmup, measure = \
+                [int(x) for x in options.sampling.split(',')]
+        except ValueError:
+            fatal("--sampling takes <period>,<warmup>,<measure>")
+
+        testsys.sampler = SamplingController(fast_cpus=testsys.cpu,
+                                             detailed_cpus=switch_cpus,
+                                             period=period, warmup=warmup,
+                                             measure=measure)
+
     if options.repeat_switch:
         switch_class = getCPUClass(options.cpu_type)[0]
         if switch_class.require_caches() and \
@@ -583,6 +709,10 @@ def run(options, root, testsys, cpu_class):
     if options.take_simpoint_checkpoints != None:
         simpoints, interval_length = parseSimpointAnalysisFile(options, testsys)
 
+    if options.looppoint_profile or options.take_looppoint_checkpoints or \
+       options.looppoint_end:
+        looppoint_regions = addLoopPoint(options, testsys)
+
     checkpoint_dir = None
     if options.checkpoint_restore:
         cpt_starttick, checkpoint_dir = findCptDir(options, cptdir, testsys)
@@ -630,7 +760,7 @@ def run(options, root, testsys, cpu_class):
         fatal("Bad maxtick (%d) specified: " \
               "Checkpoint starts starts from tick: %d", maxtick, cpt_starttick)
 
-    if options.standard_switch or cpu_class:
+    if (options.standard_switch or cpu_class) and not options.sampling:
         if options.standard_switch:
             print "Switch at instruction count:%s" % \
                     str(testsys.cpu[0].max_insts_any_thread)
@@ -664,8 +794,8 @@ def run(options, root, testsys, cpu_class):
     # option only for finding the checkpoints to restore from.  This
     # lets us test checkpointing by restoring from one set of
     # checkpoints, generating a second set, and then comparing them.
-    if (options.take_checkpoints or options.take_simpoint_checkpoints) \
-        and options.checkpoint_restore:
+    if (options.take_checkpoints or options.take_simpoint_checkpoints or
+        options.take_looppoint_checkpoints) and options.checkpoint_restore:
 
         if m5.options.outdir:
             cptdir = m5.options.outdir
@@ -687,6 +817,10 @@ def run(options, root, testsys, cpu_class):
     elif options.restore_simpoint_checkpoint != None:
         restoreSimpointCheckpoint()
 
+    # Take LoopPoint checkpoints
+    elif options.take_looppoint_checkpoints:
+        takeLoopPointCheckpoints(looppoint_regions, cptdir)
+
     else:
         if options.fast_forward:
             m5.stats.reset()
@@ -694,7 +828,9 @@ def run(options, root, testsys, cpu_class):
 
         # If checkpoints are being taken, then the checkpoint instruction
         # will occur in the benchmark code it self.
-        if options.repeat_switch and maxtick > options.repeat_switch:
+        if options.sampling:
+            exit_event = runSampling(testsys, switch_cpu_list, maxtick)
+        elif options.repeat_switch and maxtick > options.repeat_switch:
             exit_event = repeatSwitch(testsys, repeat_switch_cpu_list,
                                       maxtick, options.repeat_switch)
         else:
@@ -51,6 +51,9 @@ from common.Caches import *
 
 parser = optparse.OptionParser()
 Options.addCommonOptions(parser)
+parser.add_option("--trace-decode-ahead", type="int", default=0,
+                  help="""Number of windows of the data dependency trace
+                  each Trace CPU reads ahead on a helper thread""")
 
 if '--ruby' in sys.argv:
     print "This script does not support Ruby configuration, mainly"\
@@ -69,15 +72,21 @@ if options.cpu_type != "TraceCPU":
     fatal("This is a script for elastic trace replay simulation, use "\
             "--cpu-type=TraceCPU\n");
 
-if options.num_cpus > 1:
-    fatal("This script does not support multi-processor trace replay.\n")
+# Each CPU replays its own pair of traces, given as comma-separated lists
+inst_trace_files = options.inst_trace_file.split(',')
+data_trace_files = options.data_trace_file.split(',')
+if len(inst_trace_files) != options.num_cpus or \
+   len(data_trace_files) != options.num_cpus:
+    fatal("Expected an instruction and a data dependency trace file for "\
+          "each of the %d CPUs\n" % options.num_cpus)
 
 # In this case FutureClass will be None as there is not fast forwarding or
 # switching
 (CPUClass, test_mem_mode, FutureClass) = Simulation.setCPUClass(options)
 CPUClass.numThreads = numThreads
 
-system = System(cpu = CPUClass(cpu_id=0),
+system = System(cpu = [CPUClass(cpu_id=i)
+                       for i in xrange(options.num_cpus)],
                 mem_mode = test_mem_mode,
                 mem_ranges = [AddrRange(options.mem_size)],
                 cache_line_size = options.cacheline_size)
@@ -104,9 +113,12 @@ system.cpu_clk_domain = SrcClockDomain(clock = options.cpu_clock,
 for cpu in system.cpu:
     cpu.clk_domain = system.cpu_clk_domain
 
-# Assign input trace files to the Trace CPU
-system.cpu.instTraceFile=options.inst_trace_file
-system.cpu.dataTraceFile=options.data_trace_file
+# Assign input trace files to the Trace CPUs
+for (cpu, inst_trace_file, data_trace_file) in \
+        zip(system.cpu, inst_trace_files, data_trace_files):
+    cpu.instTraceFile = inst_trace_file
+    cpu.dataTraceFile = data_trace_file
+    cpu.decodeAhead = options.trace_decode_ahead
 
 # Configure the classic memory system options
 MemClass = Simulation.setMemClass(options)
@@ -213,7 +213,8 @@ def build_test_system(np):
             if options.fastmem:
                 test_sys.cpu[i].fastmem = True
             if options.simpoint_profile:
-                test_sys.cpu[i].addSimPointProbe(options.simpoint_interval)
+                test_sys.cpu[i].addSimPointProbe(options.simpoint_interval,
+                                                 options.simpoint_max_k)
             if options.checker:
                 test_sys.cpu[i].addCheckerCpu()
             test_sys.cpu[i].createThreads()
@@ -36,6 +36,7 @@ addToPath('../')
 
 from common import Options
 from ruby import Ruby
+from network import Network
 
 # Get paths we might need.  It's expected this file is in m5/configs/example.
 config_path = os.path.dirname(os.path.abspath(__file__))
@@ -147,6 +148,12 @@ root.system.mem_mode = 'timing'
 # Not much point in this being higher than the L1 latency
 m5.ticks.setGlobalFrequency('1ns')
 
+# Routers spread across several event queues only communicate through
+# links, so the link latency bounds the simulation quantum
+if options.network_partitions > 1:
+    m5.ticks.fixGlobalFrequency()
+    root.sim_quantum = Network.sim_quantum(options)
+
 # instantiate configuration
 m5.instantiate()
 
@@ -242,7 +242,8 @@ for i in xrange(np):
         system.cpu[i].fastmem = True
 
     if options.simpoint_profile:
-        system.cpu[i].addSimPointProbe(options.simpoint_interval)
+        system.cpu[i].addSimPointProbe(options.simpoint_interval,
+                                       options.simpoint_max_k)
 
     if options.checker:
         system.cpu[i].addCheckerCpu()
@@ -65,7 +65,9 @@ def define_options(parser):
                       help="""routing algorithm in network.
                             0: weight-based table
                             1: XY (for Mesh. see garnet2.0/RoutingUnit.cc)
-                            2: Custom (see garnet2.0/RoutingUnit.cc""")
+                            2: Custom (see garnet2.0/RoutingUnit.cc)
+                            3: West-first adaptive (for Mesh)
+                            4: Odd-even adaptive (for Mesh)""")
     parser.add_option("--network-fault-model", action="store_true",
                       default=False,
                       help="""enable network fault model:
@@ -73,6 +75,23 @@ def define_options(parser):
     parser.add_option("--garnet-deadlock-threshold", action="store",
                       type="int", default=50000,
                       help="network-level deadlock threshold.")
+    parser.add_option("--garnet-telemetry-interval", action="store",
+                      type="int", default=0,
+                      help="""cycles between samples of per-link
+                            utilization and per-VC occupancy written to
+                            the output directory. 0 disables sampling.""")
+    parser.add_option("--network-analytical", action="store_true",
+                      default=False,
+                      help="""start garnet in analytical mode, where
+                            messages bypass the routers with a queueing
+                            model latency. Switch to the detailed model
+                            with network.setAnalyticalMode(False).""")
+    parser.add_option("--network-partitions", action="store", type="int",
+                      default=1,
+                      help="""number of event queues the garnet routers
+                            are partitioned across. Partitions are
+                            simulated in parallel with the minimum link
+                            latency as simulation quantum.""")
 
 
 def create_network(options, ruby):
@@ -107,6 +126,8 @@ def init_network(options, network, InterfaceClass):
         network.ni_flit_size = options.link_width_bits / 8
         network.routing_algorithm = options.routing_algorithm
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
+        network.analytical_mode = options.network_analytical
+        network.telemetry_interval = options.garnet_telemetry_interval
 
     if options.network == "simple":
         network.setup_buffers()
@@ -116,7 +137,48 @@ def init_network(options, network, InterfaceClass):
                   for (i,n) in enumerate(network.ext_links)]
         network.netifs = netifs
 
+    if options.network_partitions > 1:
+        assert(options.network == "garnet2.0")
+        partition_network(options, network)
+
     if options.network_fault_model:
         assert(options.network == "garnet2.0")
         network.enable_fault_model = True
         network.fault_model = FaultModel()
+
+def partition_network(options, network):
+    """Spread the garnet routers across options.network_partitions event
+    queues. Routers are split into blocks of consecutive ids, i.e. bands of
+    rows in a mesh, which keeps the number of links crossing partitions
+    low. Network interfaces stay on event queue 0 with the controllers
+    they serve. Each link runs on the event queue of the router or network
+    interface feeding it."""
+
+    num_routers = len(network.routers)
+    parts = min(options.network_partitions, num_routers)
+
+    def eventq(router):
+        return router.router_id * parts / num_routers
+
+    for router in network.routers:
+        router.eventq_index = eventq(router)
+
+    for link in network.int_links:
+        link.network_link.eventq_index = eventq(link.src_node)
+        link.credit_link.eventq_index = eventq(link.dst_node)
+
+    for link in network.ext_links:
+        # In: network interface to router, Out: router to network interface
+        link.network_links[0].eventq_index = 0
+        link.credit_links[0].eventq_index = eventq(link.int_node)
+        link.network_links[1].eventq_index = eventq(link.int_node)
+        link.credit_links[1].eventq_index = 0
+
+def sim_quantum(options):
+    """Simulation quantum matching the lookahead of a partitioned network,
+    i.e. the latency of the fastest link. Requires a fixed tick
+    frequency."""
+
+    from m5.util.convert import toFrequency
+    return m5.ticks.fromSeconds(
+        float(options.link_latency) / toFrequency(options.ruby_clock))
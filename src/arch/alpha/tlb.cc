@@ -287,12 +287,14 @@ TLB::flushAll()
     flushCache();
     lookupTable.clear();
     nlu = 0;
+    notifyFlush();
 }
 
 void
 TLB::flushProcesses()
 {
     flushCache();
+    notifyFlush();
     PageTable::iterator i = lookupTable.begin();
     PageTable::iterator end = lookupTable.end();
     while (i != end) {
@@ -318,6 +320,7 @@ void
 TLB::flushAddr(Addr addr, uint8_t asn)
 {
     flushCache();
+    notifyFlush();
     VAddr vaddr = addr;
 
     PageTable::iterator i = lookupTable.find(vaddr.vpn());
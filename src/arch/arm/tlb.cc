@@ -255,6 +255,7 @@ TLB::flushAllSecurity(bool secure_lookup, uint8_t target_el, bool ignore_el)
     }
 
     flushTlb++;
+    notifyFlush();
 
     // If there's a second stage TLB (and we're not it) then flush it as well
     // if we're currently in hyp mode
@@ -283,6 +284,7 @@ TLB::flushAllNs(bool hyp, uint8_t target_el, bool ignore_el)
     }
 
     flushTlb++;
+    notifyFlush();
 
     // If there's a second stage TLB (and we're not it) then flush it as well
     if (!isStage2 && !hyp) {
@@ -298,6 +300,7 @@ TLB::flushMvaAsid(Addr mva, uint64_t asn, bool secure_lookup, uint8_t target_el)
             "secure" : "non-secure"));
     _flushMva(mva, asn, secure_lookup, false, false, target_el);
     flushTlbMvaAsid++;
+    notifyFlush();
 }
 
 void
@@ -322,6 +325,7 @@ TLB::flushAsid(uint64_t asn, bool secure_lookup, uint8_t target_el)
         ++x;
     }
     flushTlbAsid++;
+    notifyFlush();
 }
 
 void
@@ -331,6 +335,7 @@ TLB::flushMva(Addr mva, bool secure_lookup, bool hyp, uint8_t target_el)
             (secure_lookup ? "secure" : "non-secure"));
     _flushMva(mva, 0xbeef, secure_lookup, hyp, true, target_el);
     flushTlbMva++;
+    notifyFlush();
 }
 
 void
@@ -358,6 +363,7 @@ TLB::flushIpaVmid(Addr ipa, bool secure_lookup, bool hyp, uint8_t target_el)
 {
     assert(!isStage2);
     stage2Tlb->_flushMva(ipa, 0xbeef, secure_lookup, hyp, true, target_el);
+    notifyFlush();
 }
 
 bool
@@ -557,6 +563,8 @@ TLB::regStats()
 void
 TLB::regProbePoints()
 {
+    BaseTLB::regProbePoints();
+
     ppRefills.reset(new ProbePoints::PMU(getProbeManager(), "Refills"));
 }
 
@@ -46,14 +46,14 @@ BasicDecodeCache::decode(TheISA::Decoder *decoder,
     if (si && (si->machInst == mach_inst))
         return si;
 
-    DecodeCache::InstMap::iterator iter = instMap.find(mach_inst);
-    if (iter != instMap.end()) {
-        si = iter->second;
+    const StaticInstPtr &decoded = instMap.lookup(mach_inst);
+    if (decoded) {
+        si = decoded;
         return si;
     }
 
     si = decoder->decodeInst(mach_inst);
-    instMap[mach_inst] = si;
+    instMap.insert(mach_inst, si);
     return si;
 }
 
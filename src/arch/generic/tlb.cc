@@ -36,6 +36,12 @@
 #include "sim/full_system.hh"
 #include "sim/process.hh"
 
+void
+BaseTLB::regProbePoints()
+{
+    ppFlushes.reset(new ProbePoints::PMU(getProbeManager(), "Flushes"));
+}
+
 Fault
 GenericTLB::translateAtomic(RequestPtr req, ThreadContext *tc, Mode)
 {
@@ -45,6 +45,7 @@
 
 #include "base/misc.hh"
 #include "mem/request.hh"
+#include "sim/probe/pmu.hh"
 #include "sim/sim_object.hh"
 
 class ThreadContext;
@@ -57,10 +58,27 @@ class BaseTLB : public SimObject
         : SimObject(p)
     {}
 
+    /**
+     * Tell the listeners of the Flushes probe point that entries were
+     * flushed or demapped, e.g. so that the CPUs drop the translations
+     * they keep on the side.
+     */
+    void
+    notifyFlush()
+    {
+        if (ppFlushes)
+            ppFlushes->notify(1);
+    }
+
+    /** Notified on each flush or demap of the TLB. */
+    ProbePoints::PMUUPtr ppFlushes;
+
   public:
     enum Mode { Read, Write, Execute };
 
   public:
+    void regProbePoints() override;
+
     virtual void demapPage(Addr vaddr, uint64_t asn) = 0;
 
     /**
@@ -193,6 +193,7 @@ TLB::flushAll()
     memset(table, 0, sizeof(PowerISA::PTE[size]));
     lookupTable.clear();
     nlu = 0;
+    notifyFlush();
 }
 
 void
@@ -196,6 +196,7 @@ TLB::flushAll()
     memset(table, 0, sizeof(PTE[size]));
     lookupTable.clear();
     nlu = 0;
+    notifyFlush();
 }
 
 void
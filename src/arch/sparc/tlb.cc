@@ -260,6 +260,7 @@ TLB::demapPage(Addr va, int partition_id, bool real, int context_id)
             va, partition_id, context_id, real);
 
     cacheValid = false;
+    notifyFlush();
 
     // Assemble full address structure
     tr.va = va;
@@ -288,6 +289,7 @@ TLB::demapContext(int partition_id, int context_id)
     DPRINTF(IPR, "TLB: Demapping Context pid=%#d cid=%d\n",
             partition_id, context_id);
     cacheValid = false;
+    notifyFlush();
     for (int x = 0; x < size; x++) {
         if (tlb[x].range.contextId == context_id &&
             tlb[x].range.partitionId == partition_id) {
@@ -309,6 +311,7 @@ TLB::demapAll(int partition_id)
 {
     DPRINTF(TLB, "TLB: Demapping All pid=%#d\n", partition_id);
     cacheValid = false;
+    notifyFlush();
     for (int x = 0; x < size; x++) {
         if (tlb[x].valid && !tlb[x].pte.locked() &&
                 tlb[x].range.partitionId == partition_id) {
@@ -327,6 +330,7 @@ void
 TLB::flushAll()
 {
     cacheValid = false;
+    notifyFlush();
     lookupTable.clear();
 
     for (int x = 0; x < size; x++) {
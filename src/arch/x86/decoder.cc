@@ -680,12 +680,12 @@ Decoder::InstCacheMap Decoder::instCacheMap;
 StaticInstPtr
 Decoder::decode(ExtMachInst mach_inst, Addr addr)
 {
-    DecodeCache::InstMap::iterator iter = instMap->find(mach_inst);
-    if (iter != instMap->end())
-        return iter->second;
+    const StaticInstPtr &decoded = instMap->lookup(mach_inst);
+    if (decoded)
+        return decoded;
 
     StaticInstPtr si = decodeInst(mach_inst);
-    (*instMap)[mach_inst] = si;
+    instMap->insert(mach_inst, si);
     return si;
 }
 
@@ -137,6 +137,7 @@ TLB::flushAll()
             freeList.push_back(&tlb[i]);
         }
     }
+    notifyFlush();
 }
 
 void
@@ -156,6 +157,7 @@ TLB::flushNonGlobal()
             freeList.push_back(&tlb[i]);
         }
     }
+    notifyFlush();
 }
 
 void
@@ -167,6 +169,7 @@ TLB::demapPage(Addr va, uint64_t asn)
         entry->trieHandle = NULL;
         freeList.push_back(entry);
     }
+    notifyFlush();
 }
 
 Fault
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_trace.hh"
+
+#include <algorithm>
+
+namespace BinaryTrace {
+
+__thread ThreadSlot threadSlot = { 0, NULL };
+
+std::atomic<uint64_t> Writer::lastId(0);
+
+Writer::Writer(std::ostream &stream, size_t chunk_size, unsigned max_chunks)
+    : id(++lastId), stream(stream), chunkSize(chunk_size), maxChunks(max_chunks),
+      writing(false), handedOff(0), writtenOut(0), stopping(false)
+{
+    stream.write(magic, sizeof(magic));
+    stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+
+    writer = std::thread(&Writer::writeOut, this);
+}
+
+Writer::~Writer()
+{
+    flush();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work.notify_one();
+    writer.join();
+}
+
+ThreadBuffer &
+Writer::newBuffer()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    ThreadBuffer *buf = new ThreadBuffer;
+    buf->thread = threads.size();
+    buf->data.resize(chunkSize);
+    buf->used = 0;
+    buf->lastName = NULL;
+    buf->lastNameString = NULL;
+    buf->lastNameId = 0;
+
+    threads.emplace_back(buf);
+    threadSlot.writer = id;
+    threadSlot.buffer = buf;
+    return *buf;
+}
+
+void
+Writer::text(uint64_t when, const std::string &name, const std::string &text)
+{
+    ThreadBuffer &buf = buffer();
+    uint32_t name_id = nameId(buf, name);
+
+    uint8_t *p = claim(buf, 1 + 8 + 4 + 4 + text.size());
+    *p++ = TextRecord;
+    p = put(p, when);
+    p = put(p, name_id);
+    p = put(p, uint32_t(text.size()));
+    memcpy(p, text.data(), text.size());
+}
+
+uint32_t
+Writer::intern(DefinitionKind kind, const std::string &s,
+               const std::string **interned)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto &ids = kind == FormatString ? formats : names;
+    auto it = ids.find(s);
+    if (it == ids.end()) {
+        it = ids.emplace(s, ids.size() + 1).first;
+
+        // The definition goes out before the chunk that holds the first
+        // record using it, as that chunk is handed off later
+        uint8_t header[1 + 1 + 4 + 4];
+        uint8_t *p = header;
+        *p++ = DefinitionBlock;
+        *p++ = kind;
+        p = put(p, it->second);
+        p = put(p, uint32_t(s.size()));
+        definitions.insert(definitions.end(), header, p);
+        definitions.insert(definitions.end(), s.begin(), s.end());
+    }
+
+    *interned = &it->first;
+    return it->second;
+}
+
+void
+Writer::replace(ThreadBuffer &buf, size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (buf.used) {
+        written.wait(lock, [this]{ return pending.size() < maxChunks; });
+
+        Chunk chunk;
+        chunk.thread = buf.thread;
+        chunk.used = buf.used;
+        chunk.data.swap(buf.data);
+        pending.push_back(std::move(chunk));
+        ++handedOff;
+        work.notify_one();
+
+        if (!spare.empty()) {
+            buf.data.swap(spare.back());
+            spare.pop_back();
+        }
+        buf.used = 0;
+    }
+
+    // Records larger than a chunk get a chunk of their own
+    buf.data.resize(std::max(chunkSize, bytes));
+}
+
+void
+Writer::flush()
+{
+    for (auto &buf : threads) {
+        if (buf->used)
+            replace(*buf, 0);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    work.notify_one();
+    written.wait(lock, [this]{
+        return pending.empty() && definitions.empty() && !writing;
+    });
+    stream.flush();
+}
+
+void
+Writer::flushThread()
+{
+    if (threadSlot.writer == id && threadSlot.buffer->used)
+        replace(*threadSlot.buffer, 0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t last = handedOff;
+    work.notify_one();
+    written.wait(lock, [this, last]{ return writtenOut >= last; });
+}
+
+void
+Writer::writeOut()
+{
+    std::vector<uint8_t> defs;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        work.wait(lock, [this]{
+            return stopping || !pending.empty() || !definitions.empty();
+        });
+        if (stopping && pending.empty() && definitions.empty())
+            break;
+
+        // Take the definitions along with the chunk, so that the
+        // definitions of all the IDs the chunk uses are written first
+        defs.clear();
+        defs.swap(definitions);
+        bool have_chunk = !pending.empty();
+        Chunk chunk;
+        if (have_chunk) {
+            chunk = std::move(pending.front());
+            pending.pop_front();
+        }
+        writing = true;
+        lock.unlock();
+
+        stream.write(reinterpret_cast<const char *>(defs.data()),
+                     defs.size());
+        if (have_chunk) {
+            uint8_t header[1 + 4 + 4];
+            uint8_t *p = header;
+            *p++ = ChunkBlock;
+            p = put(p, chunk.thread);
+            p = put(p, uint32_t(chunk.used));
+            stream.write(reinterpret_cast<const char *>(header),
+                         sizeof(header));
+            stream.write(reinterpret_cast<const char *>(chunk.data.data()),
+                         chunk.used);
+            // Keep what was written safe from an abort, see flushThread()
+            stream.flush();
+        }
+
+        lock.lock();
+        writing = false;
+        if (have_chunk)
+            ++writtenOut;
+        if (have_chunk && chunk.data.size() == chunkSize)
+            spare.push_back(std::move(chunk.data));
+        written.notify_all();
+    }
+}
+
+} // namespace BinaryTrace
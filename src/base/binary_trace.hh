@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Binary format of the debug trace and the writer that records it. A
+ * message is recorded as the IDs of its format string and object name
+ * followed by its raw arguments, and is only formatted when the trace is
+ * decoded offline by util/debugtrace, which reproduces the text that
+ * Trace::OstreamLogger would have written.
+ *
+ * A trace starts with the magic and version, followed by blocks:
+ *   Definition: type, kind, id (u32), length (u32), the string
+ *   Chunk:      type, thread (u32), length (u32), the records
+ *
+ * The records of a chunk are:
+ *   Message: type, when (u64), name id (u32), format id (u32),
+ *            argument count (u8), and each argument as its type and value
+ *   Text:    type, when (u64), name id (u32), length (u32), the text
+ *
+ * Strings are prefixed by their length (u32). Values are written in the
+ * byte order of the host that records the trace, and name id 0 is the
+ * empty name.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/binary_trace_args.hh"
+
+namespace BinaryTrace {
+
+static const char magic[8] = { 'g', '5', 'd', 'b', 'g', 't', 'r', 'c' };
+static const uint32_t version = 1;
+
+enum BlockType : uint8_t { DefinitionBlock = 1, ChunkBlock = 2 };
+enum DefinitionKind : uint8_t { FormatString = 1, ObjectName = 2 };
+enum RecordType : uint8_t { MessageRecord = 1, TextRecord = 2 };
+
+class Writer;
+
+/** Records of a simulation thread that are not handed off yet */
+struct ThreadBuffer
+{
+    uint32_t thread;
+    std::vector<uint8_t> data;
+    size_t used;
+
+    /** Last format strings and name seen, with the IDs they map to */
+    std::unordered_map<const char *, std::pair<const std::string *,
+                                               uint32_t>> formats;
+    const char *lastName;
+    const std::string *lastNameString;
+    uint32_t lastNameId;
+};
+
+/**
+ * Buffer of the calling thread, with the ID of the writer it belongs to.
+ * The IDs are never reused, so the slot of a thread still naming a
+ * deleted writer and its freed buffer is never mistaken for a new one.
+ */
+struct ThreadSlot
+{
+    uint64_t writer;
+    ThreadBuffer *buffer;
+};
+
+/** Slot of the calling thread, with writer 0 before its first record */
+extern __thread ThreadSlot threadSlot;
+
+/**
+ * Records messages in the binary format. Each simulation thread appends
+ * to a buffer of its own without taking any lock. Full buffers are
+ * handed off to a background thread that writes them to the output, and
+ * replaced with one the background thread has written out already.
+ */
+class Writer
+{
+  public:
+    /**
+     * @param chunk_size Size of the buffers handed off to be written.
+     * @param max_chunks Buffers that may be waiting to be written before
+     *                   the simulation threads wait for them.
+     */
+    Writer(std::ostream &stream, size_t chunk_size = 1 << 20,
+           unsigned max_chunks = 16);
+    ~Writer();
+
+    /**
+     * Start a message record with room for its raw arguments, which the
+     * caller encodes with putArgs().
+     * @return Where the arguments go.
+     */
+    uint8_t *
+    message(uint64_t when, const std::string &name, const char *fmt,
+            uint8_t num_args, size_t args_size)
+    {
+        ThreadBuffer &buf = buffer();
+        uint32_t name_id = nameId(buf, name);
+        uint32_t format_id = formatId(buf, fmt);
+
+        uint8_t *p = claim(buf, 1 + 8 + 4 + 4 + 1 + args_size);
+        *p++ = MessageRecord;
+        p = put(p, when);
+        p = put(p, name_id);
+        p = put(p, format_id);
+        *p++ = num_args;
+        return p;
+    }
+
+    /** Record a message that is formatted already */
+    void text(uint64_t when, const std::string &name,
+              const std::string &text);
+
+    /**
+     * Write out everything that was recorded. This must only be called
+     * when the other simulation threads do not record anything.
+     */
+    void flush();
+
+    /**
+     * Write out what the calling thread recorded, and whatever the other
+     * threads handed off before. Unlike flush(), this is safe while the
+     * other threads record, but what they still buffer is left out.
+     */
+    void flushThread();
+
+  private:
+    ThreadBuffer &
+    buffer()
+    {
+        return threadSlot.writer == id ? *threadSlot.buffer : newBuffer();
+    }
+
+    ThreadBuffer &newBuffer();
+
+    uint32_t
+    nameId(ThreadBuffer &buf, const std::string &name)
+    {
+        if (name.empty())
+            return 0;
+        if (name.data() != buf.lastName || name != *buf.lastNameString) {
+            buf.lastNameId = intern(ObjectName, name, &buf.lastNameString);
+            buf.lastName = name.data();
+        }
+        return buf.lastNameId;
+    }
+
+    uint32_t
+    formatId(ThreadBuffer &buf, const char *fmt)
+    {
+        // Format strings are almost always literals, but check that the
+        // string did not change in case one was built at run time
+        auto it = buf.formats.find(fmt);
+        if (it != buf.formats.end() && *it->second.first == fmt)
+            return it->second.second;
+
+        auto &entry = buf.formats[fmt];
+        entry.second = intern(FormatString, fmt, &entry.first);
+        return entry.second;
+    }
+
+    /** Get the ID of a string, and record its definition if it is new */
+    uint32_t intern(DefinitionKind kind, const std::string &s,
+                    const std::string **interned);
+
+    /** Room for a record in the buffer of a thread */
+    uint8_t *
+    claim(ThreadBuffer &buf, size_t bytes)
+    {
+        if (buf.used + bytes > buf.data.size())
+            replace(buf, bytes);
+        uint8_t *p = buf.data.data() + buf.used;
+        buf.used += bytes;
+        return p;
+    }
+
+    /** Hand off the buffer of a thread and give it an empty one */
+    void replace(ThreadBuffer &buf, size_t bytes);
+
+    void writeOut();
+
+    /** Last ID given to a writer */
+    static std::atomic<uint64_t> lastId;
+    /** ID of this writer in the slots of the threads, never 0 */
+    const uint64_t id;
+
+    std::ostream &stream;
+
+    const size_t chunkSize;
+    const unsigned maxChunks;
+
+    std::mutex mutex;
+    /** Signals the background thread that there is work */
+    std::condition_variable work;
+    /** Signals the simulation threads that a chunk was written */
+    std::condition_variable written;
+
+    struct Chunk
+    {
+        uint32_t thread;
+        std::vector<uint8_t> data;
+        size_t used;
+    };
+
+    /** Chunks waiting to be written, and written ones to reuse */
+    std::deque<Chunk> pending;
+    std::vector<std::vector<uint8_t>> spare;
+    /** Chunk the background thread is writing */
+    bool writing;
+    /** Chunks handed off and written since the start */
+    uint64_t handedOff;
+    uint64_t writtenOut;
+
+    /** Definitions to write before the pending chunks */
+    std::vector<uint8_t> definitions;
+    std::unordered_map<std::string, uint32_t> formats;
+    std::unordered_map<std::string, uint32_t> names;
+
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+
+    bool stopping;
+    std::thread writer;
+};
+
+} // namespace BinaryTrace
+
+#endif // __BASE_BINARY_TRACE_HH__
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Encoding of the raw arguments of the messages of the binary debug
+ * trace, see base/binary_trace.hh. It is kept apart from the writer so
+ * that base/trace.hh can record the arguments without pulling in the
+ * threading of the writer.
+ */
+
+#ifndef __BASE_BINARY_TRACE_ARGS_HH__
+#define __BASE_BINARY_TRACE_ARGS_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace BinaryTrace {
+
+/**
+ * Types of the arguments that are recorded raw. They are the types the
+ * formatting functions of cprintf tell apart, so that a decoded argument
+ * formats exactly like the original one.
+ */
+enum ArgType : uint8_t {
+    BoolArg = 1,
+    CharArg,
+    SCharArg,
+    UCharArg,
+    ShortArg,
+    UShortArg,
+    IntArg,
+    UIntArg,
+    LongArg,
+    ULongArg,
+    LongLongArg,
+    ULongLongArg,
+    FloatArg,
+    DoubleArg,
+    StringArg
+};
+
+/** Arguments of other types are formatted when the message is logged */
+template <typename T>
+struct Arg
+{
+    static const bool raw = false;
+};
+
+template <typename T, ArgType Type>
+struct ScalarArg
+{
+    static const bool raw = true;
+    static const ArgType type = Type;
+
+    static size_t size(const T &) { return 1 + sizeof(T); }
+
+    static uint8_t *
+    put(uint8_t *p, const T &value)
+    {
+        *p++ = type;
+        memcpy(p, &value, sizeof(T));
+        return p + sizeof(T);
+    }
+};
+
+template <> struct Arg<bool> : ScalarArg<bool, BoolArg> {};
+template <> struct Arg<char> : ScalarArg<char, CharArg> {};
+template <> struct Arg<signed char> : ScalarArg<signed char, SCharArg> {};
+template <> struct Arg<unsigned char>
+    : ScalarArg<unsigned char, UCharArg> {};
+template <> struct Arg<short> : ScalarArg<short, ShortArg> {};
+template <> struct Arg<unsigned short>
+    : ScalarArg<unsigned short, UShortArg> {};
+template <> struct Arg<int> : ScalarArg<int, IntArg> {};
+template <> struct Arg<unsigned int> : ScalarArg<unsigned int, UIntArg> {};
+template <> struct Arg<long> : ScalarArg<long, LongArg> {};
+template <> struct Arg<unsigned long>
+    : ScalarArg<unsigned long, ULongArg> {};
+template <> struct Arg<long long> : ScalarArg<long long, LongLongArg> {};
+template <> struct Arg<unsigned long long>
+    : ScalarArg<unsigned long long, ULongLongArg> {};
+template <> struct Arg<float> : ScalarArg<float, FloatArg> {};
+template <> struct Arg<double> : ScalarArg<double, DoubleArg> {};
+
+struct StringArgBase
+{
+    static const bool raw = true;
+    static const ArgType type = StringArg;
+
+    static uint8_t *
+    putString(uint8_t *p, const char *data, uint32_t len)
+    {
+        *p++ = type;
+        memcpy(p, &len, sizeof(len));
+        p += sizeof(len);
+        memcpy(p, data, len);
+        return p + len;
+    }
+};
+
+template <>
+struct Arg<std::string> : StringArgBase
+{
+    static size_t size(const std::string &s) { return 5 + s.size(); }
+
+    static uint8_t *
+    put(uint8_t *p, const std::string &s)
+    {
+        return putString(p, s.data(), s.size());
+    }
+};
+
+template <>
+struct Arg<const char *> : StringArgBase
+{
+    static size_t size(const char *s) { return 5 + strlen(s); }
+
+    static uint8_t *
+    put(uint8_t *p, const char *s)
+    {
+        return putString(p, s, strlen(s));
+    }
+};
+
+template <> struct Arg<char *> : Arg<const char *> {};
+template <size_t N> struct Arg<char[N]> : Arg<const char *> {};
+
+template <typename ...Args>
+struct AllRaw;
+
+template <>
+struct AllRaw<>
+{
+    static const bool value = true;
+};
+
+template <typename T, typename ...Args>
+struct AllRaw<T, Args...>
+{
+    static const bool value = Arg<T>::raw && AllRaw<Args...>::value;
+};
+
+inline size_t argsSize() { return 0; }
+
+template <typename T, typename ...Args>
+inline size_t
+argsSize(const T &value, const Args &...args)
+{
+    return Arg<T>::size(value) + argsSize(args...);
+}
+
+inline uint8_t *putArgs(uint8_t *p) { return p; }
+
+template <typename T, typename ...Args>
+inline uint8_t *
+putArgs(uint8_t *p, const T &value, const Args &...args)
+{
+    return putArgs(Arg<T>::put(p, value), args...);
+}
+
+template <typename T>
+inline uint8_t *
+put(uint8_t *p, const T &value)
+{
+    memcpy(p, &value, sizeof(T));
+    return p + sizeof(T);
+}
+
+} // namespace BinaryTrace
+
+#endif // __BASE_BINARY_TRACE_ARGS_HH__
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_CIRCULAR_QUEUE_HH__
+#define __BASE_CIRCULAR_QUEUE_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+
+/**
+ * FIFO queue backed by a circular vector
+ *
+ * Elements are pushed at the back and normally popped at the front,
+ * although the youngest elements can be popped from the back when they
+ * are squashed. Elements are addressed by the number of pushes that
+ * preceded them, which is reduced to a slot of the backing store when
+ * they are accessed. An iterator therefore stays valid until its element
+ * is popped, no matter how many elements are pushed or popped around it
+ * or whether the backing store grows, and the end iterator keeps
+ * designating the end of the queue.
+ *
+ * The backing store only grows when an element is pushed to a full
+ * queue, so reserving the maximum number of elements up front keeps
+ * the queue from allocating memory once it is in use.
+ *
+ * Popping an element assigns a default constructed value to its slot, so
+ * that reference counted elements are released right away.
+ */
+template <typename T>
+class CircularQueue
+{
+  public:
+    typedef T value_type;
+
+    class iterator
+    {
+      public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        iterator() : queue(NULL), idx(end_idx) {}
+
+        T &operator*() const { return queue->at(idx); }
+        T *operator->() const { return &queue->at(idx); }
+
+        iterator &
+        operator++()
+        {
+            assert(idx != end_idx);
+            if (++idx == queue->tail)
+                idx = end_idx;
+            return *this;
+        }
+
+        iterator
+        operator++(int)
+        {
+            iterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        iterator &
+        operator--()
+        {
+            if (idx == end_idx) {
+                assert(!queue->empty());
+                idx = queue->tail - 1;
+            } else {
+                assert(idx != queue->head);
+                --idx;
+            }
+            return *this;
+        }
+
+        iterator
+        operator--(int)
+        {
+            iterator it(*this);
+            --*this;
+            return it;
+        }
+
+        bool
+        operator==(const iterator &other) const
+        {
+            return queue == other.queue && idx == other.idx;
+        }
+
+        bool operator!=(const iterator &other) const
+        { return !(*this == other); }
+
+      private:
+        friend class CircularQueue;
+
+        static const uint64_t end_idx = UINT64_MAX;
+
+        iterator(CircularQueue *_queue, uint64_t _idx)
+            : queue(_queue), idx(_idx)
+        {}
+
+        CircularQueue *queue;
+        /** Push count of the element, or end_idx past the last one */
+        uint64_t idx;
+    };
+
+    explicit CircularQueue(size_t n = 0)
+        : mask(-1), head(0), tail(0)
+    {
+        reserve(n);
+    }
+
+    /** Make room for at least n elements. */
+    void
+    reserve(size_t n)
+    {
+        if (n <= buf.size())
+            return;
+
+        std::vector<T> new_buf(ceilPow2(n));
+        uint64_t new_mask = new_buf.size() - 1;
+        for (uint64_t idx = head; idx != tail; ++idx)
+            std::swap(new_buf[idx & new_mask], buf[idx & mask]);
+
+        buf.swap(new_buf);
+        mask = new_mask;
+    }
+
+    size_t capacity() const { return buf.size(); }
+    size_t size() const { return tail - head; }
+    bool empty() const { return head == tail; }
+
+    T &front() { assert(!empty()); return buf[head & mask]; }
+    const T &front() const { assert(!empty()); return buf[head & mask]; }
+    T &back() { assert(!empty()); return buf[(tail - 1) & mask]; }
+    const T &back() const { assert(!empty()); return buf[(tail - 1) & mask]; }
+
+    void
+    push_back(const T &value)
+    {
+        if (size() == buf.size())
+            reserve(buf.size() ? buf.size() * 2 : 1);
+        buf[tail++ & mask] = value;
+    }
+
+    void
+    pop_front()
+    {
+        assert(!empty());
+        buf[head++ & mask] = T();
+    }
+
+    void
+    pop_back()
+    {
+        assert(!empty());
+        buf[--tail & mask] = T();
+    }
+
+    void
+    clear()
+    {
+        while (!empty())
+            pop_front();
+    }
+
+    iterator
+    begin()
+    {
+        if (empty())
+            return end();
+        return iterator(this, head);
+    }
+
+    iterator end() { return iterator(this, iterator::end_idx); }
+
+  private:
+    T &
+    at(uint64_t idx)
+    {
+        assert(idx >= head && idx < tail);
+        return buf[idx & mask];
+    }
+
+    std::vector<T> buf;
+    uint64_t mask;
+
+    /** Push counts of the oldest element and of the next one */
+    uint64_t head;
+    uint64_t tail;
+};
+
+#endif // __BASE_CIRCULAR_QUEUE_HH__
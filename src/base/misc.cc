@@ -111,4 +111,8 @@ ExitLogger::printEpilogue(const char *func, const char *file, int line,
     Logger::printEpilogue(func, file, line, format);
 
     ccprintf(stream, "Memory Usage: %ld KBytes\n", memUsage());
+
+    // The debug output leading up to the error is the most useful part.
+    // Other threads may still be logging, so only write out what is safe.
+    Trace::getDebugLogger()->flushThread();
 }
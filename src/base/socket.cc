@@ -33,7 +33,9 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <unistd.h>
 
 #include <cerrno>
@@ -83,11 +85,14 @@ ListenSocket::~ListenSocket()
 {
     if (fd != -1)
         close(fd);
+
+    if (!path.empty())
+        unlink(path.c_str());
 }
 
 // Create a socket and configure it for listening
 bool
-ListenSocket::listen(int port, bool reuse)
+ListenSocket::listen(int port, bool reuse, bool loopback)
 {
     if (listening)
         panic("Socket already listening!");
@@ -106,7 +111,8 @@ ListenSocket::listen(int port, bool reuse)
     struct sockaddr_in sockaddr;
     sockaddr.sin_family = PF_INET;
     sockaddr.sin_addr.s_addr =
-        htobe<unsigned long>(bindToLoopback ? INADDR_LOOPBACK : INADDR_ANY);
+        htobe<unsigned long>(bindToLoopback || loopback ?
+                             INADDR_LOOPBACK : INADDR_ANY);
     sockaddr.sin_port = htons(port);
     // finally clear sin_zero
     memset(&sockaddr.sin_zero, 0, sizeof(sockaddr.sin_zero));
@@ -129,16 +135,53 @@ ListenSocket::listen(int port, bool reuse)
     return true;
 }
 
+// Create a Unix domain socket and configure it for listening
+bool
+ListenSocket::listen(const string &_path)
+{
+    if (listening)
+        panic("Socket already listening!");
+
+    struct sockaddr_un sockaddr;
+    memset(&sockaddr, 0, sizeof(sockaddr));
+    if (_path.size() >= sizeof(sockaddr.sun_path))
+        fatal("Socket path '%s' is too long\n", _path);
+    sockaddr.sun_family = AF_UNIX;
+    strncpy(sockaddr.sun_path, _path.c_str(), sizeof(sockaddr.sun_path) - 1);
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        panic("Can't create socket:%s !", strerror(errno));
+
+    // A socket left behind by a previous run would make bind() fail
+    struct stat st;
+    if (::lstat(_path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+        ::unlink(_path.c_str());
+
+    if (::bind(fd, (struct sockaddr *)&sockaddr, sizeof(sockaddr)) != 0) {
+        if (errno != EADDRINUSE)
+            panic("ListenSocket(listen): bind() failed!");
+        return false;
+    }
+    path = _path;
+
+    if (::listen(fd, 1) == -1)
+        panic("ListenSocket(listen): listen() failed!");
+
+    listening = true;
+    anyListening = true;
+    return true;
+}
 
 // Open a connection.  Accept will block, so if you don't want it to,
 // make sure a connection is ready before you call accept.
 int
 ListenSocket::accept(bool nodelay)
 {
-    struct sockaddr_in sockaddr;
+    struct sockaddr_storage sockaddr;
     socklen_t slen = sizeof (sockaddr);
     int sfd = ::accept(fd, (struct sockaddr *)&sockaddr, &slen);
-    if (sfd != -1 && nodelay) {
+    if (sfd != -1 && nodelay && path.empty()) {
         int i = 1;
         if (::setsockopt(sfd, IPPROTO_TCP, TCP_NODELAY, (char *)&i,
                          sizeof(i)) < 0)
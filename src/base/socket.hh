@@ -31,6 +31,8 @@
 #ifndef __SOCKET_HH__
 #define __SOCKET_HH__
 
+#include <string>
+
 class ListenSocket
 {
   protected:
@@ -48,13 +50,16 @@ class ListenSocket
   protected:
     bool listening;
     int fd;
+    /** Path of a Unix domain socket, removed when the socket is closed */
+    std::string path;
 
   public:
     ListenSocket();
     virtual ~ListenSocket();
 
     virtual int accept(bool nodelay = false);
-    virtual bool listen(int port, bool reuse = true);
+    virtual bool listen(int port, bool reuse = true, bool loopback = false);
+    virtual bool listen(const std::string &path);
 
     int getfd() const { return fd; }
     bool islistening() const { return listening; }
@@ -34,6 +34,7 @@
 #include <iomanip>
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
 
 #include "base/callback.hh"
@@ -123,6 +124,43 @@ nameMap()
 
 int Info::id_count = 0;
 
+__thread vector<Counter> *threadShard = NULL;
+
+static size_type numShardSlots = 0;
+static mutex shardMutex;
+
+static vector<vector<Counter> *> &
+shards()
+{
+    static vector<vector<Counter> *> the_shards;
+    return the_shards;
+}
+
+void
+addThreadShard()
+{
+    if (threadShard)
+        return;
+
+    lock_guard<mutex> lock(shardMutex);
+    threadShard = new vector<Counter>(numShardSlots);
+    shards().push_back(threadShard);
+}
+
+const vector<vector<Counter> *> &
+threadShards()
+{
+    return shards();
+}
+
+size_type
+allocShardSlot(size_type count)
+{
+    size_type slot = numShardSlots;
+    numShardSlots += count;
+    return slot;
+}
+
 int debug_break_id = -1;
 
 Info::Info()
@@ -377,10 +415,12 @@ HistStor::add(HistStor *hs)
 }
 
 Formula::Formula()
+    : _cachedTotal(0.0), cacheValid(false)
 {
 }
 
 Formula::Formula(Temp r)
+    : _cachedTotal(0.0), cacheValid(false)
 {
     root = r.getNodePtr();
     setInit();
@@ -443,6 +483,28 @@ Formula::size() const
         return root->size();
 }
 
+/** Set while dumping, when the stats can't change */
+static bool dumping = false;
+
+void
+Formula::prepare()
+{
+    if (cacheValid && !updated())
+        return;
+
+    result(_cachedResult);
+    _cachedTotal = total();
+    cacheValid = true;
+}
+
+bool
+Formula::cached() const
+{
+    // All the formulas using updated stats are prepared again before
+    // dumping
+    return cacheValid && (dumping || !updated());
+}
+
 void
 Formula::reset()
 {
@@ -513,6 +575,43 @@ enable()
     _enabled = true;
 }
 
+void
+dumpOutputs(const vector<Output *> &outputs)
+{
+    list<Info *> &stats = statsList();
+
+    // The stats that were not updated still hold what they were last
+    // prepared with
+    for (auto *info : stats) {
+        if (info->updated())
+            info->prepare();
+    }
+
+    dumping = true;
+    for (auto *output : outputs) {
+        if (!output->valid())
+            continue;
+
+        output->begin();
+        for (auto *info : stats)
+            info->visit(*output);
+        output->end();
+    }
+    dumping = false;
+
+    for (auto *info : stats)
+        info->clearUpdated();
+}
+
+void
+resetUpdated()
+{
+    for (auto *info : statsList()) {
+        if (info->resetNeeded())
+            info->reset();
+    }
+}
+
 void
 dump()
 {
@@ -98,6 +98,9 @@ class InfoProxy : public Base
         visitor.visit(*static_cast<Base *>(this));
     }
     bool zero() const { return s.zero(); }
+    bool updated() const { return s.updated(); }
+    void clearUpdated() { s.clearUpdated(); }
+    bool resetNeeded() const { return s.resetNeeded(); }
 };
 
 template <class Stat>
@@ -172,6 +175,15 @@ struct StorageParams
 
 class InfoAccess
 {
+  private:
+    enum {
+        DirtySinceDump = 0x1,
+        DirtySinceReset = 0x2,
+    };
+
+    /** What the stat changed since, see setUpdated() */
+    uint8_t dirty;
+
   protected:
     /** Set up an info class for this statistic */
     void setInfo(Info *info);
@@ -186,6 +198,26 @@ class InfoAccess
     const Info *info() const;
 
   public:
+    InfoAccess() : dirty(DirtySinceDump | DirtySinceReset) { }
+
+    /**
+     * Note that the value of the stat changed. The flags are only written
+     * when they change, so that threads updating the same stat do not
+     * keep stealing its cache line from each other.
+     */
+    void
+    setUpdated()
+    {
+        if (dirty != (DirtySinceDump | DirtySinceReset))
+            dirty = DirtySinceDump | DirtySinceReset;
+    }
+    /** Note that the stat was reset to its default state. */
+    void setReset() { dirty = DirtySinceDump; }
+
+    bool updated() const { return dirty & DirtySinceDump; }
+    void clearUpdated() { dirty &= ~DirtySinceDump; }
+    bool resetNeeded() const { return dirty & DirtySinceReset; }
+
     /**
      * Reset the stat to the default state.
      */
@@ -411,6 +443,7 @@ class DataWrapVec : public DataWrap<Derived, InfoProxyType>
         size_t size = self.size();
         for (off_type i = 0; i < size; ++i)
             self.data(i)->reset(info);
+        this->setReset();
     }
 };
 
@@ -523,6 +556,121 @@ class StatStor
     bool zero() const { return data == Counter(); }
 };
 
+/**
+ * The counters of the sharded stats updated by the current thread, or
+ * NULL on the main thread, which updates the stats themselves.
+ * @sa ShardedStor
+ */
+extern __thread std::vector<Counter> *threadShard;
+
+/**
+ * Give the current thread a shard of its own. Every simulation thread
+ * but the main one must do so before updating any sharded stat.
+ */
+void addThreadShard();
+
+/** The shards of all the threads */
+const std::vector<std::vector<Counter> *> &threadShards();
+
+/**
+ * Allocate the counters of a sharded stat in the shards.
+ * @return The index of the first counter.
+ */
+size_type allocShardSlot(size_type count = 1);
+
+/**
+ * Storage for a scalar stat updated by several simulation threads. The
+ * main thread updates the value in place, while the other threads each
+ * accumulate into a shard of their own, so that they neither race nor
+ * steal the cache line of the stat from each other. The shards are only
+ * summed up when the value is read, which must happen while the threads
+ * are stopped, e.g. when the stats are dumped or reset.
+ */
+class ShardedStor
+{
+  private:
+    /** The value updated by the main thread */
+    Counter data;
+    /** The index of the counter of this stat in the shards */
+    size_type slot;
+
+    Counter &
+    counter()
+    {
+        if (!threadShard)
+            return data;
+
+        // Stats may have been created after the shard
+        if (slot >= threadShard->size())
+            threadShard->resize(slot + 1);
+        return (*threadShard)[slot];
+    }
+
+    void
+    clearShards()
+    {
+        for (auto *shard : threadShards()) {
+            if (slot < shard->size())
+                (*shard)[slot] = Counter();
+        }
+    }
+
+  public:
+    struct Params : public StorageParams {};
+
+  public:
+    ShardedStor(Info *info)
+        : data(Counter()), slot(allocShardSlot())
+    { }
+
+    /**
+     * Set the stat to the given value, dropping what the threads
+     * accumulated. Only to be done by the main thread while the others
+     * are stopped.
+     * @param val The new value.
+     */
+    void
+    set(Counter val)
+    {
+        assert(!threadShard);
+        clearShards();
+        data = val;
+    }
+    /**
+     * Increment the stat of the current thread by the given value.
+     * @param val The new value.
+     */
+    void inc(Counter val) { counter() += val; }
+    /**
+     * Decrement the stat of the current thread by the given value.
+     * @param val The new value.
+     */
+    void dec(Counter val) { counter() -= val; }
+    /**
+     * Return the value of this stat summed over all the threads.
+     * @return The value of this stat.
+     */
+    Counter
+    value() const
+    {
+        Counter total = data;
+        for (const auto *shard : threadShards()) {
+            if (slot < shard->size())
+                total += (*shard)[slot];
+        }
+        return total;
+    }
+    Result result() const { return (Result)value(); }
+    void prepare(Info *info) { }
+    void
+    reset(Info *info)
+    {
+        clearShards();
+        data = Counter();
+    }
+    bool zero() const { return value() == Counter(); }
+};
+
 /**
  * Templatized storage and interface to a per-tick average stat. This keeps
  * a current count and updates a total (count * ticks) when this count
@@ -688,12 +836,12 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
      * Increment the stat by 1. This calls the associated storage object inc
      * function.
      */
-    void operator++() { data()->inc(1); }
+    void operator++() { this->setUpdated(); data()->inc(1); }
     /**
      * Decrement the stat by 1. This calls the associated storage object dec
      * function.
      */
-    void operator--() { data()->dec(1); }
+    void operator--() { this->setUpdated(); data()->dec(1); }
 
     /** Increment the stat by 1. */
     void operator++(int) { ++*this; }
@@ -706,7 +854,7 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
      * @param v The new value.
      */
     template <typename U>
-    void operator=(const U &v) { data()->set(v); }
+    void operator=(const U &v) { this->setUpdated(); data()->set(v); }
 
     /**
      * Increment the stat by the given value. This calls the associated
@@ -714,7 +862,7 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
      * @param v The value to add.
      */
     template <typename U>
-    void operator+=(const U &v) { data()->inc(v); }
+    void operator+=(const U &v) { this->setUpdated(); data()->inc(v); }
 
     /**
      * Decrement the stat by the given value. This calls the associated
@@ -722,7 +870,7 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
      * @param v The value to substract.
      */
     template <typename U>
-    void operator-=(const U &v) { data()->dec(v); }
+    void operator-=(const U &v) { this->setUpdated(); data()->dec(v); }
 
     /**
      * Return the number of elements, always 1 for a scalar.
@@ -738,7 +886,7 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
 
     bool zero() { return result() == 0.0; }
 
-    void reset() { data()->reset(this->info()); }
+    void reset() { data()->reset(this->info()); this->setReset(); }
     void prepare() { data()->prepare(this->info()); }
 };
 
@@ -854,6 +1002,9 @@ class ValueBase : public DataWrap<Derived, ScalarInfoProxy>
     bool check() const { return proxy != NULL; }
     void prepare() { }
     void reset() { }
+
+    /** The value can change without the stat knowing */
+    bool updated() const { return true; }
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -926,12 +1077,12 @@ class ScalarProxy
      * Increment the stat by 1. This calls the associated storage object inc
      * function.
      */
-    void operator++() { stat.data(index)->inc(1); }
+    void operator++() { stat.setUpdated(); stat.data(index)->inc(1); }
     /**
      * Decrement the stat by 1. This calls the associated storage object dec
      * function.
      */
-    void operator--() { stat.data(index)->dec(1); }
+    void operator--() { stat.setUpdated(); stat.data(index)->dec(1); }
 
     /** Increment the stat by 1. */
     void operator++(int) { ++*this; }
@@ -947,6 +1098,7 @@ class ScalarProxy
     void
     operator=(const U &v)
     {
+        stat.setUpdated();
         stat.data(index)->set(v);
     }
 
@@ -959,6 +1111,7 @@ class ScalarProxy
     void
     operator+=(const U &v)
     {
+        stat.setUpdated();
         stat.data(index)->inc(v);
     }
 
@@ -971,6 +1124,7 @@ class ScalarProxy
     void
     operator-=(const U &v)
     {
+        stat.setUpdated();
         stat.data(index)->dec(v);
     }
 
@@ -980,6 +1134,8 @@ class ScalarProxy
      */
     size_type size() const { return 1; }
 
+    bool updated() const { return stat.updated(); }
+
   public:
     std::string
     str() const
@@ -1339,6 +1495,7 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
         size_type size = this->size();
         for (off_type i = 0; i < size; ++i)
             data(i)->reset(info);
+        this->setReset();
     }
 
     bool
@@ -1511,6 +1668,148 @@ class DistStor
     }
 };
 
+/**
+ * Storage for a distribution stat sampled by several simulation threads.
+ * As with ShardedStor, the main thread samples the distribution in
+ * place, while the other threads sample into counters of their own
+ * shard, which are only merged when the stat is prepared.
+ */
+class ShardedDistStor
+{
+  public:
+    typedef DistStor::Params Params;
+
+  private:
+    /** The counters of a shard, followed by the buckets */
+    enum {
+        Samples, Sum, Squares, Underflow, Overflow, MinVal, MaxVal,
+        NumFields
+    };
+
+    /** The distribution sampled by the main thread */
+    DistStor data;
+    Counter min_track;
+    Counter max_track;
+    Counter bucket_size;
+    size_type buckets;
+    /** The index of the first counter of this stat in the shards */
+    size_type slot;
+
+  public:
+    ShardedDistStor(Info *info)
+        : data(info),
+          buckets(safe_cast<const Params *>(info->storageParams)->buckets),
+          slot(allocShardSlot(NumFields + buckets))
+    {
+        const Params *params = safe_cast<const Params *>(info->storageParams);
+        min_track = params->min;
+        max_track = params->max;
+        bucket_size = params->bucket_size;
+    }
+
+    /**
+     * Add a value to the distribution of the current thread for the
+     * given number of times.
+     * @param val The value to add.
+     * @param number The number of times to add the value.
+     */
+    void
+    sample(Counter val, int number)
+    {
+        if (!threadShard) {
+            data.sample(val, number);
+            return;
+        }
+
+        // Stats may have been created after the shard
+        if (slot + NumFields + buckets > threadShard->size())
+            threadShard->resize(slot + NumFields + buckets);
+        Counter *shard = &(*threadShard)[slot];
+
+        if (val < min_track) {
+            shard[Underflow] += number;
+        } else if (val > max_track) {
+            shard[Overflow] += number;
+        } else {
+            size_type index =
+                (size_type)std::floor((val - min_track) / bucket_size);
+            assert(index < buckets);
+            shard[NumFields + index] += number;
+        }
+
+        if (shard[Samples] == Counter() || val < shard[MinVal])
+            shard[MinVal] = val;
+        if (shard[Samples] == Counter() || val > shard[MaxVal])
+            shard[MaxVal] = val;
+
+        shard[Sum] += val * number;
+        shard[Squares] += val * val * number;
+        shard[Samples] += number;
+    }
+
+    size_type size() const { return buckets; }
+
+    bool
+    zero() const
+    {
+        if (!data.zero())
+            return false;
+
+        for (const auto *shard : threadShards()) {
+            if (slot < shard->size() && (*shard)[slot + Samples] != Counter())
+                return false;
+        }
+        return true;
+    }
+
+    void
+    prepare(Info *info, DistData &dist)
+    {
+        data.prepare(info, dist);
+
+        for (const auto *shard : threadShards()) {
+            if (slot >= shard->size() ||
+                (*shard)[slot + Samples] == Counter()) {
+                continue;
+            }
+
+            const Counter *counters = &(*shard)[slot];
+            if (dist.samples == Counter()) {
+                dist.min_val = counters[MinVal];
+                dist.max_val = counters[MaxVal];
+            } else {
+                dist.min_val = std::min(dist.min_val, counters[MinVal]);
+                dist.max_val = std::max(dist.max_val, counters[MaxVal]);
+            }
+
+            dist.underflow += counters[Underflow];
+            dist.overflow += counters[Overflow];
+            for (off_type i = 0; i < buckets; ++i)
+                dist.cvec[i] += counters[NumFields + i];
+            dist.sum += counters[Sum];
+            dist.squares += counters[Squares];
+            dist.samples += counters[Samples];
+        }
+    }
+
+    /**
+     * Reset stat value to default. Only to be done while the other
+     * threads are stopped.
+     */
+    void
+    reset(Info *info)
+    {
+        data.reset(info);
+
+        for (auto *shard : threadShards()) {
+            for (off_type i = 0; i < NumFields + buckets &&
+                     slot + i < shard->size(); ++i) {
+                (*shard)[slot + i] = Counter();
+            }
+        }
+    }
+};
+
 /**
  * Templatized storage and interface for a histogram stat.
  */
@@ -1866,7 +2165,12 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
      * @param n The number of times to add it, defaults to 1.
      */
     template <typename U>
-    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+    void
+    sample(const U &v, int n = 1)
+    {
+        this->setUpdated();
+        data()->sample(v, n);
+    }
 
     /**
      * Return the number of entries in this stat.
@@ -1893,12 +2197,18 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     reset()
     {
         data()->reset(this->info());
+        this->setReset();
     }
 
     /**
      *  Add the argument distribution to the this distribution.
      */
-    void add(DistBase &d) { data()->add(d.data()); }
+    void
+    add(DistBase &d)
+    {
+        this->setUpdated();
+        data()->add(d.data());
+    }
 
 };
 
@@ -2036,6 +2346,7 @@ class DistProxy
     void
     sample(const U &v, int n = 1)
     {
+        stat.setUpdated();
         data()->sample(v, n);
     }
 
@@ -2086,6 +2397,12 @@ class Node
      */
     virtual Result total() const = 0;
 
+    /**
+     * Return whether a stat of this subtree may have changed since the
+     * last dump.
+     */
+    virtual bool updated() const = 0;
+
     /**
      *
      */
@@ -2115,6 +2432,8 @@ class ScalarStatNode : public Node
 
     size_type size() const { return 1; }
 
+    bool updated() const { return data->updated(); }
+
     /**
      *
      */
@@ -2152,6 +2471,8 @@ class ScalarProxyNode : public Node
         return 1;
     }
 
+    bool updated() const { return proxy.updated(); }
+
     /**
      *
      */
@@ -2174,6 +2495,8 @@ class VectorStatNode : public Node
 
     size_type size() const { return data->size(); }
 
+    bool updated() const { return data->updated(); }
+
     std::string str() const { return data->name; }
 };
 
@@ -2188,6 +2511,7 @@ class ConstNode : public Node
     const VResult &result() const { return vresult; }
     Result total() const { return vresult[0]; };
     size_type size() const { return 1; }
+    bool updated() const { return false; }
     std::string str() const { return std::to_string(vresult[0]); }
 };
 
@@ -2212,6 +2536,8 @@ class ConstVectorNode : public Node
     }
 
     size_type size() const { return vresult.size(); }
+    bool updated() const { return false; }
+
     std::string
     str() const
     {
@@ -2301,6 +2627,8 @@ class UnaryNode : public Node
 
     size_type size() const { return l->size(); }
 
+    bool updated() const { return l->updated(); }
+
     std::string
     str() const
     {
@@ -2398,6 +2726,8 @@ class BinaryNode : public Node
         }
     }
 
+    bool updated() const { return l->updated() || r->updated(); }
+
     std::string
     str() const
     {
@@ -2449,6 +2779,8 @@ class SumNode : public Node
 
     size_type size() const { return 1; }
 
+    bool updated() const { return l->updated(); }
+
     std::string
     str() const
     {
@@ -2486,6 +2818,10 @@ class Average : public ScalarBase<Average, AvgStor>
 {
   public:
     using ScalarBase<Average, AvgStor>::operator=;
+
+    /** The average changes with time, even when not updated */
+    bool updated() const { return true; }
+    bool resetNeeded() const { return true; }
 };
 
 class Value : public ValueBase<Value>
@@ -2500,12 +2836,32 @@ class Vector : public VectorBase<Vector, StatStor>
 {
 };
 
+/**
+ * A scalar stat updated by several simulation threads.
+ * @sa Stat, ScalarBase, ShardedStor
+ */
+class ShardedScalar : public ScalarBase<ShardedScalar, ShardedStor>
+{
+};
+
+/**
+ * A vector of stats updated by several simulation threads.
+ * @sa Stat, VectorBase, ShardedStor
+ */
+class ShardedVector : public VectorBase<ShardedVector, ShardedStor>
+{
+};
+
 /**
  * A vector of Average stats.
  * @sa Stat, VectorBase, AvgStor
  */
 class AverageVector : public VectorBase<AverageVector, AvgStor>
 {
+  public:
+    /** The average changes with time, even when not updated */
+    bool updated() const { return true; }
+    bool resetNeeded() const { return true; }
 };
 
 /**
@@ -2516,6 +2872,14 @@ class Vector2d : public Vector2dBase<Vector2d, StatStor>
 {
 };
 
+/**
+ * A 2-Dimensional vector of stats updated by several simulation threads.
+ * @sa Stat, Vector2dBase, ShardedStor
+ */
+class ShardedVector2d : public Vector2dBase<ShardedVector2d, ShardedStor>
+{
+};
+
 /**
  * A simple distribution stat.
  * @sa Stat, DistBase, DistStor
@@ -2544,6 +2908,35 @@ class Distribution : public DistBase<Distribution, DistStor>
     }
 };
 
+/**
+ * A distribution stat sampled by several simulation threads.
+ * @sa Stat, DistBase, ShardedDistStor
+ */
+class ShardedDistribution
+    : public DistBase<ShardedDistribution, ShardedDistStor>
+{
+  public:
+    /**
+     * Set the parameters of this distribution. @sa DistStor::Params
+     * @param min The minimum value of the distribution.
+     * @param max The maximum value of the distribution.
+     * @param bkt The number of values in each bucket.
+     * @return A reference to this distribution.
+     */
+    ShardedDistribution &
+    init(Counter min, Counter max, Counter bkt)
+    {
+        ShardedDistStor::Params *params = new ShardedDistStor::Params;
+        params->min = min;
+        params->max = max;
+        params->bucket_size = bkt;
+        params->buckets = (size_type)ceil((max - min + 1.0) / bkt);
+        this->setParams(params);
+        this->doInit();
+        return this->self();
+    }
+};
+
 /**
  * A simple histogram stat.
  * @sa Stat, DistBase, HistStor
@@ -2601,6 +2994,10 @@ class AverageDeviation : public DistBase<AverageDeviation, AvgSampleStor>
         this->doInit();
         this->setParams(params);
     }
+
+    /** The average changes with time, even when not updated */
+    bool updated() const { return true; }
+    bool resetNeeded() const { return true; }
 };
 
 /**
@@ -2676,6 +3073,10 @@ class VectorAverageDeviation
         this->setParams(params);
         return this->self();
     }
+
+    /** The average changes with time, even when not updated */
+    bool updated() const { return true; }
+    bool resetNeeded() const { return true; }
 };
 
 template <class Stat>
@@ -2693,10 +3094,16 @@ class FormulaInfoProxy : public InfoProxy<Stat, FormulaInfo>
     const VResult &
     result() const
     {
+        if (this->s.cached())
+            return this->s.cachedResult();
         this->s.result(vec);
         return vec;
     }
-    Result total() const { return this->s.total(); }
+    Result
+    total() const
+    {
+        return this->s.cached() ? this->s.cachedTotal() : this->s.total();
+    }
     VCounter &value() const { return cvec; }
 
     std::string str() const { return this->s.str(); }
@@ -2763,7 +3170,12 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
      * @param n The number of times to add it, defaults to 1.
      */
     template <typename U>
-    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+    void
+    sample(const U &v, int n = 1)
+    {
+        this->setUpdated();
+        data()->sample(v, n);
+    }
 
     /**
      * Return the number of entries in this stat.
@@ -2790,6 +3202,7 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
     reset()
     {
         data()->reset(this->info());
+        this->setReset();
     }
 };
 
@@ -2899,6 +3312,11 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
     NodePtr root;
     friend class Temp;
 
+    /** The result and total when the formula was last prepared */
+    VResult _cachedResult;
+    Result _cachedTotal;
+    bool cacheValid;
+
   public:
     /**
      * Create and initialize thie formula, and register it with the database.
@@ -2959,7 +3377,19 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
      */
     size_type size() const;
 
-    void prepare() { }
+    /**
+     * Evaluate the formula if a stat it uses was updated since the last
+     * dump, the results are then used until one is updated again.
+     */
+    void prepare();
+
+    /** @return true if the results of the last prepare() are current */
+    bool cached() const;
+    const VResult &cachedResult() const { return _cachedResult; }
+    Result cachedTotal() const { return _cachedTotal; }
+
+    bool updated() const { return root && root->updated(); }
+    bool resetNeeded() const { return false; }
 
     /**
      * Formulas don't need to be reset
@@ -2986,6 +3416,7 @@ class FormulaNode : public Node
     size_type size() const { return formula.size(); }
     const VResult &result() const { formula.result(vec); return vec; }
     Result total() const { return formula.total(); }
+    bool updated() const { return formula.updated(); }
 
     std::string str() const { return formula.str(); }
 };
@@ -3046,6 +3477,14 @@ class Temp
         : node(new ScalarStatNode(s.info()))
     { }
 
+    /**
+     * Create a new ScalarStatNode.
+     * @param s The ScalarStat to place in a node.
+     */
+    Temp(const ShardedScalar &s)
+        : node(new ScalarStatNode(s.info()))
+    { }
+
     /**
      * Create a new VectorStatNode.
      * @param s The VectorStat to place in a node.
@@ -3058,6 +3497,10 @@ class Temp
         : node(new VectorStatNode(s.info()))
     { }
 
+    Temp(const ShardedVector &s)
+        : node(new VectorStatNode(s.info()))
+    { }
+
     /**
      *
      */
@@ -3232,6 +3675,15 @@ void reset();
 void enable();
 bool enabled();
 
+/**
+ * Visit all the stats with the given outputs, only preparing those that
+ * were updated since the last dump.
+ */
+void dumpOutputs(const std::vector<Output *> &outputs);
+
+/** Reset the stats that were updated since they were last reset. */
+void resetUpdated();
+
 /**
  * Register reset and dump handlers.  These are the functions which
  * will actually perform the whole statistics reset/dump actions
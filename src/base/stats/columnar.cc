@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <zlib.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <ostream>
+
+#include "base/callback.hh"
+#include "base/misc.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "sim/core.hh"
+
+using namespace std;
+
+namespace Stats {
+
+static const char magic[] = "gem5stcl";
+static const char schemaTag[] = "SCHM";
+static const char chunkTag[] = "CHNK";
+
+const uint32_t Columnar::version;
+
+template <class T>
+static void
+writeValue(ostream &stream, const T &value)
+{
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+Columnar::Columnar()
+    : rowsPerChunk(64), level(Z_DEFAULT_COMPRESSION), stream(NULL),
+      schemaWritten(false), numColumns(0), numRows(0)
+{
+}
+
+Columnar::~Columnar()
+{
+    if (stream)
+        flush();
+}
+
+void
+Columnar::open(ostream &_stream)
+{
+    if (stream)
+        panic("stream already set!");
+
+    stream = &_stream;
+    if (!valid())
+        fatal("Unable to open output stream for writing\n");
+
+    stream->write(magic, sizeof(magic) - 1);
+    writeValue(*stream, version);
+}
+
+bool
+Columnar::valid() const
+{
+    return stream != NULL && stream->good();
+}
+
+void
+Columnar::begin()
+{
+    row.clear();
+    if (naming())
+        names.push_back("tick");
+    row.push_back(curTick());
+}
+
+void
+Columnar::end()
+{
+    if (!schemaWritten) {
+        assert(names.size() == row.size());
+        writeSchema();
+    } else if (row.size() != numColumns) {
+        fatal("Stats changed from %d to %d values since the first dump\n",
+              numColumns, row.size());
+    }
+
+    rows.insert(rows.end(), row.begin(), row.end());
+    if (++numRows >= rowsPerChunk)
+        writeChunk();
+}
+
+void
+Columnar::flush()
+{
+    writeChunk();
+    stream->flush();
+}
+
+void
+Columnar::writeSchema()
+{
+    stream->write(schemaTag, sizeof(schemaTag) - 1);
+    writeValue<uint32_t>(*stream, names.size());
+    for (const auto &name : names) {
+        writeValue<uint32_t>(*stream, name.size());
+        stream->write(name.data(), name.size());
+    }
+
+    numColumns = names.size();
+    names.clear();
+    names.shrink_to_fit();
+    schemaWritten = true;
+}
+
+void
+Columnar::writeChunk()
+{
+    if (numRows == 0)
+        return;
+
+    static_assert(sizeof(Result) == sizeof(uint64_t),
+                  "Results are expected to be doubles");
+    const size_t column_bytes = numRows * sizeof(uint64_t);
+
+    vector<uint8_t> shuffled(column_bytes);
+    vector<uint8_t> compressed;
+    vector<uint32_t> sizes(numColumns);
+    size_t compressed_bytes = 0;
+
+    for (size_t c = 0; c < numColumns; ++c) {
+        uint64_t prev = 0;
+        for (unsigned r = 0; r < numRows; ++r) {
+            uint64_t bits;
+            memcpy(&bits, &rows[r * numColumns + c], sizeof(bits));
+            uint64_t delta = bits ^ prev;
+            prev = bits;
+            for (unsigned b = 0; b < sizeof(delta); ++b)
+                shuffled[b * numRows + r] = delta >> (b * 8);
+        }
+
+        uLongf size = compressBound(column_bytes);
+        compressed.resize(compressed_bytes + size);
+        int ret = compress2(&compressed[compressed_bytes], &size,
+                            shuffled.data(), column_bytes, level);
+        if (ret != Z_OK)
+            panic("Failed to compress stats: %d\n", ret);
+
+        sizes[c] = size;
+        compressed_bytes += size;
+    }
+
+    stream->write(chunkTag, sizeof(chunkTag) - 1);
+    writeValue<uint32_t>(*stream, numRows);
+    writeValue<uint32_t>(*stream, numColumns);
+    stream->write(reinterpret_cast<const char *>(sizes.data()),
+                  sizes.size() * sizeof(uint32_t));
+    stream->write(reinterpret_cast<const char *>(compressed.data()),
+                  compressed_bytes);
+
+    rows.clear();
+    numRows = 0;
+}
+
+bool
+Columnar::noOutput(const Info &info)
+{
+    // Unlike the prerequisites, the flags do not change from a dump to
+    // the next
+    return !info.flags.isSet(display);
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (naming())
+        names.push_back(info.name);
+    row.push_back(info.result());
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const VResult &vec = info.result();
+    size_type size = vec.size();
+    string base = info.name + info.separatorString;
+
+    bool havesub = false;
+    for (const auto &subname : info.subnames)
+        havesub = havesub || !subname.empty();
+
+    for (off_type i = 0; i < size; ++i) {
+        if (havesub &&
+            (i >= info.subnames.size() || info.subnames[i].empty()))
+            continue;
+
+        if (naming()) {
+            if (size == 1)
+                names.push_back(info.name);
+            else
+                names.push_back(base + (havesub ? info.subnames[i] :
+                                        to_string(i)));
+        }
+        row.push_back(vec[i]);
+    }
+
+    if (size > 1 && info.flags.isSet(::Stats::total)) {
+        if (naming())
+            names.push_back(base + "total");
+        row.push_back(info.total());
+    }
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    bool havesub = false;
+    for (const auto &subname : info.subnames)
+        havesub = havesub || !subname.empty();
+
+    bool have_ysub = false;
+    for (const auto &subname : info.y_subnames)
+        have_ysub = have_ysub || !subname.empty();
+
+    for (off_type i = 0; i < info.x; ++i) {
+        if (havesub && (i >= info.subnames.size() || info.subnames[i].empty()))
+            continue;
+
+        string base = info.name + "_" +
+            (havesub ? info.subnames[i] : to_string(i)) +
+            info.separatorString;
+
+        off_type iy = i * info.y;
+        for (off_type j = 0; j < info.y; ++j) {
+            if (naming())
+                names.push_back(base + (have_ysub ? info.y_subnames[j] :
+                                        to_string(j)));
+            row.push_back(info.cvec[iy + j]);
+        }
+    }
+
+    if (info.flags.isSet(::Stats::total) && info.x > 1) {
+        if (naming())
+            names.push_back(info.name + info.separatorString + "total");
+        row.push_back(info.total());
+    }
+}
+
+void
+Columnar::distColumns(const string &base, const DistData &data)
+{
+    if (naming())
+        names.push_back(base + "samples");
+    row.push_back(data.samples);
+
+    if (naming())
+        names.push_back(base + "mean");
+    row.push_back(data.samples ? data.sum / data.samples : NAN);
+
+    if (data.type == Hist) {
+        if (naming())
+            names.push_back(base + "gmean");
+        row.push_back(data.samples ? exp(data.logs / data.samples) : NAN);
+    }
+
+    Result stdev = NAN;
+    if (data.samples)
+        stdev = sqrt((data.samples * data.squares - data.sum * data.sum) /
+                     (data.samples * (data.samples - 1.0)));
+    if (naming())
+        names.push_back(base + "stdev");
+    row.push_back(stdev);
+
+    if (data.type == Deviation)
+        return;
+
+    size_t size = data.cvec.size();
+
+    Result total = 0.0;
+    if (data.type == Dist)
+        total += data.underflow + data.overflow;
+    for (off_type i = 0; i < size; ++i)
+        total += data.cvec[i];
+
+    if (data.type == Dist) {
+        if (naming())
+            names.push_back(base + "underflows");
+        row.push_back(data.underflow);
+    }
+
+    // The buckets of a histogram grow along with its samples, so they are
+    // named by index, and each row gives the range they cover
+    if (data.type == Hist) {
+        if (naming()) {
+            names.push_back(base + "min");
+            names.push_back(base + "bucket_size");
+        }
+        row.push_back(data.min);
+        row.push_back(data.bucket_size);
+    }
+
+    for (off_type i = 0; i < size; ++i) {
+        if (naming() && data.type == Hist) {
+            names.push_back(base + "bucket_" + to_string(i));
+        } else if (naming()) {
+            Counter low = i * data.bucket_size + data.min;
+            Counter high = ::min(low + data.bucket_size - 1.0, data.max);
+            string name = base + to_string((long long)low);
+            if (low < high)
+                name += "-" + to_string((long long)high);
+            names.push_back(name);
+        }
+        row.push_back(data.cvec[i]);
+    }
+
+    if (data.type == Dist) {
+        if (naming()) {
+            names.push_back(base + "overflows");
+            names.push_back(base + "min_value");
+            names.push_back(base + "max_value");
+        }
+        row.push_back(data.overflow);
+        row.push_back(data.min_val);
+        row.push_back(data.max_val);
+    }
+
+    if (naming())
+        names.push_back(base + "total");
+    row.push_back(total);
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    distColumns(naming() ? info.name + info.separatorString : string(),
+                info.data);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    for (off_type i = 0; i < info.size(); ++i) {
+        string base;
+        if (naming()) {
+            base = info.name + "_" +
+                (info.subnames[i].empty() ? to_string(i) :
+                 info.subnames[i]) + info.separatorString;
+        }
+        distColumns(base, info.data[i]);
+    }
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    visit((const VectorInfo &)info);
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (naming())
+        names.push_back(info.name + info.separatorString + "samples");
+    row.push_back(info.data.samples);
+}
+
+Output *
+initColumnar(const string &filename, unsigned rows_per_chunk, int level)
+{
+    static Columnar columnar;
+    static bool connected = false;
+
+    if (!connected) {
+        columnar.open(*simout.findOrCreate(filename, true)->stream());
+        columnar.rowsPerChunk = rows_per_chunk;
+        columnar.level = level;
+        connected = true;
+
+        // The last rows are buffered until a chunk fills up, so write
+        // them out at exit while the output is still open
+        registerExitCallback(
+            new MakeCallback<Columnar, &Columnar::flush>(columnar, true));
+    }
+
+    return &columnar;
+}
+
+} // namespace Stats
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace Stats {
+
+struct DistData;
+
+/**
+ * Stats output in a binary columnar format, where every dump is a row
+ * and every value a stat would print in text is a column.
+ *
+ * The names of the columns are written once, on the first dump. The
+ * rows are then buffered and written out in chunks, each column of a
+ * chunk being compressed on its own so that a reader can seek over the
+ * columns it does not need. The first column holds the tick of the
+ * dump.
+ *
+ * All integers are in host byte order:
+ *   header: "gem5stcl" magic, uint32 version
+ *   schema: "SCHM", uint32 columns, per column uint32 length and name
+ *   chunk:  "CHNK", uint32 rows, uint32 columns, per column uint32
+ *           compressed size, then the compressed columns
+ *
+ * A compressed column holds the doubles of its rows, each XORed with the
+ * one of the previous row of the chunk, with their bytes shuffled so that
+ * the first bytes of all the rows come first. Stats that barely change
+ * from a dump to the next then compress to almost nothing.
+ *
+ * All the elements of a stat are written whether they are zero or not,
+ * so that every row has the same columns. Sparse histograms have no
+ * fixed buckets, only their number of samples is written.
+ */
+class Columnar : public Output
+{
+  public:
+    static const uint32_t version = 1;
+
+    /** Number of rows written out at once */
+    unsigned rowsPerChunk;
+    /** zlib compression level */
+    int level;
+
+  protected:
+    std::ostream *stream;
+
+    /** The names of the columns, until they are written */
+    std::vector<std::string> names;
+    bool schemaWritten;
+    size_t numColumns;
+
+    /** The values of the dump in progress */
+    std::vector<Result> row;
+    /** The rows not written out yet, one after the other */
+    std::vector<Result> rows;
+    unsigned numRows;
+
+    bool noOutput(const Info &info);
+    /** Only build the names of the columns on the first dump */
+    bool naming() const { return !schemaWritten; }
+
+    void distColumns(const std::string &base, const DistData &data);
+
+    void writeSchema();
+    void writeChunk();
+
+  public:
+    Columnar();
+    ~Columnar();
+
+    void open(std::ostream &stream);
+
+    /** Write out the buffered rows. */
+    void flush();
+
+    // Implement Visit
+    virtual void visit(const ScalarInfo &info);
+    virtual void visit(const VectorInfo &info);
+    virtual void visit(const DistInfo &info);
+    virtual void visit(const VectorDistInfo &info);
+    virtual void visit(const Vector2dInfo &info);
+    virtual void visit(const FormulaInfo &info);
+    virtual void visit(const SparseHistInfo &info);
+
+    // Implement Output
+    virtual bool valid() const;
+    virtual void begin();
+    virtual void end();
+};
+
+Output *initColumnar(const std::string &filename, unsigned rows_per_chunk,
+                     int level);
+
+} // namespace Stats
+
+#endif // __BASE_STATS_COLUMNAR_HH__
@@ -133,6 +133,21 @@ class Info
      */
     virtual void visit(Output &visitor) = 0;
 
+    /**
+     * @return true if the stat may have changed since the last dump,
+     * when it does not need to be prepared again
+     */
+    virtual bool updated() const { return true; }
+
+    /** Note that the stat was dumped. */
+    virtual void clearUpdated() { }
+
+    /**
+     * @return true if the stat may have changed since it was last
+     * reset, when it does not need to be reset again
+     */
+    virtual bool resetNeeded() const { return true; }
+
     /**
      * Checks if the first stat's name is alphabetically less than the second.
      * This function breaks names up at periods and considers each subname
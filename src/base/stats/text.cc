@@ -85,18 +85,18 @@ namespace Stats {
 std::list<Info *> &statsList();
 
 Text::Text()
-    : mystream(false), stream(NULL), descriptions(false)
+    : mystream(false), stream(NULL), descriptions(false), changedOnly(false)
 {
 }
 
 Text::Text(std::ostream &stream)
-    : mystream(false), stream(NULL), descriptions(false)
+    : mystream(false), stream(NULL), descriptions(false), changedOnly(false)
 {
     open(stream);
 }
 
 Text::Text(const std::string &file)
-    : mystream(false), stream(NULL), descriptions(false)
+    : mystream(false), stream(NULL), descriptions(false), changedOnly(false)
 {
     open(file);
 }
@@ -162,6 +162,9 @@ Text::noOutput(const Info &info)
     if (info.prereq && info.prereq->zero())
         return true;
 
+    if (changedOnly && !info.updated())
+        return true;
+
     return false;
 }
 
@@ -736,7 +739,7 @@ Text::visit(const SparseHistInfo &info)
 }
 
 Output *
-initText(const string &filename, bool desc)
+initText(const string &filename, bool desc, bool changed)
 {
     static Text text;
     static bool connected = false;
@@ -744,6 +747,7 @@ initText(const string &filename, bool desc)
     if (!connected) {
         text.open(*simout.findOrCreate(filename)->stream());
         text.descriptions = desc;
+        text.changedOnly = changed;
         connected = true;
     }
 
@@ -51,6 +51,8 @@ class Text : public Output
 
   public:
     bool descriptions;
+    /** Only print the stats updated since the last dump */
+    bool changedOnly;
 
   public:
     Text();
@@ -78,7 +80,7 @@ class Text : public Output
 
 std::string ValueToString(Result value, int precision);
 
-Output *initText(const std::string &filename, bool desc);
+Output *initText(const std::string &filename, bool desc, bool changed);
 
 } // namespace Stats
 
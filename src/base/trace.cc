@@ -41,10 +41,13 @@
 #include <sstream>
 #include <string>
 
+#include "base/binary_trace.hh"
+#include "base/callback.hh"
 #include "base/debug.hh"
 #include "base/misc.hh"
 #include "base/output.hh"
 #include "base/str.hh"
+#include "sim/core.hh"
 
 const std::string &name()
 {
@@ -101,6 +104,13 @@ disable()
 
 ObjectMatch ignore;
 
+uint8_t *
+Logger::binaryMessage(Tick when, const std::string &name, const char *fmt,
+                      uint8_t num_args, size_t args_size)
+{
+    return binary->message(when, name, fmt, num_args, args_size);
+}
+
 void
 Logger::dump(Tick when, const std::string &name, const void *d, int len)
 {
@@ -157,4 +167,56 @@ OstreamLogger::logMessage(Tick when, const std::string &name,
     stream.flush();
 }
 
+BinaryLogger::BinaryLogger(std::ostream &stream)
+    : writer(new BinaryTrace::Writer(stream)), textBuf(*writer),
+      textStream(&textBuf)
+{
+    binary = writer;
+
+    // Nothing is written out until a buffer fills up, so make sure the
+    // end of the trace is not lost
+    registerExitCallback(
+        new MakeCallback<BinaryLogger, &BinaryLogger::flush>(this, true));
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    textBuf.pubsync();
+    delete writer;
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+                         const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    writer->text(when, name, message);
+}
+
+void
+BinaryLogger::flush()
+{
+    textBuf.pubsync();
+    writer->flush();
+}
+
+void
+BinaryLogger::flushThread()
+{
+    // The text stream is shared by the threads, so leave it alone
+    writer->flushThread();
+}
+
+int
+BinaryLogger::TextBuf::sync()
+{
+    if (!str().empty()) {
+        writer.text(MaxTick, std::string(), str());
+        str(std::string());
+    }
+    return 0;
+}
+
 } // namespace Trace
@@ -36,14 +36,21 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <sstream>
 #include <string>
+#include <type_traits>
 
+#include "base/binary_trace_args.hh"
 #include "base/cprintf.hh"
 #include "base/debug.hh"
 #include "base/match.hh"
 #include "base/types.hh"
 #include "sim/core.hh"
 
+namespace BinaryTrace {
+class Writer;
+}
+
 namespace Trace {
 
 /** Debug logging base class.  Handles formatting and outputting
@@ -54,7 +61,38 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /** Records messages unformatted instead, if set */
+    BinaryTrace::Writer *binary;
+
+    /** Start a message record in the binary trace and return where its
+     *  arguments go, see BinaryTrace::Writer::message() */
+    uint8_t *binaryMessage(Tick when, const std::string &name,
+                           const char *fmt, uint8_t num_args,
+                           size_t args_size);
+
+    /** Record a message with its raw arguments, if they all can be */
+    template <typename ...Args>
+    bool
+    binaryDprintf(std::true_type, Tick when, const std::string &name,
+                  const char *fmt, const Args &...args)
+    {
+        uint8_t *p = binaryMessage(when, name, fmt, sizeof...(args),
+                                   BinaryTrace::argsSize(args...));
+        BinaryTrace::putArgs(p, args...);
+        return true;
+    }
+
+    template <typename ...Args>
+    bool
+    binaryDprintf(std::false_type, Tick when, const std::string &name,
+                  const char *fmt, const Args &...args)
+    {
+        return false;
+    }
+
   public:
+    Logger() : binary(NULL) { }
+
     /** Log a single message */
     template <typename ...Args>
     void dprintf(Tick when, const std::string &name, const char *fmt,
@@ -63,6 +101,15 @@ class Logger
         if (!name.empty() && ignore.match(name))
             return;
 
+        // Messages with arguments that cannot be recorded raw are
+        // formatted, and logMessage() records them as text
+        if (binary && binaryDprintf(
+                std::integral_constant<bool,
+                    BinaryTrace::AllRaw<Args...>::value>(),
+                when, name, fmt, args...)) {
+            return;
+        }
+
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, line.str());
@@ -86,6 +133,14 @@ class Logger
     /** Set objects to ignore */
     void setIgnore(ObjectMatch &ignore_) { ignore = ignore_; }
 
+    /** Write out any messages that are still buffered. This must only
+     *  be called when no other thread logs anything. */
+    virtual void flush() { }
+
+    /** Write out the messages the calling thread buffered. This is safe
+     *  while other threads log, but may leave some of theirs out. */
+    virtual void flushThread() { }
+
     virtual ~Logger() { }
 };
 
@@ -106,6 +161,43 @@ class OstreamLogger : public Logger
     std::ostream &getOstream() override { return stream; }
 };
 
+/** Logger that records the messages in a compact binary format, see
+ *  base/binary_trace.hh. The trace is turned into the text
+ *  OstreamLogger would write by util/debugtrace/decode_debug_trace */
+class BinaryLogger : public Logger
+{
+  protected:
+    BinaryTrace::Writer *writer;
+
+    /** Records what is written to getOstream() as a message at each
+     *  flush of the stream */
+    class TextBuf : public std::stringbuf
+    {
+      protected:
+        BinaryTrace::Writer &writer;
+
+        int sync() override;
+
+      public:
+        TextBuf(BinaryTrace::Writer &writer_) : writer(writer_) { }
+    };
+
+    TextBuf textBuf;
+    std::ostream textStream;
+
+  public:
+    BinaryLogger(std::ostream &stream);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+                    const std::string &message) override;
+
+    std::ostream &getOstream() override { return textStream; }
+
+    void flush() override;
+    void flushThread() override;
+};
+
 /** Get the current global debug logger.  This takes ownership of the given
  *  logger which should be allocated using 'new' */
 Logger *getDebugLogger();
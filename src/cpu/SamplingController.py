@@ -0,0 +1,49 @@
+# Copyright (c) 2026
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.SimObject import SimObject
+from m5.params import *
+
+class SamplingController(SimObject):
+    type = 'SamplingController'
+    cxx_header = "cpu/sampling_controller.hh"
+
+    fast_cpus = VectorParam.BaseCPU("CPUs that fast-forward")
+    detailed_cpus = VectorParam.BaseCPU("CPUs that warm up and measure, "
+                                        "switched with the fast CPUs")
+
+    period = Param.Counter(1000000, "Instructions between two samples")
+    warmup = Param.Counter(20000, "Detailed warmup before each sample")
+    measure = Param.Counter(1000, "Instructions measured per sample")
+    max_samples = Param.Counter(0, "Stop after this many samples "
+                                "(0 = never)")
+
+    confidence = Param.Float(0.95, "Confidence level of the intervals")
+    target_error = Param.Float(0.03, "Relative error of the mean CPI "
+                               "used to compute the samples needed")
+
+    sample_file = Param.String("samples.txt", "File to write each "
+                               "sample to (empty = none)")
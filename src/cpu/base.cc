@@ -385,11 +385,16 @@ BaseCPU::regProbePoints()
     ppRetiredLoads = pmuProbePoint("RetiredLoads");
     ppRetiredStores = pmuProbePoint("RetiredStores");
     ppRetiredBranches = pmuProbePoint("RetiredBranches");
+
+    ppCommittedInst = new ProbePointArg<CommittedInst>(getProbeManager(),
+                                                       "CommittedInst");
 }
 
 void
-BaseCPU::probeInstCommit(const StaticInstPtr &inst)
+BaseCPU::probeInstCommit(const StaticInstPtr &inst, ContextID ctx, Addr pc)
 {
+    ppCommittedInst->notify(CommittedInst(inst, ctx, pc));
+
     if (!inst->isMicroop() || inst->isLastMicroop())
         ppRetiredInsts->notify(1);
 
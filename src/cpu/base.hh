@@ -481,8 +481,11 @@ class BaseCPU : public MemObject
      * instruction.
      *
      * @param inst Instruction that just committed
+     * @param ctx Context of the thread that committed it
+     * @param pc Address of the instruction
      */
-    virtual void probeInstCommit(const StaticInstPtr &inst);
+    virtual void probeInstCommit(const StaticInstPtr &inst, ContextID ctx,
+                                 Addr pc);
 
     /**
      * Helper method to instantiate probe points belonging to this
@@ -514,6 +517,27 @@ class BaseCPU : public MemObject
     /** Retired branches (any type) */
     ProbePoints::PMUUPtr ppRetiredBranches;
 
+  public:
+    /** Argument of the CommittedInst probe point */
+    struct CommittedInst
+    {
+        CommittedInst(const StaticInstPtr &_inst, ContextID ctx, Addr _pc)
+            : inst(_inst), contextId(ctx), pc(_pc)
+        {}
+
+        const StaticInstPtr &inst;
+        ContextID contextId;
+        Addr pc;
+    };
+
+  protected:
+    /**
+     * Committed instruction probe point, notified with every (micro)
+     * instruction and the thread that committed it, whatever the CPU
+     * model.
+     */
+    ProbePointArg<CommittedInst> *ppCommittedInst;
+
     /** @} */
 
 
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/decode_cache.hh"
+
+#include <functional>
+
+#include "cpu/static_inst.hh"
+
+namespace DecodeCache
+{
+
+// Start with room for a few thousand instructions
+static const unsigned InitialSizeBits = 12;
+
+InstMap::InstMap()
+    : slots(1 << InitialSizeBits), sizeBits(InitialSizeBits), numUsed(0)
+{
+}
+
+size_t
+InstMap::index(const TheISA::ExtMachInst &mach_inst) const
+{
+    // Spread the hash over all the bits, as the hash of a machine
+    // instruction may just be the instruction itself
+    uint64_t hash = std::hash<TheISA::ExtMachInst>()(mach_inst);
+    return (hash * ULL(0x9e3779b97f4a7c15)) >> (64 - sizeBits);
+}
+
+const StaticInstPtr &
+InstMap::lookup(const TheISA::ExtMachInst &mach_inst) const
+{
+    size_t idx_mask = slots.size() - 1;
+    for (size_t idx = index(mach_inst); ; idx = (idx + 1) & idx_mask) {
+        const Slot &slot = slots[idx];
+        if (!slot.si || slot.machInst == mach_inst)
+            return slot.si;
+    }
+}
+
+void
+InstMap::insert(const TheISA::ExtMachInst &mach_inst,
+                const StaticInstPtr &si)
+{
+    assert(si);
+
+    // Keep the probe sequences short
+    if ((numUsed + 1) * 2 > slots.size())
+        grow();
+
+    size_t idx_mask = slots.size() - 1;
+    size_t idx = index(mach_inst);
+    while (slots[idx].si) {
+        assert(!(slots[idx].machInst == mach_inst));
+        idx = (idx + 1) & idx_mask;
+    }
+
+    slots[idx].machInst = mach_inst;
+    slots[idx].si = si;
+    numUsed++;
+}
+
+void
+InstMap::grow()
+{
+    std::vector<Slot> old_slots(1 << (sizeBits + 1));
+    old_slots.swap(slots);
+    sizeBits++;
+    numUsed = 0;
+
+    for (const auto &slot : old_slots) {
+        if (slot.si)
+            insert(slot.machInst, slot.si);
+    }
+}
+
+} // namespace DecodeCache
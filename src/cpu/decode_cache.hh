@@ -31,10 +31,11 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
-#include <unordered_map>
+#include <vector>
 
 #include "arch/isa_traits.hh"
 #include "arch/types.hh"
+#include "base/bitfield.hh"
 #include "config/the_isa.hh"
 #include "cpu/static_inst_fwd.hh"
 
@@ -46,10 +47,44 @@ namespace TheISA
 namespace DecodeCache
 {
 
-/// Hash for decoded instructions.
-typedef std::unordered_map<TheISA::ExtMachInst, StaticInstPtr> InstMap;
+/// Hash for decoded instructions. Open addressing with linear probing
+/// keeps the instructions of a probe sequence next to each other.
+class InstMap
+{
+  protected:
+    struct Slot {
+        TheISA::ExtMachInst machInst;
+        // Empty if NULL, decoding never gives a NULL instruction.
+        StaticInstPtr si;
+    };
+    std::vector<Slot> slots;
+    // log2 of the number of slots.
+    unsigned sizeBits;
+    size_t numUsed;
+
+    /// Index of the first slot to probe for a machine instruction.
+    size_t index(const TheISA::ExtMachInst &mach_inst) const;
+
+    /// Double the number of slots.
+    void grow();
+
+  public:
+    /// Constructor
+    InstMap();
 
-/// A sparse map from an Addr to a Value, stored in page chunks.
+    /// Find a decoded instruction.
+    /// @param mach_inst The binary instruction to look up.
+    /// @retval The instruction, or NULL if it was not decoded yet.
+    const StaticInstPtr &lookup(const TheISA::ExtMachInst &mach_inst) const;
+
+    /// Add a decoded instruction which is not in the map yet.
+    void insert(const TheISA::ExtMachInst &mach_inst,
+                const StaticInstPtr &si);
+};
+
+/// A sparse map from an Addr to a Value, stored in page chunks. The
+/// pages are found through a radix tree indexed by the page number,
+/// like a page table.
 template<class Value>
 class AddrMap
 {
@@ -58,70 +93,90 @@ class AddrMap
     struct CachePage {
         Value items[TheISA::PageBytes];
     };
-    // A map of cache pages which allows a sparse mapping.
-    typedef typename std::unordered_map<Addr, CachePage *> PageMap;
-    typedef typename PageMap::iterator PageIt;
-    // Mini cache of recent lookups.
-    PageIt recent[2];
-    PageMap pageMap;
-
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(PageIt recentest)
-    {
-        recent[1] = recent[0];
-        recent[0] = recentest;
-    }
 
-    /// Attempt to find the CacheePage which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
-    /// @param addr The address to look up.
+    // Each level of the tree translates this many bits of the page
+    // number, and a table takes up a host page.
+    static const unsigned LevelBits = 9;
+    static const unsigned PageNumBits = sizeof(Addr) * 8 - TheISA::PageShift;
+    static const unsigned Levels = (PageNumBits + LevelBits - 1) / LevelBits;
+
+    // A table of the tree. The tables at the last level point to pages,
+    // the others to the tables of the next level.
+    struct Table {
+        union {
+            Table *tables[1 << LevelBits];
+            CachePage *pages[1 << LevelBits];
+        };
+    };
+    Table *root;
+
+    // Mini cache of the most recent lookup.
+    Addr recentAddr;
+    CachePage *recentPage;
+
+    /// Find the CachePage which goes with a particular address, adding
+    /// it if there is none yet.
+    /// @param page_addr The page aligned address to look up.
     CachePage *
-    getPage(Addr addr)
+    walk(Addr page_addr)
     {
-        Addr page_addr = addr & ~(TheISA::PageBytes - 1);
-
-        // Check against recent lookups.
-        if (recent[0] != pageMap.end()) {
-            if (recent[0]->first == page_addr)
-                return recent[0]->second;
-            if (recent[1] != pageMap.end() &&
-                    recent[1]->first == page_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
+        Addr page_num = page_addr >> TheISA::PageShift;
+        Table *table = root;
+        for (int level = Levels - 1; level > 0; level--) {
+            Table *&next = table->tables[
+                (page_num >> (level * LevelBits)) & mask(LevelBits)];
+            if (!next)
+                next = new Table();
+            table = next;
         }
 
-        // Actually look in the has_map.
-        PageIt it = pageMap.find(page_addr);
-        if (it != pageMap.end()) {
-            update(it);
-            return it->second;
-        }
+        CachePage *&page = table->pages[page_num & mask(LevelBits)];
+        if (!page)
+            page = new CachePage;
+        return page;
+    }
 
-        // Didn't find an existing page, so add a new one.
-        CachePage *newPage = new CachePage;
-        page_addr = page_addr & ~(TheISA::PageBytes - 1);
-        typename PageMap::value_type to_insert(page_addr, newPage);
-        update(pageMap.insert(to_insert).first);
-        return newPage;
+    // Prevent copying
+    AddrMap(const AddrMap&);
+    AddrMap& operator=(const AddrMap&);
+
+    /// Free a table and everything below it.
+    void
+    freeTable(Table *table, int level)
+    {
+        for (int i = 0; i < (1 << LevelBits); i++) {
+            if (level > 0) {
+                if (table->tables[i])
+                    freeTable(table->tables[i], level - 1);
+            } else {
+                delete table->pages[i];
+            }
+        }
+        delete table;
     }
 
   public:
     /// Constructor
-    AddrMap()
+    AddrMap() : root(new Table()), recentAddr(1), recentPage(NULL)
+    {}
+
+    ~AddrMap()
     {
-        recent[0] = recent[1] = pageMap.end();
+        freeTable(root, Levels - 1);
     }
 
     Value &
     lookup(Addr addr)
     {
-        CachePage *page = getPage(addr);
-        return page->items[addr & (TheISA::PageBytes - 1)];
+        Addr page_addr = addr & ~(TheISA::PageBytes - 1);
+
+        // Check against the recent lookup, the address can never match
+        // while there is none as it is not page aligned.
+        if (page_addr != recentAddr) {
+            recentPage = walk(page_addr);
+            recentAddr = page_addr;
+        }
+        return recentPage->items[addr & (TheISA::PageBytes - 1)];
     }
 };
 
@@ -81,6 +81,8 @@ Fetch2::Fetch2(const std::string &name,
         params.fetch2InputBufferSize);
     }
 
+    branchPredictor.setCPU(&cpu);
+
     /* Per-thread input buffers */
     for (ThreadID tid = 0; tid < params.numThreads; tid++) {
         inputBuffer.push_back(
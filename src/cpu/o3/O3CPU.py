@@ -76,6 +76,11 @@ class DerivO3CPU(BaseCPU):
     fetchBufferSize = Param.Unsigned(64, "Fetch buffer size in bytes")
     fetchQueueSize = Param.Unsigned(32, "Fetch queue size in micro-ops "
                                     "per-thread")
+    ftqSize = Param.Unsigned(0, "Fetch blocks the fetch target queue "
+                             "predicts ahead of fetch and prefetches, "
+                             "per-thread (0 disables it)")
+    ftqWidth = Param.Unsigned(2, "Fetch blocks the fetch target queue "
+                              "predicts and prefetches per cycle")
 
     renameToDecodeDelay = Param.Cycles(1, "Rename to decode delay")
     iewToDecodeDelay = Param.Cycles(1, "Issue/Execute/Writeback to decode "
@@ -142,6 +147,9 @@ class DerivO3CPU(BaseCPU):
     numPhysCCRegs = Param.Unsigned(_defaultNumPhysCCRegs,
                                    "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
+    iqScheduler = Param.String('List', "IQ wakeup and select logic: List "
+                               "(dependency lists and ready queues) or "
+                               "Matrix (wakeup and age matrices)")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
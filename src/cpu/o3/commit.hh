@@ -214,6 +214,14 @@ class DefaultCommit
     /** Ticks the commit stage, which tries to commit instructions. */
     void tick();
 
+    /** Checks if ticking the stage would neither commit nor squash on
+     * the following cycles, as the head of the ROB is not ready.
+     */
+    bool canSkipCycles();
+
+    /** Accounts for cycles the stage was not ticked. */
+    void skipCycles(Cycles cycles);
+
     /** Handles any squashes that are sent from IEW, and adds instructions
      * to the ROB and tries to commit instructions.
      */
@@ -646,6 +646,53 @@ DefaultCommit<Impl>::squashAfter(ThreadID tid, DynInstPtr &head_inst)
     squashAfterInst[tid] = head_inst;
 }
 
+template <class Impl>
+bool
+DefaultCommit<Impl>::canSkipCycles()
+{
+    if (_status != Inactive || interrupt != NoFault)
+        return false;
+
+    // A pending interrupt is propagated on every cycle
+    if (FullSystem && cpu->checkInterrupts(cpu->tcBase(0)))
+        return false;
+
+    for (auto tid : *activeThreads) {
+        if (trapSquash[tid] || tcSquash[tid] ||
+            (commitStatus[tid] != Running && commitStatus[tid] != Idle)) {
+            return false;
+        }
+
+        if (!rob->isEmpty(tid) && rob->readHeadInst(tid)->readyToCommit())
+            return false;
+
+        // The ROB would be reported empty to the other stages
+        if (checkEmptyROB[tid] && rob->isEmpty(tid) &&
+            !iewStage->hasStoresToWB(tid)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <class Impl>
+void
+DefaultCommit<Impl>::skipCycles(Cycles cycles)
+{
+    rob->skipCycles(cycles);
+    numCommittedDist.sample(0, cycles);
+
+    for (auto tid : *activeThreads) {
+        if (rob->isEmpty(tid))
+            continue;
+
+        DynInstPtr inst = rob->readHeadInst(tid);
+        for (uint64_t i = 0; i < cycles; ++i)
+            ppCommitStall->notify(inst);
+    }
+}
+
 template <class Impl>
 void
 DefaultCommit<Impl>::tick()
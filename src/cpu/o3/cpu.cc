@@ -185,7 +185,8 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
 
       globalSeqNum(1),
       system(params->system),
-      lastRunningCycle(curCycle())
+      lastRunningCycle(curCycle()),
+      skippingCycles(false)
 {
     if (!params->switched_out) {
         _status = Running;
@@ -202,6 +203,11 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
         checker = NULL;
     }
 
+    // Have the memory of a full pipeline ready, so that filling the
+    // window does not go through the heap
+    Impl::DynInst::reservePool(instPool, params->numROBEntries +
+                               params->fetchQueueSize * numThreads);
+
     if (!FullSystem) {
         thread.resize(numThreads);
         tids.resize(numThreads);
@@ -436,6 +442,15 @@ FullO3CPU<Impl>::regProbePoints()
     commit.regProbePoints();
 }
 
+template <class Impl>
+void
+FullO3CPU<Impl>::regProbeListeners()
+{
+    BaseCPU::regProbeListeners();
+
+    fetch.regProbeListeners();
+}
+
 template <class Impl>
 void
 FullO3CPU<Impl>::regStats()
@@ -606,6 +621,10 @@ FullO3CPU<Impl>::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             timesIdled++;
+        } else if (canSkipCycles()) {
+            DPRINTF(O3CPU, "Pipeline stalled, skipping cycles!\n");
+            lastRunningCycle = curCycle();
+            skippingCycles = true;
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -732,6 +751,8 @@ FullO3CPU<Impl>::activateContext(ThreadID tid)
 {
     assert(!switchedOut());
 
+    stopSkippingCycles();
+
     // Needs to set each stage to running as well.
     activateThread(tid);
 
@@ -772,6 +793,7 @@ FullO3CPU<Impl>::suspendContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid: %i]: Suspending Thread Context.\n", tid);
     assert(!switchedOut());
 
+    stopSkippingCycles();
     deactivateThread(tid);
 
     // If this was the last thread then unschedule the tick event.
@@ -794,6 +816,7 @@ FullO3CPU<Impl>::haltContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i]: Halt Context called. Deallocating", tid);
     assert(!switchedOut());
 
+    stopSkippingCycles();
     deactivateThread(tid);
     removeThread(tid);
 }
@@ -1067,6 +1090,7 @@ FullO3CPU<Impl>::drain()
         return DrainState::Draining;
     } else {
         DPRINTF(Drain, "CPU is already drained\n");
+        stopSkippingCycles();
         if (tickEvent.scheduled())
             deschedule(tickEvent);
 
@@ -1552,6 +1576,10 @@ FullO3CPU<Impl>::squashFromTC(ThreadID tid)
 {
     this->thread[tid]->noSquashFromTC = true;
     this->commit.generateTCEvent(tid);
+
+    // Commit has to tick to squash
+    if (skippingCycles)
+        wakeCPU();
 }
 
 template <class Impl>
@@ -1582,7 +1610,7 @@ FullO3CPU<Impl>::instDone(ThreadID tid, DynInstPtr &inst)
     thread[tid]->numOps++;
     committedOps[tid]++;
 
-    probeInstCommit(inst->staticInst);
+    probeInstCommit(inst->staticInst, inst->contextId(), inst->instAddr());
 }
 
 template <class Impl>
@@ -1752,6 +1780,16 @@ template <class Impl>
 void
 FullO3CPU<Impl>::wakeCPU()
 {
+    if (stopSkippingCycles()) {
+        DPRINTF(Activity, "Waking up stalled CPU\n");
+        // Tick on the next cycle if woken on the cycle it stalled
+        if (curCycle() == lastRunningCycle)
+            schedule(tickEvent, clockEdge(Cycles(1)));
+        else
+            schedule(tickEvent, clockEdge());
+        return;
+    }
+
     if (activityRec.active() || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
@@ -1771,12 +1809,73 @@ FullO3CPU<Impl>::wakeCPU()
     schedule(tickEvent, clockEdge());
 }
 
+template <class Impl>
+bool
+FullO3CPU<Impl>::canSkipCycles()
+{
+    // The SMT policies change their state on every cycle
+    if (numThreads != 1 || activeThreads.size() != 1 ||
+        _status != Running || drainState() != DrainState::Running ||
+        removeInstsThisCycle) {
+        return false;
+    }
+
+    // Only fetch may be active, and nothing may have been sent between
+    // the stages recently
+    for (int idx = DecodeIdx; idx < NumStages; ++idx) {
+        if (activityRec.getStageActive(idx))
+            return false;
+    }
+
+    if (activityRec.getActivityCount() !=
+        (activityRec.getStageActive(FetchIdx) ? 1 : 0)) {
+        return false;
+    }
+
+    return commit.canSkipCycles() && iew.canSkipCycles() &&
+        rename.canSkipCycles() && decode.canSkipCycles() &&
+        fetch.canSkipCycles();
+}
+
+template <class Impl>
+bool
+FullO3CPU<Impl>::stopSkippingCycles()
+{
+    if (!skippingCycles)
+        return false;
+
+    skippingCycles = false;
+
+    // The CPU would have ticked on the cycles in between the last tick
+    // and the current one, with the stages in the same state
+    Cycles cycles(curCycle() - lastRunningCycle);
+    if (cycles > 1) {
+        --cycles;
+        DPRINTF(O3CPU, "Accounting for %d skipped cycles\n", cycles);
+
+        numCycles += cycles;
+        ppCycles->notify(cycles);
+
+        fetch.skipCycles(cycles);
+        decode.skipCycles(cycles);
+        rename.skipCycles(cycles);
+        iew.skipCycles(cycles);
+        commit.skipCycles(cycles);
+    }
+
+    return true;
+}
+
 template <class Impl>
 void
 FullO3CPU<Impl>::wakeup(ThreadID tid)
 {
-    if (this->thread[tid]->status() != ThreadContext::Suspended)
+    if (this->thread[tid]->status() != ThreadContext::Suspended) {
+        // A stalled pipeline has to tick to notice an interrupt
+        if (skippingCycles)
+            wakeCPU();
         return;
+    }
 
     this->wakeCPU();
 
@@ -90,6 +90,20 @@ class BaseO3CPU : public BaseCPU
     void regStats();
 };
 
+/**
+ * Free list of the memory of the dynamic instructions of an O3 CPU, see
+ * BaseO3DynInst::operator new. The memory is freed with the pool.
+ */
+class O3DynInstPool : public std::vector<void *>
+{
+  public:
+    ~O3DynInstPool()
+    {
+        for (auto block : *this)
+            ::operator delete(block);
+    }
+};
+
 /**
  * FullO3CPU class, has each of the stages (fetch through commit)
  * within it, as well as all of the time buffers between stages.  The
@@ -260,6 +274,9 @@ class FullO3CPU : public BaseO3CPU
     /** Register probe points. */
     void regProbePoints() override;
 
+    /** Register listeners on the probe points of other objects. */
+    void regProbeListeners() override;
+
     void demapPage(Addr vaddr, uint64_t asn)
     {
         this->itb->demapPage(vaddr, asn);
@@ -569,6 +586,13 @@ class FullO3CPU : public BaseO3CPU
     int instcount;
 #endif
 
+    /** Memory of the destroyed dynamic instructions of this CPU. Only
+     * the thread of the CPU uses it. It is declared before all the
+     * members holding instructions, which give their memory back to it
+     * when they are destroyed, and frees all of it last.
+     */
+    O3DynInstPool instPool;
+
     /** List of all the instructions in flight. */
     std::list<DynInstPtr> instList;
 
@@ -700,6 +724,18 @@ class FullO3CPU : public BaseO3CPU
     /** Wakes the CPU, rescheduling the CPU if it's not already active. */
     void wakeCPU();
 
+    /** Checks if the pipeline is stalled such that every stage would
+     *  count the same statistics on each cycle until an event wakes the
+     *  CPU, so the CPU can stop ticking meanwhile.
+     */
+    bool canSkipCycles();
+
+    /** Accounts for the cycles skipped since the pipeline stalled as if
+     *  the CPU had ticked on them.
+     *  @return Returns if the CPU was skipping cycles.
+     */
+    bool stopSkippingCycles();
+
     virtual void wakeup(ThreadID tid) override;
 
     /** Gets a free thread id. Use if thread ids change across system. */
@@ -734,6 +770,9 @@ class FullO3CPU : public BaseO3CPU
     /** The cycle that the CPU was last running, used for statistics. */
     Cycles lastRunningCycle;
 
+    /** Whether the CPU stopped ticking with a stalled pipeline. */
+    bool skippingCycles;
+
     /** The cycle that the CPU was last activated by a new thread*/
     Tick lastActivatedCycle;
 
@@ -136,6 +136,16 @@ class DefaultDecode
      */
     void tick();
 
+    /** Checks if ticking the stage would only count the same stall
+     * statistics on the following cycles, and records which ones.
+     */
+    bool canSkipCycles();
+
+    /** Accounts for cycles the stage was not ticked, as recorded by
+     * canSkipCycles().
+     */
+    void skipCycles(Cycles cycles);
+
     /** Determines what to do based on decode's current status.
      * @param status_change decode() sets this variable if there was a status
      * change (ie switching from from blocking to unblocking).
@@ -246,6 +256,9 @@ class DefaultDecode
      */
     bool wroteToTimeBuffer;
 
+    /** Statistic each thread counts on a cycle the stage is not ticked. */
+    Stats::Scalar *skippedCycleStat[Impl::MaxThreads];
+
     /** Source of possible stalls. */
     struct Stalls {
         bool rename;
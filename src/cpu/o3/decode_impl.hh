@@ -546,6 +546,37 @@ DefaultDecode<Impl>::checkSignalsAndUpdate(ThreadID tid)
     return false;
 }
 
+template<class Impl>
+bool
+DefaultDecode<Impl>::canSkipCycles()
+{
+    for (auto tid : *activeThreads) {
+        // Instructions from fetch would be decoded or put in the skid
+        // buffer
+        if (!insts[tid].empty())
+            return false;
+
+        if (decodeStatus[tid] == Blocked && checkStall(tid)) {
+            skippedCycleStat[tid] = &decodeBlockedCycles;
+        } else if ((decodeStatus[tid] == Running ||
+                    decodeStatus[tid] == Idle) && !checkStall(tid)) {
+            skippedCycleStat[tid] = &decodeIdleCycles;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<class Impl>
+void
+DefaultDecode<Impl>::skipCycles(Cycles cycles)
+{
+    for (auto tid : *activeThreads)
+        *skippedCycleStat[tid] += cycles;
+}
+
 template<class Impl>
 void
 DefaultDecode<Impl>::tick()
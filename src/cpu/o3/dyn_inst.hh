@@ -45,6 +45,7 @@
 #define __CPU_O3_DYN_INST_HH__
 
 #include <array>
+#include <vector>
 
 #include "arch/isa_traits.hh"
 #include "config/the_isa.hh"
@@ -96,6 +97,27 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
     ~BaseO3DynInst();
 
+    /**
+     * Dynamic instructions are allocated from the free list of the CPU
+     * that fetches them rather than the heap, as the pipeline creates
+     * and destroys one for every instruction it fetches. Each one keeps
+     * a pointer to the free list it came from in front of it, and goes
+     * back to it when destroyed. The memory of destroyed instructions is
+     * kept for the next ones and never given back.
+     */
+    static void *operator new(size_t size, O3CPU *cpu);
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, O3CPU *cpu);
+    static void operator delete(void *ptr, size_t size);
+
+    /** Add memory for n instructions to a free list. */
+    static void reservePool(std::vector<void *> &pool, size_t n);
+
+  private:
+    /** Room for the free list pointer, keeping the alignment */
+    static const size_t poolHeader = 16;
+
+  public:
     /** Executes the instruction.*/
     Fault execute();
 
@@ -129,6 +151,9 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
 
   public:
+    /** Entry of the instruction in a matrix scheduled IQ, or -1. */
+    int iqSlot;
+
 #if TRACING_ON
     /** Tick records used for the pipeline activity viewer. */
     Tick fetchTick;      // instruction fetch is completed.
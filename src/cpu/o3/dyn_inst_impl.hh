@@ -102,6 +102,70 @@ template <class Impl>BaseO3DynInst<Impl>::~BaseO3DynInst()
 };
 
 
+template <class Impl>
+const size_t BaseO3DynInst<Impl>::poolHeader;
+
+template <class Impl>
+void *
+BaseO3DynInst<Impl>::operator new(size_t size, O3CPU *cpu)
+{
+    static_assert(alignof(BaseO3DynInst) <= poolHeader,
+                  "The pool header breaks the alignment of instructions");
+    std::vector<void *> &pool = cpu->instPool;
+
+    char *block;
+    if (size != sizeof(BaseO3DynInst) || pool.empty()) {
+        block = static_cast<char *>(::operator new(poolHeader + size));
+    } else {
+        block = static_cast<char *>(pool.back());
+        pool.pop_back();
+    }
+
+    // Instructions of another size are not pooled
+    *reinterpret_cast<std::vector<void *> **>(block) =
+        size == sizeof(BaseO3DynInst) ? &pool : NULL;
+    return block + poolHeader;
+}
+
+template <class Impl>
+void *
+BaseO3DynInst<Impl>::operator new(size_t size)
+{
+    char *block = static_cast<char *>(::operator new(poolHeader + size));
+    *reinterpret_cast<std::vector<void *> **>(block) = NULL;
+    return block + poolHeader;
+}
+
+template <class Impl>
+void
+BaseO3DynInst<Impl>::operator delete(void *ptr, O3CPU *cpu)
+{
+    operator delete(ptr, sizeof(BaseO3DynInst));
+}
+
+template <class Impl>
+void
+BaseO3DynInst<Impl>::operator delete(void *ptr, size_t size)
+{
+    char *block = static_cast<char *>(ptr) - poolHeader;
+    std::vector<void *> *pool =
+        *reinterpret_cast<std::vector<void *> **>(block);
+
+    if (pool)
+        pool->push_back(block);
+    else
+        ::operator delete(block);
+}
+
+template <class Impl>
+void
+BaseO3DynInst<Impl>::reservePool(std::vector<void *> &pool, size_t n)
+{
+    pool.reserve(pool.size() + n);
+    for (size_t i = 0; i < n; i++)
+        pool.push_back(::operator new(poolHeader + sizeof(BaseO3DynInst)));
+}
+
 template <class Impl>
 void
 BaseO3DynInst<Impl>::initVars()
@@ -110,6 +174,8 @@ BaseO3DynInst<Impl>::initVars()
 
     _numDestMiscRegs = 0;
 
+    iqSlot = -1;
+
 #if TRACING_ON
     // Value -1 indicates that particular phase
     // hasn't happened (yet).
@@ -44,6 +44,8 @@
 #ifndef __CPU_O3_FETCH_HH__
 #define __CPU_O3_FETCH_HH__
 
+#include <memory>
+
 #include "arch/decoder.hh"
 #include "arch/utility.hh"
 #include "base/statistics.hh"
@@ -148,6 +150,25 @@ class DefaultFetch
         }
       };
 
+    /* Listener on the flushes of the ITLB, which drops the page
+     * translations the fetch target queues prefetch with */
+    class ITLBFlushListener : public ProbeListenerArgBase<uint64_t>
+    {
+      private:
+        DefaultFetch<Impl> *fetch;
+
+      public:
+        ITLBFlushListener(DefaultFetch<Impl> *_fetch, ProbeManager *pm)
+            : ProbeListenerArgBase<uint64_t>(pm, "Flushes"), fetch(_fetch)
+        {}
+
+        void
+        notify(const uint64_t &flushes)
+        {
+            fetch->clearFTQPages();
+        }
+    };
+
   public:
     /** Overall fetch status. Used to determine if the CPU can
      * deschedule itsef due to a lack of activity.
@@ -199,6 +220,8 @@ class DefaultFetch
     ProbePointArg<DynInstPtr> *ppFetch;
     /** To probe when a fetch request is successfully sent. */
     ProbePointArg<RequestPtr> *ppFetchRequestSent;
+    /** Listens to the flushes of the ITLB, when the FTQs are enabled. */
+    std::unique_ptr<ITLBFlushListener> itlbFlushListener;
 
   public:
     /** DefaultFetch constructor. */
@@ -213,6 +236,9 @@ class DefaultFetch
     /** Registers probes. */
     void regProbePoints();
 
+    /** Registers the listeners on the probes of other objects. */
+    void regProbeListeners();
+
     /** Sets the main backwards communication time buffer pointer. */
     void setTimeBuffer(TimeBuffer<TimeStruct> *time_buffer);
 
@@ -338,6 +364,16 @@ class DefaultFetch
      */
     void tick();
 
+    /** Checks if ticking the stage would only count the same stall
+     * statistics on the following cycles, and records which ones.
+     */
+    bool canSkipCycles();
+
+    /** Accounts for cycles the stage was not ticked, as recorded by
+     * canSkipCycles().
+     */
+    void skipCycles(Cycles cycles);
+
     /** Checks all input signals and updates the status as necessary.
      *  @return: Returns if the status has changed due to input signals.
      */
@@ -386,6 +422,40 @@ class DefaultFetch
     /** Profile the reasons of fetch stall. */
     void profileStall(ThreadID tid);
 
+    /** Empties the fetch target queue of a thread and restarts it from a
+     * PC.
+     */
+    void resetFTQ(ThreadID tid, Addr pc);
+
+    /** Moves the fetch target queue along when fetch reads the cache
+     * line of an address, restarting it if fetch left the predicted path.
+     */
+    void consumeFTQ(ThreadID tid, Addr vaddr);
+
+    /** Predicts fetch blocks ahead of fetch and prefetches their lines. */
+    void advanceFTQ(ThreadID tid);
+
+    /** Returns where the fetch block starting at a PC is predicted to go
+     * next.
+     */
+    Addr nextFTQBlock(ThreadID tid, Addr pc);
+
+    /** Sends the I-cache prefetch of the next line of the fetch target
+     * queue.
+     * @return Whether the port could take more requests.
+     */
+    bool prefetchFTQLine(ThreadID tid);
+
+    /** Checks if the fetch target queue has nothing to do until fetch
+     * moves on.
+     */
+    bool ftqIdle(ThreadID tid) const;
+
+    /** Forgets the page translations of the fetch target queues, when
+     * the ITLB is flushed.
+     */
+    void clearFTQPages();
+
   private:
     /** Pointer to the O3CPU. */
     O3CPU *cpu;
@@ -523,6 +593,46 @@ class DefaultFetch
     /** Event used to delay fault generation of translation faults */
     FinishTranslationEvent finishTranslationEvent;
 
+    /** Fetch blocks predicted ahead of fetch, following the taken branches
+     * the BTB knows about, so their cache lines can be prefetched.
+     */
+    struct FetchTargetQueue {
+        struct Block {
+            /** The cache line the block is in. */
+            Addr line;
+            /** Whether a prefetch was sent for the line. */
+            bool prefetched;
+        };
+
+        /** The predicted fetch blocks, oldest first. */
+        std::deque<Block> blocks;
+        /** Number of blocks at the front that were considered for a
+         * prefetch.
+         */
+        unsigned handled;
+        /** Where the next fetch block starts. */
+        Addr nextPC;
+        /** The line fetch is reading, and whether it was prefetched. */
+        Addr fetchLine;
+        bool fetchLinePrefetched;
+        /** The last line a prefetch was sent for. */
+        Addr lastPrefetch;
+        /** Recent page translations of fetch, virtual and physical. */
+        std::deque<std::pair<Addr, Addr>> pages;
+    };
+
+    /** The per-thread fetch target queues. */
+    FetchTargetQueue ftq[Impl::MaxThreads];
+
+    /** Fetch blocks in a fetch target queue, 0 if it is disabled. */
+    const unsigned ftqSize;
+
+    /** Fetch blocks predicted and prefetched per cycle. */
+    const unsigned ftqWidth;
+
+    /** Statistic counted on each cycle the stage is not ticked. */
+    Stats::Scalar *skippedCycleStat;
+
     // @todo: Consider making these vectors and tracking on a per thread basis.
     /** Stat for total number of cycles stalled due to an icache miss. */
     Stats::Scalar icacheStallCycles;
@@ -568,6 +678,18 @@ class DefaultFetch
     Stats::Scalar fetchTlbSquashes;
     /** Distribution of number of instructions fetched each cycle. */
     Stats::Distribution fetchNisnDist;
+    /** Distribution of the number of fetch blocks in the FTQ. */
+    Stats::Distribution ftqOccupancy;
+    /** Number of times fetch left the path the FTQ predicted. */
+    Stats::Scalar ftqResteers;
+    /** Number of I-cache prefetches sent from the FTQ. */
+    Stats::Scalar ftqPrefetches;
+    /** Number of FTQ lines not prefetched for lack of a translation. */
+    Stats::Scalar ftqUntranslated;
+    /** Number of lines fetch read after the FTQ prefetched them. */
+    Stats::Scalar ftqCoveredLines;
+    /** Number of cycles fetch waited on a line the FTQ prefetched. */
+    Stats::Scalar ftqLateStallCycles;
     /** Rate of how often fetch was idle. */
     Stats::Formula idleRate;
     /** Number of branch fetches per cycle. */
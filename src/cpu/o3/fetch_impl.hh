@@ -55,6 +55,7 @@
 #include "arch/tlb.hh"
 #include "arch/utility.hh"
 #include "arch/vtophys.hh"
+#include "base/intmath.hh"
 #include "base/random.hh"
 #include "base/types.hh"
 #include "config/the_isa.hh"
@@ -79,7 +80,8 @@ using namespace std;
 
 template<class Impl>
 DefaultFetch<Impl>::DefaultFetch(O3CPU *_cpu, DerivO3CPUParams *params)
-    : cpu(_cpu),
+    : itlbFlushListener(nullptr),
+      cpu(_cpu),
       decodeToFetchDelay(params->decodeToFetchDelay),
       renameToFetchDelay(params->renameToFetchDelay),
       iewToFetchDelay(params->iewToFetchDelay),
@@ -94,7 +96,10 @@ DefaultFetch<Impl>::DefaultFetch(O3CPU *_cpu, DerivO3CPUParams *params)
       fetchQueueSize(params->fetchQueueSize),
       numThreads(params->numThreads),
       numFetchingThreads(params->smtNumFetchingThreads),
-      finishTranslationEvent(this)
+      finishTranslationEvent(this),
+      ftqSize(params->ftqSize),
+      ftqWidth(params->ftqWidth),
+      skippedCycleStat(NULL)
 {
     if (numThreads > Impl::MaxThreads)
         fatal("numThreads (%d) is larger than compiled limit (%d),\n"
@@ -110,6 +115,9 @@ DefaultFetch<Impl>::DefaultFetch(O3CPU *_cpu, DerivO3CPUParams *params)
     if (cacheBlkSize % fetchBufferSize)
         fatal("cache block (%u bytes) is not a multiple of the "
               "fetch buffer (%u bytes)\n", cacheBlkSize, fetchBufferSize);
+    if (ftqSize && !ftqWidth)
+        fatal("ftqWidth must be at least 1 when the fetch target queue "
+              "is enabled\n");
 
     std::string policy = params->smtFetchPolicy;
 
@@ -150,6 +158,7 @@ DefaultFetch<Impl>::DefaultFetch(O3CPU *_cpu, DerivO3CPUParams *params)
     }
 
     branchPred = params->branchPred;
+    branchPred->setCPU(cpu);
 
     for (ThreadID tid = 0; tid < numThreads; tid++) {
         decoder[tid] = new TheISA::Decoder(params->isa[tid]);
@@ -176,6 +185,17 @@ DefaultFetch<Impl>::regProbePoints()
 
 }
 
+template <class Impl>
+void
+DefaultFetch<Impl>::regProbeListeners()
+{
+    // The FTQs only keep translations when they are enabled
+    if (ftqSize) {
+        itlbFlushListener.reset(
+            new ITLBFlushListener(this, cpu->itb->getProbeManager()));
+    }
+}
+
 template <class Impl>
 void
 DefaultFetch<Impl>::regStats()
@@ -280,6 +300,45 @@ DefaultFetch<Impl>::regStats()
         .desc("Number of instructions fetched each cycle (Total)")
         .flags(Stats::pdf);
 
+    ftqOccupancy
+        .init(/* base value */ 0,
+              /* last value */ std::max(ftqSize, 1U),
+              /* bucket size */ 1)
+        .name(name() + ".ftqOccupancy")
+        .desc("Number of fetch blocks in the fetch target queue each cycle")
+        .flags(Stats::pdf)
+        .prereq(ftqOccupancy);
+
+    ftqResteers
+        .name(name() + ".ftqResteers")
+        .desc("Number of times fetch left the path predicted by the fetch "
+              "target queue")
+        .prereq(ftqResteers);
+
+    ftqPrefetches
+        .name(name() + ".ftqPrefetches")
+        .desc("Number of I-cache prefetches sent from the fetch target "
+              "queue")
+        .prereq(ftqPrefetches);
+
+    ftqUntranslated
+        .name(name() + ".ftqUntranslated")
+        .desc("Number of fetch target queue lines not prefetched because "
+              "their page was not translated recently")
+        .prereq(ftqUntranslated);
+
+    ftqCoveredLines
+        .name(name() + ".ftqCoveredLines")
+        .desc("Number of cache lines fetched after the fetch target queue "
+              "prefetched them")
+        .prereq(ftqCoveredLines);
+
+    ftqLateStallCycles
+        .name(name() + ".ftqLateStallCycles")
+        .desc("Number of cycles fetch is stalled on an Icache miss for a "
+              "line that was prefetched")
+        .prereq(ftqLateStallCycles);
+
     idleRate
         .name(name() + ".idleRate")
         .desc("Percent of cycles fetch was idle")
@@ -367,6 +426,9 @@ DefaultFetch<Impl>::resetStage()
 
         fetchQueue[tid].clear();
 
+        resetFTQ(tid, pc[tid].instAddr());
+        ftq[tid].pages.clear();
+
         priorityList.push_back(tid);
     }
 
@@ -378,6 +440,13 @@ template<class Impl>
 void
 DefaultFetch<Impl>::processCacheCompletion(PacketPtr pkt)
 {
+    // Nothing waits for the prefetches of the fetch target queue
+    if (pkt->cmd == MemCmd::SoftPFResp) {
+        delete pkt->req;
+        delete pkt;
+        return;
+    }
+
     ThreadID tid = cpu->contextToThread(pkt->req->contextId());
 
     DPRINTF(Fetch, "[tid:%u] Waking up from cache miss.\n", tid);
@@ -612,6 +681,8 @@ DefaultFetch<Impl>::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
         return false;
     }
 
+    consumeFTQ(tid, vaddr);
+
     // Align the fetch address to the start of a fetch buffer segment.
     Addr fetchBufferBlockPC = fetchBufferAlignPC(vaddr);
 
@@ -674,6 +745,24 @@ DefaultFetch<Impl>::finishTranslation(const Fault &fault, RequestPtr mem_req)
             return;
         }
 
+        // Remember the page for the prefetches of the fetch target queue
+        if (ftqSize) {
+            auto &pages = ftq[tid].pages;
+            Addr vpage = roundDown(mem_req->getVaddr(), TheISA::PageBytes);
+            Addr ppage = roundDown(mem_req->getPaddr(), TheISA::PageBytes);
+            if (pages.empty() || pages.front().first != vpage) {
+                for (auto it = pages.begin(); it != pages.end(); ++it) {
+                    if (it->first == vpage) {
+                        pages.erase(it);
+                        break;
+                    }
+                }
+                pages.emplace_front(vpage, ppage);
+                if (pages.size() > 8)
+                    pages.pop_back();
+            }
+        }
+
         // Build packet here.
         PacketPtr data_pkt = new Packet(mem_req, MemCmd::ReadReq);
         data_pkt->dataDynamic(new uint8_t[fetchBufferSize]);
@@ -790,6 +879,8 @@ DefaultFetch<Impl>::doSquash(const TheISA::PCState &newPC,
     // Empty fetch queue
     fetchQueue[tid].clear();
 
+    resetFTQ(tid, newPC.instAddr());
+
     // microops are being squashed, it is not known wheather the
     // youngest non-squashed microop was  marked delayed commit
     // or not. Setting the flag to true ensures that the
@@ -928,6 +1019,11 @@ DefaultFetch<Impl>::tick()
     // Record number of instructions fetched this cycle for distribution.
     fetchNisnDist.sample(numInst);
 
+    if (ftqSize) {
+        for (auto tid : *activeThreads)
+            advanceFTQ(tid);
+    }
+
     if (status_change) {
         // Change the fetch stage status if there was a status change.
         _status = updateFetchStatus();
@@ -951,9 +1047,15 @@ DefaultFetch<Impl>::tick()
         }
     }
 
-    // Pick a random thread to start trying to grab instructions from
+    // Pick a random thread to start trying to grab instructions from.
+    // With a single thread there is no choice to make, and no random
+    // number is drawn, so that the cycles skipped by a stalled pipeline
+    // leave the random number stream unchanged.
     auto tid_itr = activeThreads->begin();
-    std::advance(tid_itr, random_mt.random<uint8_t>(0, activeThreads->size() - 1));
+    if (activeThreads->size() > 1) {
+        std::advance(tid_itr,
+                     random_mt.random<uint8_t>(0, activeThreads->size() - 1));
+    }
 
     while (available_insts != 0 && insts_to_decode < decodeWidth) {
         ThreadID tid = *tid_itr;
@@ -986,6 +1088,55 @@ DefaultFetch<Impl>::tick()
     numInst = 0;
 }
 
+template <class Impl>
+bool
+DefaultFetch<Impl>::canSkipCycles()
+{
+    // The SMT fetch policies change their state on every cycle
+    if (numThreads != 1 || activeThreads->size() != 1)
+        return false;
+
+    ThreadID tid = activeThreads->front();
+
+    // Fetch keeps running, but its queue is full and decode is blocked,
+    // so it neither fetches nor sends anything to decode
+    if (fetchStatus[tid] != Running || checkStall(tid) ||
+        !stalls[tid].decode || fetchQueue[tid].size() < fetchQueueSize) {
+        return false;
+    }
+
+    TheISA::PCState thisPC = pc[tid];
+    Addr fetchAddr = (thisPC.instAddr() + fetchOffset[tid]) &
+        BaseCPU::PCMask;
+    bool sameBlock = fetchBufferAlignPC(fetchAddr) == fetchBufferPC[tid];
+
+    // Neither an I-cache access nor a pipelined one may be started
+    if (!macroop[tid] && !(sameBlock && (fetchBufferValid[tid] ||
+                                         isRomMicroPC(thisPC.microPC())))) {
+        return false;
+    }
+
+    // The fetch target queue may still have lines to prefetch
+    if (ftqSize && !ftqIdle(tid))
+        return false;
+
+    if (checkInterrupt(thisPC.instAddr()) && !delayedCommit[tid]) {
+        skippedCycleStat = &fetchMiscStallCycles;
+    } else {
+        skippedCycleStat = &fetchCycles;
+    }
+
+    return true;
+}
+
+template <class Impl>
+void
+DefaultFetch<Impl>::skipCycles(Cycles cycles)
+{
+    *skippedCycleStat += cycles * numFetchingThreads;
+    fetchNisnDist.sample(0, cycles);
+}
+
 template <class Impl>
 bool
 DefaultFetch<Impl>::checkSignalsAndUpdate(ThreadID tid)
@@ -1102,7 +1253,7 @@ DefaultFetch<Impl>::buildInst(ThreadID tid, StaticInstPtr staticInst,
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction =
-        new DynInst(staticInst, curMacroop, thisPC, nextPC, seq, cpu);
+        new (cpu) DynInst(staticInst, curMacroop, thisPC, nextPC, seq, cpu);
     instruction->setTid(tid);
 
     instruction->setASID(tid);
@@ -1199,9 +1350,11 @@ DefaultFetch<Impl>::fetch(bool &status_change)
 
             fetchCacheLine(fetchAddr, tid, thisPC.instAddr());
 
-            if (fetchStatus[tid] == IcacheWaitResponse)
+            if (fetchStatus[tid] == IcacheWaitResponse) {
                 ++icacheStallCycles;
-            else if (fetchStatus[tid] == ItlbWait)
+                if (ftq[tid].fetchLinePrefetched)
+                    ++ftqLateStallCycles;
+            } else if (fetchStatus[tid] == ItlbWait)
                 ++fetchTlbCycles;
             else
                 ++fetchMiscStallCycles;
@@ -1662,6 +1815,8 @@ DefaultFetch<Impl>::profileStall(ThreadID tid) {
         DPRINTF(Fetch, "[tid:%i]: Fetch is squashing!\n", tid);
     } else if (fetchStatus[tid] == IcacheWaitResponse) {
         ++icacheStallCycles;
+        if (ftq[tid].fetchLinePrefetched)
+            ++ftqLateStallCycles;
         DPRINTF(Fetch, "[tid:%i]: Fetch is waiting cache response!\n",
                 tid);
     } else if (fetchStatus[tid] == ItlbWait) {
@@ -1689,4 +1844,189 @@ DefaultFetch<Impl>::profileStall(ThreadID tid) {
     }
 }
 
+template<class Impl>
+void
+DefaultFetch<Impl>::resetFTQ(ThreadID tid, Addr pc)
+{
+    FetchTargetQueue &q = ftq[tid];
+
+    q.blocks.clear();
+    q.handled = 0;
+    q.nextPC = pc;
+    q.fetchLine = MaxAddr;
+    q.fetchLinePrefetched = false;
+    q.lastPrefetch = MaxAddr;
+}
+
+template<class Impl>
+void
+DefaultFetch<Impl>::consumeFTQ(ThreadID tid, Addr vaddr)
+{
+    if (!ftqSize)
+        return;
+
+    FetchTargetQueue &q = ftq[tid];
+    const Addr line = vaddr & ~Addr(cacheBlkSize - 1);
+
+    if (line == q.fetchLine)
+        return;
+
+    q.fetchLine = line;
+    q.fetchLinePrefetched = false;
+
+    // The queue has not caught up with fetch yet
+    if (q.blocks.empty() &&
+        (q.nextPC & ~Addr(cacheBlkSize - 1)) == line) {
+        q.nextPC = nextFTQBlock(tid, q.nextPC);
+        return;
+    }
+
+    while (!q.blocks.empty()) {
+        const auto block = q.blocks.front();
+        q.blocks.pop_front();
+        if (q.handled)
+            --q.handled;
+
+        if (block.line == line) {
+            q.fetchLinePrefetched = block.prefetched;
+            if (block.prefetched)
+                ++ftqCoveredLines;
+            return;
+        }
+    }
+
+    DPRINTF(Fetch, "[tid:%i]: Fetch left the FTQ path at %#x.\n",
+            tid, vaddr);
+
+    ++ftqResteers;
+    q.nextPC = nextFTQBlock(tid, vaddr);
+}
+
+template<class Impl>
+Addr
+DefaultFetch<Impl>::nextFTQBlock(ThreadID tid, Addr pc)
+{
+    const Addr line_end = (pc & ~Addr(cacheBlkSize - 1)) + cacheBlkSize;
+    const Addr step = Addr(1) << branchPred->getInstShiftAmt();
+
+    // The block ends at the first branch the BTB has a target for, or at
+    // the end of the line. Returns are not in the BTB, so the FTQ runs
+    // past them.
+    for (Addr addr = pc; addr < line_end; addr += step) {
+        if (branchPred->BTBValid(addr, tid))
+            return branchPred->BTBLookup(addr, tid).instAddr();
+    }
+
+    return line_end;
+}
+
+template<class Impl>
+void
+DefaultFetch<Impl>::advanceFTQ(ThreadID tid)
+{
+    FetchTargetQueue &q = ftq[tid];
+
+    if (fetchStatus[tid] == Idle || stalls[tid].drain)
+        return;
+
+    for (unsigned i = 0; i < ftqWidth && q.blocks.size() < ftqSize; ++i) {
+        typename FetchTargetQueue::Block block;
+        block.line = q.nextPC & ~Addr(cacheBlkSize - 1);
+        block.prefetched = false;
+        q.blocks.push_back(block);
+
+        q.nextPC = nextFTQBlock(tid, q.nextPC);
+    }
+
+    for (unsigned i = 0; i < ftqWidth && q.handled < q.blocks.size(); ++i) {
+        if (!prefetchFTQLine(tid))
+            break;
+    }
+
+    ftqOccupancy.sample(q.blocks.size());
+}
+
+template<class Impl>
+bool
+DefaultFetch<Impl>::prefetchFTQLine(ThreadID tid)
+{
+    FetchTargetQueue &q = ftq[tid];
+    auto &block = q.blocks[q.handled];
+
+    // Fetch is reading the line already, or it was just prefetched
+    if (block.line == q.fetchLine || block.line == q.lastPrefetch) {
+        block.prefetched = block.line == q.lastPrefetch;
+        ++q.handled;
+        return true;
+    }
+
+    // The ITLB is not walked ahead of fetch, only the lines of the pages
+    // fetch translated recently are prefetched
+    const Addr vpage = roundDown(block.line, TheISA::PageBytes);
+    auto page = std::find_if(q.pages.begin(), q.pages.end(),
+                             [vpage](const std::pair<Addr, Addr> &p)
+                             { return p.first == vpage; });
+    if (page == q.pages.end()) {
+        ++ftqUntranslated;
+        ++q.handled;
+        return true;
+    }
+
+    const Addr paddr = page->second + (block.line - vpage);
+    if (!cpu->system->isMemAddr(paddr)) {
+        ++q.handled;
+        return true;
+    }
+
+    if (cacheBlocked)
+        return false;
+
+    RequestPtr req = new Request(paddr, cacheBlkSize,
+                                 Request::INST_FETCH | Request::PREFETCH,
+                                 cpu->instMasterId());
+    req->taskId(cpu->taskId());
+
+    PacketPtr pkt = new Packet(req, MemCmd::SoftPFReq);
+    pkt->allocate();
+
+    // Try again on a later cycle rather than hold up demand fetches. The
+    // cache sends a retry when it can take requests again, which unblocks
+    // fetch.
+    if (!cpu->getInstPort().sendTimingReq(pkt)) {
+        delete req;
+        delete pkt;
+        cacheBlocked = true;
+        return false;
+    }
+
+    DPRINTF(Fetch, "[tid:%i]: Prefetching line %#x from the FTQ.\n",
+            tid, block.line);
+
+    block.prefetched = true;
+    q.lastPrefetch = block.line;
+    ++q.handled;
+    ++ftqPrefetches;
+    cpu->activityThisCycle();
+
+    return true;
+}
+
+template<class Impl>
+bool
+DefaultFetch<Impl>::ftqIdle(ThreadID tid) const
+{
+    const FetchTargetQueue &q = ftq[tid];
+    return q.blocks.size() >= ftqSize && q.handled == q.blocks.size();
+}
+
+template<class Impl>
+void
+DefaultFetch<Impl>::clearFTQPages()
+{
+    DPRINTF(Fetch, "ITLB flushed, clearing the FTQ page translations.\n");
+
+    for (ThreadID tid = 0; tid < numThreads; ++tid)
+        ftq[tid].pages.clear();
+}
+
 #endif//__CPU_O3_FETCH_IMPL_HH__
@@ -293,6 +293,17 @@ class DefaultIEW
      */
     void tick();
 
+    /** Checks if ticking the stage would neither dispatch, execute nor
+     * write back anything on the following cycles, and records the
+     * stall statistics it would count.
+     */
+    bool canSkipCycles();
+
+    /** Accounts for cycles the stage was not ticked, as recorded by
+     * canSkipCycles().
+     */
+    void skipCycles(Cycles cycles);
+
   private:
     /** Updates execution stats based on the instruction. */
     void updateExeInstStats(DynInstPtr &inst);
@@ -348,6 +359,11 @@ class DefaultIEW
      */
     bool wroteToTimeBuffer;
 
+    /** Statistic each thread counts on a cycle the stage is not ticked,
+     * if any.
+     */
+    Stats::Scalar *skippedCycleStat[Impl::MaxThreads];
+
     /** Debug function to print instructions that are issued this cycle. */
     void printAvailableInsts();
 
@@ -1448,6 +1448,48 @@ DefaultIEW<Impl>::writebackInsts()
     }
 }
 
+template<class Impl>
+bool
+DefaultIEW<Impl>::canSkipCycles()
+{
+    if (_status != Inactive || exeStatus != Idle || updateLSQNextCycle ||
+        instQueue.hasReadyInsts() || ldstQueue.hasStoresToSend()) {
+        return false;
+    }
+
+    for (auto tid : *activeThreads) {
+        if (!insts[tid].empty())
+            return false;
+
+        bool stall = checkStall(tid);
+
+        if (dispatchStatus[tid] == Blocked && stall) {
+            skippedCycleStat[tid] = &iewBlockCycles;
+        } else if ((dispatchStatus[tid] == Running ||
+                    dispatchStatus[tid] == Idle) && !stall) {
+            skippedCycleStat[tid] = NULL;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<class Impl>
+void
+DefaultIEW<Impl>::skipCycles(Cycles cycles)
+{
+    for (auto tid : *activeThreads) {
+        if (skippedCycleStat[tid])
+            *skippedCycleStat[tid] += cycles;
+    }
+
+    // As updateStatus() and the IQ scheduling do on every cycle
+    instQueue.intInstQueueReads += cycles;
+    instQueue.skipCycles(cycles);
+}
+
 template<class Impl>
 void
 DefaultIEW<Impl>::tick()
@@ -49,9 +49,11 @@
 #include <queue>
 #include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/o3/dep_graph.hh"
+#include "cpu/o3/iq_matrix.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
@@ -93,6 +95,7 @@ class InstructionQueue
 
     // Typedef of iterator through the list of instructions.
     typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename CircularQueue<DynInstPtr>::iterator InstListIt;
 
     /** FU completion event class. */
     class FUCompletion : public Event {
@@ -217,6 +220,11 @@ class InstructionQueue
      */
     void scheduleReadyInsts();
 
+    /** Accounts for cycles on which no instructions were ready and the
+     * CPU did not tick.
+     */
+    void skipCycles(Cycles cycles);
+
     /** Schedules a single specific non-speculative instruction. */
     void scheduleNonSpec(const InstSeqNum &inst);
 
@@ -275,6 +283,12 @@ class InstructionQueue
     /** Does the actual squashing. */
     void doSquash(ThreadID tid);
 
+    /**
+     * Tries to get a FU for a ready instruction and sends it to execute.
+     * @return Whether the instruction was issued.
+     */
+    bool issueToFU(DynInstPtr &issuing_inst, IssueStruct *i2e_info);
+
     /////////////////////////
     // Various pointers
     /////////////////////////
@@ -311,8 +325,10 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued),
+     *  in program order for each thread.
+     */
+    CircularQueue<DynInstPtr> instList[Impl::MaxThreads];
 
     /** List of instructions that are ready to be executed. */
     std::list<DynInstPtr> instsToExecute;
@@ -399,6 +415,55 @@ class InstructionQueue
 
     DependencyGraph<DynInstPtr> dependGraph;
 
+    //////////////////////////////////////
+    // Wakeup and age matrices
+    //////////////////////////////////////
+
+    /** Whether the matrices are used in place of the dependency graph
+     *  and the ready queues.
+     */
+    bool matrixScheduler;
+
+    /** The instruction of each IQ entry.  Like the other IQ resources, an
+     *  entry is held until the instruction issues, or completes if it is
+     *  a memory instruction.
+     */
+    std::vector<DynInstPtr> iqSlots;
+
+    /** Entries that are not in use. */
+    std::vector<int> freeSlots;
+
+    /** Entries that are in use. */
+    EntrySet occupiedSlots;
+
+    /** Entries whose instruction is ready to issue. */
+    EntrySet readySlots;
+
+    /** Entries still to be looked at by the select logic this cycle. */
+    EntrySet selectSlots;
+
+    /** The entries waiting on each physical register. */
+    std::vector<EntrySet> wakeupMatrix;
+
+    /** Age order of the entries, used to select the oldest ready one. */
+    AgeMatrix ageMatrix;
+
+    /** Gives an instruction an entry in the matrices. */
+    void allocateSlot(DynInstPtr &inst);
+
+    /** Releases the entry of an instruction. */
+    void freeSlot(DynInstPtr &inst);
+
+    /** Wakes the instructions waiting on a register. */
+    int wakeMatrixDependents(int flat_idx);
+
+    /**
+     * Issues the oldest ready instructions while there is issue width
+     * left.
+     * @return The number of instructions issued.
+     */
+    int scheduleMatrixInsts(IssueStruct *i2e_info);
+
     //////////////////////////////////////
     // Various parameters
     //////////////////////////////////////
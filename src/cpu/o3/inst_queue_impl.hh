@@ -45,6 +45,7 @@
 #ifndef __CPU_O3_INST_QUEUE_IMPL_HH__
 #define __CPU_O3_INST_QUEUE_IMPL_HH__
 
+#include <bitset>
 #include <limits>
 #include <vector>
 
@@ -111,10 +112,36 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
 
+    std::string scheduler = params->iqScheduler;
+    std::transform(scheduler.begin(), scheduler.end(), scheduler.begin(),
+                   (int(*)(int)) tolower);
+
+    if (scheduler == "list") {
+        matrixScheduler = false;
+    } else if (scheduler == "matrix") {
+        matrixScheduler = true;
+
+        iqSlots.resize(numEntries);
+        occupiedSlots.resize(numEntries);
+        readySlots.resize(numEntries);
+        selectSlots.resize(numEntries);
+        ageMatrix.resize(numEntries);
+
+        wakeupMatrix.resize(numPhysRegs);
+        for (auto &row : wakeupMatrix)
+            row.resize(numEntries);
+    } else {
+        fatal("Invalid IQ scheduler %s, options are List and Matrix.\n",
+              params->iqScheduler);
+    }
+
     //Initialize Mem Dependence Units
     for (ThreadID tid = 0; tid < numThreads; tid++) {
         memDepUnit[tid].init(params, tid);
         memDepUnit[tid].setIQ(this);
+
+        // Issued instructions stay in the list until they commit
+        instList[tid].reserve(params->numROBEntries);
     }
 
     resetState();
@@ -419,6 +446,18 @@ InstructionQueue<Impl>::resetState()
     blockedMemInsts.clear();
     retryMemInsts.clear();
     wbOutstanding = 0;
+
+    if (matrixScheduler) {
+        freeSlots.clear();
+        for (int slot = numEntries - 1; slot >= 0; --slot) {
+            iqSlots[slot] = NULL;
+            freeSlots.push_back(slot);
+        }
+        occupiedSlots.clear();
+        readySlots.clear();
+        for (auto &row : wakeupMatrix)
+            row.clear();
+    }
 }
 
 template <class Impl>
@@ -449,6 +488,7 @@ bool
 InstructionQueue<Impl>::isDrained() const
 {
     bool drained = dependGraph.empty() &&
+                   !occupiedSlots.any() &&
                    instsToExecute.empty() &&
                    wbOutstanding == 0;
     for (ThreadID tid = 0; tid < numThreads; ++tid)
@@ -462,6 +502,7 @@ void
 InstructionQueue<Impl>::drainSanityCheck() const
 {
     assert(dependGraph.empty());
+    assert(!occupiedSlots.any());
     assert(instsToExecute.empty());
     for (ThreadID tid = 0; tid < numThreads; ++tid)
         memDepUnit[tid].drainSanityCheck();
@@ -554,6 +595,9 @@ InstructionQueue<Impl>::hasReadyInsts()
         return true;
     }
 
+    if (matrixScheduler)
+        return readySlots.any();
+
     for (int i = 0; i < Num_OpClasses; ++i) {
         if (!readyInsts[i].empty()) {
             return true;
@@ -588,6 +632,9 @@ InstructionQueue<Impl>::insert(DynInstPtr &new_inst)
 
     new_inst->setInIQ();
 
+    if (matrixScheduler)
+        allocateSlot(new_inst);
+
     // Look through its source registers (physical regs), and mark any
     // dependencies.
     addToDependents(new_inst);
@@ -639,6 +686,9 @@ InstructionQueue<Impl>::insertNonSpec(DynInstPtr &new_inst)
 
     new_inst->setInIQ();
 
+    if (matrixScheduler)
+        allocateSlot(new_inst);
+
     // Have this instruction set itself as the producer of its destination
     // register(s).
     addToProducers(new_inst);
@@ -787,6 +837,11 @@ InstructionQueue<Impl>::scheduleReadyInsts()
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
+
+    // With the matrices, the age order list stays empty
+    if (matrixScheduler)
+        total_issued = scheduleMatrixInsts(i2e_info);
+
     ListOrderIt order_it = listOrder.begin();
     ListOrderIt order_end_it = listOrder.end();
 
@@ -824,60 +879,7 @@ InstructionQueue<Impl>::scheduleReadyInsts()
             continue;
         }
 
-        int idx = FUPool::NoCapableFU;
-        Cycles op_latency = Cycles(1);
-        ThreadID tid = issuing_inst->threadNumber;
-
-        if (op_class != No_OpClass) {
-            idx = fuPool->getUnit(op_class);
-            if (issuing_inst->isFloating()) {
-                fpAluAccesses++;
-            } else if (issuing_inst->isVector()) {
-                vecAluAccesses++;
-            } else {
-                intAluAccesses++;
-            }
-            if (idx > FUPool::NoFreeFU) {
-                op_latency = fuPool->getOpLatency(op_class);
-            }
-        }
-
-        // If we have an instruction that doesn't require a FU, or a
-        // valid FU, then schedule for execution.
-        if (idx != FUPool::NoFreeFU) {
-            if (op_latency == Cycles(1)) {
-                i2e_info->size++;
-                instsToExecute.push_back(issuing_inst);
-
-                // Add the FU onto the list of FU's to be freed next
-                // cycle if we used one.
-                if (idx >= 0)
-                    fuPool->freeUnitNextCycle(idx);
-            } else {
-                bool pipelined = fuPool->isPipelined(op_class);
-                // Generate completion event for the FU
-                ++wbOutstanding;
-                FUCompletion *execution = new FUCompletion(issuing_inst,
-                                                           idx, this);
-
-                cpu->schedule(execution,
-                              cpu->clockEdge(Cycles(op_latency - 1)));
-
-                if (!pipelined) {
-                    // If FU isn't pipelined, then it must be freed
-                    // upon the execution completing.
-                    execution->setFreeFU();
-                } else {
-                    // Add the FU onto the list of FU's to be freed next cycle.
-                    fuPool->freeUnitNextCycle(idx);
-                }
-            }
-
-            DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
-                    "[sn:%lli]\n",
-                    tid, issuing_inst->pcState(),
-                    issuing_inst->seqNum);
-
+        if (issueToFU(issuing_inst, i2e_info)) {
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
@@ -887,28 +889,9 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                 queueOnList[op_class] = false;
             }
 
-            issuing_inst->setIssued();
             ++total_issued;
-
-#if TRACING_ON
-            issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
-
-            if (!issuing_inst->isMemRef()) {
-                // Memory instructions can not be freed from the IQ until they
-                // complete.
-                ++freeEntries;
-                count[tid]--;
-                issuing_inst->clearInIQ();
-            } else {
-                memDepUnit[tid].issue(issuing_inst);
-            }
-
             listOrder.erase(order_it++);
-            statIssuedInstType[tid][op_class]++;
         } else {
-            statFuBusy[op_class]++;
-            fuBusy[tid]++;
             ++order_it;
         }
     }
@@ -927,6 +910,148 @@ InstructionQueue<Impl>::scheduleReadyInsts()
     }
 }
 
+template <class Impl>
+bool
+InstructionQueue<Impl>::issueToFU(DynInstPtr &issuing_inst,
+                                  IssueStruct *i2e_info)
+{
+    OpClass op_class = issuing_inst->opClass();
+    int idx = FUPool::NoCapableFU;
+    Cycles op_latency = Cycles(1);
+    ThreadID tid = issuing_inst->threadNumber;
+
+    if (op_class != No_OpClass) {
+        idx = fuPool->getUnit(op_class);
+        if (issuing_inst->isFloating()) {
+            fpAluAccesses++;
+        } else if (issuing_inst->isVector()) {
+            vecAluAccesses++;
+        } else {
+            intAluAccesses++;
+        }
+        if (idx > FUPool::NoFreeFU) {
+            op_latency = fuPool->getOpLatency(op_class);
+        }
+    }
+
+    if (idx == FUPool::NoFreeFU) {
+        statFuBusy[op_class]++;
+        fuBusy[tid]++;
+        return false;
+    }
+
+    // We have an instruction that doesn't require a FU, or a valid FU,
+    // so schedule for execution.
+    if (op_latency == Cycles(1)) {
+        i2e_info->size++;
+        instsToExecute.push_back(issuing_inst);
+
+        // Add the FU onto the list of FU's to be freed next
+        // cycle if we used one.
+        if (idx >= 0)
+            fuPool->freeUnitNextCycle(idx);
+    } else {
+        bool pipelined = fuPool->isPipelined(op_class);
+        // Generate completion event for the FU
+        ++wbOutstanding;
+        FUCompletion *execution = new FUCompletion(issuing_inst,
+                                                   idx, this);
+
+        cpu->schedule(execution,
+                      cpu->clockEdge(Cycles(op_latency - 1)));
+
+        if (!pipelined) {
+            // If FU isn't pipelined, then it must be freed
+            // upon the execution completing.
+            execution->setFreeFU();
+        } else {
+            // Add the FU onto the list of FU's to be freed next cycle.
+            fuPool->freeUnitNextCycle(idx);
+        }
+    }
+
+    DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
+            "[sn:%lli]\n",
+            tid, issuing_inst->pcState(),
+            issuing_inst->seqNum);
+
+    issuing_inst->setIssued();
+
+#if TRACING_ON
+    issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
+#endif
+
+    if (!issuing_inst->isMemRef()) {
+        // Memory instructions can not be freed from the IQ until they
+        // complete.
+        ++freeEntries;
+        count[tid]--;
+        issuing_inst->clearInIQ();
+        if (matrixScheduler)
+            freeSlot(issuing_inst);
+    } else {
+        memDepUnit[tid].issue(issuing_inst);
+    }
+
+    statIssuedInstType[tid][op_class]++;
+    return true;
+}
+
+template <class Impl>
+int
+InstructionQueue<Impl>::scheduleMatrixInsts(IssueStruct *i2e_info)
+{
+    int total_issued = 0;
+    // Op classes whose FUs are all in use this cycle
+    std::bitset<Num_OpClasses> busy;
+
+    selectSlots = readySlots;
+
+    while (total_issued < totalWidth) {
+        int slot = ageMatrix.oldest(selectSlots);
+        if (slot < 0)
+            break;
+
+        selectSlots.reset(slot);
+
+        DynInstPtr issuing_inst = iqSlots[slot];
+        if (busy[issuing_inst->opClass()])
+            continue;
+
+        if (issuing_inst->isFloating()) {
+            fpInstQueueReads++;
+        } else if (issuing_inst->isVector()) {
+            vecInstQueueReads++;
+        } else {
+            intInstQueueReads++;
+        }
+
+        // The entry is released once the IQ handles the squash
+        if (issuing_inst->isSquashed()) {
+            readySlots.reset(slot);
+            ++iqSquashedInstsIssued;
+            continue;
+        }
+
+        if (issueToFU(issuing_inst, i2e_info)) {
+            readySlots.reset(slot);
+            ++total_issued;
+        } else {
+            busy.set(issuing_inst->opClass());
+        }
+    }
+
+    return total_issued;
+}
+
+template <class Impl>
+void
+InstructionQueue<Impl>::skipCycles(Cycles cycles)
+{
+    assert(!hasReadyInsts());
+    numIssuedDist.sample(0, cycles);
+}
+
 template <class Impl>
 void
 InstructionQueue<Impl>::scheduleNonSpec(const InstSeqNum &inst)
@@ -962,11 +1087,8 @@ InstructionQueue<Impl>::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i]: Committing instructions older than [sn:%i]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
         instList[tid].pop_front();
     }
 
@@ -1025,6 +1147,12 @@ InstructionQueue<Impl>::wakeDependents(DynInstPtr &completed_inst)
                 dest_reg->index(),
                 dest_reg->className());
 
+        if (matrixScheduler) {
+            dependents += wakeMatrixDependents(dest_reg->flatIndex());
+            regScoreboard[dest_reg->flatIndex()] = true;
+            continue;
+        }
+
         //Go through the dependency chain, marking the registers as
         //ready within the waiting instructions.
         DynInstPtr dep_inst = dependGraph.pop(dest_reg->flatIndex());
@@ -1063,6 +1191,22 @@ InstructionQueue<Impl>::addReadyMemInst(DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
+    if (matrixScheduler) {
+        // The entry of a squashed instruction may already be released
+        if (ready_inst->iqSlot < 0) {
+            assert(ready_inst->isSquashedInIQ());
+            ++iqSquashedInstsIssued;
+            return;
+        }
+
+        readySlots.set(ready_inst->iqSlot);
+
+        DPRINTF(IQ, "Instruction is ready to issue, marking its entry "
+                "ready, PC %s opclass:%i [sn:%lli].\n",
+                ready_inst->pcState(), op_class, ready_inst->seqNum);
+        return;
+    }
+
     readyInsts[op_class].push(ready_inst);
 
     // Will need to reorder the list if either a queue is not on the list,
@@ -1112,6 +1256,9 @@ InstructionQueue<Impl>::completeMemInst(DynInstPtr &completed_inst)
 
     ++freeEntries;
 
+    if (matrixScheduler)
+        freeSlot(completed_inst);
+
     completed_inst->memOpDone(true);
 
     memDepUnit[tid].completed(completed_inst);
@@ -1204,19 +1351,15 @@ template <class Impl>
 void
 InstructionQueue<Impl>::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
-
     DPRINTF(IQ, "[tid:%i]: Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given, starting at the tail.
+    while (!instList[tid].empty() &&
+           instList[tid].back()->seqNum > squashedSeqNum[tid]) {
 
-        DynInstPtr squashed_inst = (*squash_it);
+        DynInstPtr squashed_inst = instList[tid].back();
         if (squashed_inst->isFloating()) {
             fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1229,7 +1372,7 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
         // hasn't already been squashed in the IQ.
         if (squashed_inst->threadNumber != tid ||
             squashed_inst->isSquashedInIQ()) {
-            --squash_it;
+            instList[tid].pop_back();
             continue;
         }
 
@@ -1270,8 +1413,13 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
 
                     if (!squashed_inst->isReadySrcRegIdx(src_reg_idx) &&
                         !src_reg->isFixedMapping()) {
-                        dependGraph.remove(src_reg->flatIndex(),
-                                           squashed_inst);
+                        if (matrixScheduler) {
+                            wakeupMatrix[src_reg->flatIndex()].reset(
+                                squashed_inst->iqSlot);
+                        } else {
+                            dependGraph.remove(src_reg->flatIndex(),
+                                               squashed_inst);
+                        }
                     }
 
 
@@ -1312,13 +1460,16 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
             squashed_inst->setCanCommit();
             squashed_inst->clearInIQ();
 
+            if (matrixScheduler)
+                freeSlot(squashed_inst);
+
             //Update Thread IQ Count
             count[squashed_inst->threadNumber]--;
 
             ++freeEntries;
         }
 
-        instList[tid].erase(squash_it--);
+        instList[tid].pop_back();
         ++iqSquashedInstsExamined;
     }
 }
@@ -1352,7 +1503,11 @@ InstructionQueue<Impl>::addToDependents(DynInstPtr &new_inst)
                         new_inst->pcState(), src_reg->index(),
                         src_reg->className());
 
-                dependGraph.insert(src_reg->flatIndex(), new_inst);
+                if (matrixScheduler) {
+                    wakeupMatrix[src_reg->flatIndex()].set(new_inst->iqSlot);
+                } else {
+                    dependGraph.insert(src_reg->flatIndex(), new_inst);
+                }
 
                 // Change the return value to indicate that something
                 // was added to the dependency graph.
@@ -1393,6 +1548,16 @@ InstructionQueue<Impl>::addToProducers(DynInstPtr &new_inst)
             continue;
         }
 
+        if (matrixScheduler) {
+            panic_if(wakeupMatrix[dest_reg->flatIndex()].any(),
+                     "Wakeup matrix row %i (%s) (flat: %i) not empty!",
+                     dest_reg->index(), dest_reg->className(),
+                     dest_reg->flatIndex());
+
+            regScoreboard[dest_reg->flatIndex()] = false;
+            continue;
+        }
+
         if (!dependGraph.empty(dest_reg->flatIndex())) {
             dependGraph.dump();
             panic("Dependency graph %i (%s) (flat: %i) not empty!",
@@ -1429,6 +1594,15 @@ InstructionQueue<Impl>::addIfReady(DynInstPtr &inst)
 
         OpClass op_class = inst->opClass();
 
+        if (matrixScheduler) {
+            DPRINTF(IQ, "Instruction is ready to issue, marking its entry "
+                    "ready, PC %s opclass:%i [sn:%lli].\n",
+                    inst->pcState(), op_class, inst->seqNum);
+
+            readySlots.set(inst->iqSlot);
+            return;
+        }
+
         DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
                 "the ready list, PC %s opclass:%i [sn:%lli].\n",
                 inst->pcState(), op_class, inst->seqNum);
@@ -1447,6 +1621,76 @@ InstructionQueue<Impl>::addIfReady(DynInstPtr &inst)
     }
 }
 
+template <class Impl>
+void
+InstructionQueue<Impl>::allocateSlot(DynInstPtr &inst)
+{
+    assert(!freeSlots.empty());
+
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    // The new instruction is younger than any other in the IQ
+    ageMatrix.allocate(slot, occupiedSlots);
+    occupiedSlots.set(slot);
+
+    iqSlots[slot] = inst;
+    inst->iqSlot = slot;
+}
+
+template <class Impl>
+void
+InstructionQueue<Impl>::freeSlot(DynInstPtr &inst)
+{
+    int slot = inst->iqSlot;
+    assert(slot >= 0 && iqSlots[slot] == inst);
+
+    occupiedSlots.reset(slot);
+    readySlots.reset(slot);
+
+    iqSlots[slot] = NULL;
+    inst->iqSlot = -1;
+    freeSlots.push_back(slot);
+}
+
+template <class Impl>
+int
+InstructionQueue<Impl>::wakeMatrixDependents(int flat_idx)
+{
+    EntrySet &waiting = wakeupMatrix[flat_idx];
+    int dependents = 0;
+
+    for (int slot = waiting.findNext(0); slot >= 0;
+         slot = waiting.findNext(slot + 1)) {
+        DynInstPtr dep_inst = iqSlots[slot];
+
+        DPRINTF(IQ, "Waking up a dependent instruction, [sn:%lli] "
+                "PC %s.\n", dep_inst->seqNum, dep_inst->pcState());
+
+        // An instruction waits once on a register it reads several times
+        for (int src_reg_idx = 0;
+             src_reg_idx < dep_inst->numSrcRegs();
+             src_reg_idx++)
+        {
+            PhysRegIdPtr src_reg = dep_inst->renamedSrcRegIdx(src_reg_idx);
+
+            if (!dep_inst->isReadySrcRegIdx(src_reg_idx) &&
+                !src_reg->isFixedMapping() &&
+                src_reg->flatIndex() == flat_idx) {
+                dep_inst->markSrcRegReady(src_reg_idx);
+            }
+        }
+
+        addIfReady(dep_inst);
+
+        ++dependents;
+    }
+
+    waiting.clear();
+
+    return dependents;
+}
+
 template <class Impl>
 int
 InstructionQueue<Impl>::countInsts()
@@ -1459,7 +1703,7 @@ InstructionQueue<Impl>::countInsts()
     int total_insts = 0;
 
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
-        ListIt count_it = instList[tid].begin();
+        InstListIt count_it = instList[tid].begin();
 
         while (count_it != instList[tid].end()) {
             if (!(*count_it)->isSquashed() && !(*count_it)->isSquashedInIQ()) {
@@ -1533,7 +1777,7 @@ InstructionQueue<Impl>::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        InstListIt inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
             cprintf("Instruction:%i\n", num);
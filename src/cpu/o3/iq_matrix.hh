@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_IQ_MATRIX_HH__
+#define __CPU_O3_IQ_MATRIX_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+/**
+ * A set of IQ entries, kept as a bit per entry. This is the row of a
+ * wakeup or age matrix; scanning it costs a word per 64 entries.
+ */
+class EntrySet
+{
+  public:
+    void
+    resize(int num_entries)
+    {
+        words.assign((num_entries + 63) / 64, 0);
+    }
+
+    void set(int idx) { words[idx / 64] |= ULL(1) << (idx % 64); }
+    void reset(int idx) { words[idx / 64] &= ~(ULL(1) << (idx % 64)); }
+
+    bool
+    test(int idx) const
+    {
+        return words[idx / 64] & (ULL(1) << (idx % 64));
+    }
+
+    void
+    clear()
+    {
+        for (auto &word : words)
+            word = 0;
+    }
+
+    bool
+    any() const
+    {
+        for (auto word : words) {
+            if (word)
+                return true;
+        }
+        return false;
+    }
+
+    bool
+    intersects(const EntrySet &other) const
+    {
+        assert(words.size() == other.words.size());
+        for (int i = 0; i < words.size(); ++i) {
+            if (words[i] & other.words[i])
+                return true;
+        }
+        return false;
+    }
+
+    /** Remove the entries of another set, unless none would be left. */
+    void
+    removeUnlessAll(const EntrySet &other)
+    {
+        assert(words.size() == other.words.size());
+        int i = 0;
+        while (i < words.size() && !(words[i] & ~other.words[i]))
+            ++i;
+        if (i == words.size())
+            return;
+
+        for (i = 0; i < words.size(); ++i)
+            words[i] &= ~other.words[i];
+    }
+
+    /** @return The first entry in the set from idx on, or -1. */
+    int
+    findNext(int idx) const
+    {
+        int i = idx / 64;
+        if (i >= words.size())
+            return -1;
+
+        uint64_t word = words[i] & (~ULL(0) << (idx % 64));
+        while (!word) {
+            if (++i == words.size())
+                return -1;
+            word = words[i];
+        }
+        return i * 64 + findLsbSet(word);
+    }
+
+  private:
+    std::vector<uint64_t> words;
+};
+
+/**
+ * Relative age of the IQ entries. Every entry gets a rank that grows
+ * with its allocation, kept as one set of entries per bit of the rank,
+ * i.e. a column of "older than" bits per rank bit. The oldest of a set
+ * of requests is found from the most significant rank bit down, by
+ * dropping the requests with the bit set whenever some have it clear,
+ * which costs a word per 64 entries and rank bit however many requests
+ * there are.
+ */
+class AgeMatrix
+{
+  public:
+    void
+    resize(int num_entries)
+    {
+        // Ranks are renumbered when they run out, which the room for
+        // twice as many ranks as entries keeps rare
+        maxRank = 2 * num_entries;
+        nextRank = 0;
+        ranks.assign(num_entries, 0);
+        rankBits.resize(ceilLog2(maxRank));
+        for (auto &bits : rankBits)
+            bits.resize(num_entries);
+        candidates.resize(num_entries);
+    }
+
+    /**
+     * Make an entry the youngest.
+     *
+     * @param occupied The entries in use, not including the new one.
+     */
+    void
+    allocate(int idx, const EntrySet &occupied)
+    {
+        if (nextRank == maxRank)
+            renumber(occupied);
+        setRank(idx, nextRank++);
+    }
+
+    /** @return The oldest entry of a set, or -1 if it is empty. */
+    int
+    oldest(const EntrySet &requests) const
+    {
+        candidates = requests;
+        for (int bit = rankBits.size() - 1; bit >= 0; --bit)
+            candidates.removeUnlessAll(rankBits[bit]);
+        return candidates.findNext(0);
+    }
+
+  private:
+    void
+    setRank(int idx, unsigned rank)
+    {
+        ranks[idx] = rank;
+        for (int bit = 0; bit < rankBits.size(); ++bit) {
+            if (rank & (1 << bit))
+                rankBits[bit].set(idx);
+            else
+                rankBits[bit].reset(idx);
+        }
+    }
+
+    /** Give the entries in use the lowest ranks, in the same order. */
+    void
+    renumber(const EntrySet &occupied)
+    {
+        std::vector<std::pair<unsigned, int>> by_rank;
+        for (int i = occupied.findNext(0); i >= 0;
+             i = occupied.findNext(i + 1)) {
+            by_rank.emplace_back(ranks[i], i);
+        }
+        std::sort(by_rank.begin(), by_rank.end());
+
+        nextRank = 0;
+        for (const auto &entry : by_rank)
+            setRank(entry.second, nextRank++);
+    }
+
+    /** The rank of every entry, and its bits as sets of entries */
+    std::vector<unsigned> ranks;
+    std::vector<EntrySet> rankBits;
+    unsigned nextRank;
+    unsigned maxRank;
+
+    /** The requests that may still be the oldest */
+    mutable EntrySet candidates;
+};
+
+#endif // __CPU_O3_IQ_MATRIX_HH__
@@ -265,6 +265,11 @@ class LSQ {
     bool willWB(ThreadID tid)
     { return thread[tid].willWB(); }
 
+    /** Returns if the LSQ has stores to send to the cache, or is waiting
+     * for the cache to unblock.
+     */
+    bool hasStoresToSend();
+
     /** Debugging function to print out all instructions. */
     void dumpInsts() const;
     /** Debugging function to print out instructions from a specific thread. */
@@ -685,6 +685,18 @@ LSQ<Impl>::willWB()
     return false;
 }
 
+template<class Impl>
+bool
+LSQ<Impl>::hasStoresToSend()
+{
+    for (auto tid : *activeThreads) {
+        if (thread[tid].hasStoresToSend())
+            return true;
+    }
+
+    return false;
+}
+
 template<class Impl>
 void
 LSQ<Impl>::dumpInsts() const
@@ -225,6 +225,17 @@ class LSQUnit {
                         !storeQueue[storeWBIdx].completed &&
                         !isStoreBlocked; }
 
+    /** Returns if writing back stores would send any to the cache, or if
+     * a store is waiting for the cache to unblock.
+     */
+    bool hasStoresToSend() const
+    {
+        return hasPendingPkt || isStoreBlocked ||
+            (storesToWB > 0 && storeWBIdx != storeTail &&
+             storeQueue[storeWBIdx].inst && storeQueue[storeWBIdx].canWB &&
+             (!needsTSO || !storeInFlight));
+    }
+
     /** Handles doing the retry. */
     void recvRetry();
 
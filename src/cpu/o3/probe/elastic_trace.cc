@@ -158,7 +158,7 @@ ElasticTrace::fetchReqTrace(const RequestPtr &req)
     inst_fetch_pkt.set_addr(req->getPaddr());
     inst_fetch_pkt.set_size(req->getSize());
     // Write the message to the stream.
-    instTraceStream->write(inst_fetch_pkt);
+    instTraceStream->write(inst_fetch_pkt, curTick());
 }
 
 void
@@ -854,8 +854,10 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 dep_pkt.set_weight(num_filtered_nodes);
                 num_filtered_nodes = 0;
             }
-            // Write the message to the protobuf output stream
-            dataTraceStream->write(dep_pkt);
+            // Write the message to the protobuf output stream, keyed by
+            // its commit tick and sequence number for seeking
+            dataTraceStream->write(dep_pkt, temp_ptr->commitTick,
+                                   temp_ptr->instNum);
         } else {
             // Don't write the node to the trace but note that we have filtered
             // out a node.
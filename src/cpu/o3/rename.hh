@@ -198,6 +198,16 @@ class DefaultRename
      */
     void tick();
 
+    /** Checks if ticking the stage would only count the same stall
+     * statistics on the following cycles, and records which ones.
+     */
+    bool canSkipCycles();
+
+    /** Accounts for cycles the stage was not ticked, as recorded by
+     * canSkipCycles().
+     */
+    void skipCycles(Cycles cycles);
+
     /** Debugging function used to dump history buffer of renamings. */
     void dumpHistory();
 
@@ -387,6 +397,9 @@ class DefaultRename
      */
     bool wroteToTimeBuffer;
 
+    /** Statistic each thread counts on a cycle the stage is not ticked. */
+    Stats::Scalar *skippedCycleStat[Impl::MaxThreads];
+
     /** Structures whose free entries impact the amount of instructions that
      * can be renamed.
      */
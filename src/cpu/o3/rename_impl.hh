@@ -383,6 +383,37 @@ DefaultRename<Impl>::squash(const InstSeqNum &squash_seq_num, ThreadID tid)
     doSquash(squash_seq_num, tid);
 }
 
+template <class Impl>
+bool
+DefaultRename<Impl>::canSkipCycles()
+{
+    for (auto tid : *activeThreads) {
+        if (!insts[tid].empty())
+            return false;
+
+        bool stall = checkStall(tid);
+
+        if (renameStatus[tid] == Blocked && stall) {
+            skippedCycleStat[tid] = &renameBlockCycles;
+        } else if ((renameStatus[tid] == Running ||
+                    renameStatus[tid] == Idle) && !stall) {
+            skippedCycleStat[tid] = &renameIdleCycles;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <class Impl>
+void
+DefaultRename<Impl>::skipCycles(Cycles cycles)
+{
+    for (auto tid : *activeThreads)
+        *skippedCycleStat[tid] += cycles;
+}
+
 template <class Impl>
 void
 DefaultRename<Impl>::tick()
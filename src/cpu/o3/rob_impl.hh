@@ -103,6 +103,11 @@ ROB<Impl>::ROB(O3CPU *_cpu, DerivO3CPUParams *params)
                     "Partitioned, Threshold}");
     }
 
+    // Any thread may fill the whole ROB under the dynamic policy
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        instList[tid].reserve(numEntries);
+    }
+
     resetState();
 }
 
@@ -269,7 +274,7 @@ ROB<Impl>::retireHead(ThreadID tid)
     head_inst->clearInROB();
     head_inst->setCommitted();
 
-    instList[tid].erase(head_it);
+    instList[tid].pop_front();
 
     //Update "Global" Head of ROB
     updateHead();
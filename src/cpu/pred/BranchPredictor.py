@@ -29,6 +29,42 @@
 
 from m5.SimObject import SimObject
 from m5.params import *
+from m5.proxy import *
+
+class IndirectPredictor(SimObject):
+    type = 'IndirectPredictor'
+    cxx_class = 'IndirectPredictor'
+    cxx_header = "cpu/pred/indirect.hh"
+    abstract = True
+
+    numThreads = Param.Unsigned(Parent.numThreads, "Number of threads")
+    instShiftAmt = Param.Unsigned(Parent.instShiftAmt,
+        "Number of bits to shift instructions by")
+
+class SimpleIndirectPredictor(IndirectPredictor):
+    type = 'SimpleIndirectPredictor'
+    cxx_class = 'SimpleIndirectPredictor'
+    cxx_header = "cpu/pred/indirect.hh"
+
+    indirectHashGHR = Param.Bool(True, "Hash branch predictor GHR")
+    indirectHashTargets = Param.Bool(True, "Hash path history targets")
+    indirectSets = Param.Unsigned(256, "Cache sets for indirect predictor")
+    indirectWays = Param.Unsigned(2, "Ways for indirect predictor")
+    indirectTagSize = Param.Unsigned(16, "Indirect target cache tag bits")
+    indirectPathLength = Param.Unsigned(3,
+        "Previous indirect targets to use for path history")
+
+class ITTAGE(IndirectPredictor):
+    type = 'ITTAGE'
+    cxx_class = 'ITTAGE'
+    cxx_header = "cpu/pred/ittage.hh"
+
+    numTables = Param.Unsigned(6, "Number of tagged tables")
+    logTableSize = Param.Unsigned(9, "Log size of each tagged table")
+    logBaseSize = Param.Unsigned(10, "Log size of the base table")
+    tagBits = Param.Unsigned(11, "Tag bits")
+    maxPathLength = Param.Unsigned(16,
+        "Previous indirect targets hashed by the longest table")
 
 class BranchPredictor(SimObject):
     type = 'BranchPredictor'
@@ -43,13 +79,9 @@ class BranchPredictor(SimObject):
     instShiftAmt = Param.Unsigned(2, "Number of bits to shift instructions by")
 
     useIndirect = Param.Bool(True, "Use indirect branch predictor")
-    indirectHashGHR = Param.Bool(True, "Hash branch predictor GHR")
-    indirectHashTargets = Param.Bool(True, "Hash path history targets")
-    indirectSets = Param.Unsigned(256, "Cache sets for indirect predictor")
-    indirectWays = Param.Unsigned(2, "Ways for indirect predictor")
-    indirectTagSize = Param.Unsigned(16, "Indirect target cache tag bits")
-    indirectPathLength = Param.Unsigned(3,
-        "Previous indirect targets to use for path history")
+    indirectBranchPred = Param.IndirectPredictor(SimpleIndirectPredictor(),
+        "Indirect branch predictor, set to NULL to disable indirect "
+        "predictions")
 
 
 
@@ -102,3 +134,39 @@ class LTAGE(BranchPredictor):
     maxHist = Param.Unsigned(640, "Maximum history size of LTAGE")
     minTagWidth = Param.Unsigned(7, "Minimum tag size in tag tables")
 
+class TAGE_SC_L(BranchPredictor):
+    type = 'TAGE_SC_L'
+    cxx_class = 'TAGE_SC_L'
+    cxx_header = "cpu/pred/tage_sc_l.hh"
+
+    logSizeBiMP = Param.Unsigned(14, "Log size of Bimodal predictor in bits")
+    logSizeTagTables = Param.Unsigned(10, "Log size of each tagged table")
+    logSizeLoopPred = Param.Unsigned(8, "Log size of the loop predictor")
+    nHistoryTables = Param.Unsigned(12, "Number of history tables")
+    tagTableCounterBits = Param.Unsigned(3, "Number of tag table counter bits")
+    tagTableUBits = Param.Unsigned(2, "Number of tag table useful bits")
+    histBufferSize = Param.Unsigned(65536,
+            "Size of the circular buffer holding the branch history")
+    minHist = Param.Unsigned(4, "Minimum history size of TAGE")
+    maxHist = Param.Unsigned(640, "Maximum history size of TAGE")
+    minTagWidth = Param.Unsigned(7, "Tag size of the shortest history table")
+    maxTagWidth = Param.Unsigned(15, "Tag size of the longest history table")
+    pathHistBits = Param.Unsigned(16, "Number of path history bits")
+    logUResetPeriod = Param.Unsigned(19,
+            "Log number of branches between agings of the useful bits")
+    logSizeSC = Param.Unsigned(10,
+            "Log size of each statistical corrector table")
+    scCounterBits = Param.Unsigned(6, "Statistical corrector counter bits")
+    scHistLengths = VectorParam.Unsigned([4, 8, 16, 32],
+            "History lengths of the statistical corrector tables")
+
+class HashedPerceptronBP(BranchPredictor):
+    type = 'HashedPerceptronBP'
+    cxx_class = 'HashedPerceptronBP'
+    cxx_header = "cpu/pred/hashed_perceptron.hh"
+
+    numTables = Param.Unsigned(8, "Number of weight tables")
+    logTableSize = Param.Unsigned(10, "Log size of each weight table")
+    weightBits = Param.Unsigned(8, "Bits of each weight")
+    maxHist = Param.Unsigned(128,
+            "Global history length hashed by the last weight table")
@@ -51,6 +51,7 @@
 #include "arch/utility.hh"
 #include "base/trace.hh"
 #include "config/the_isa.hh"
+#include "cpu/base.hh"
 #include "debug/Branch.hh"
 
 BPredUnit::BPredUnit(const Params *params)
@@ -62,21 +63,42 @@ BPredUnit::BPredUnit(const Params *params)
           params->instShiftAmt,
           params->numThreads),
       RAS(numThreads),
-      useIndirect(params->useIndirect),
-      iPred(params->indirectHashGHR,
-            params->indirectHashTargets,
-            params->indirectSets,
-            params->indirectWays,
-            params->indirectTagSize,
-            params->indirectPathLength,
-            params->instShiftAmt,
-            params->numThreads),
+      useIndirect(params->useIndirect && params->indirectBranchPred),
+      iPred(params->indirectBranchPred),
+      cpu(NULL),
+      instsAtReset(0),
       instShiftAmt(params->instShiftAmt)
 {
     for (auto& r : RAS)
         r.init(params->RASSize);
 }
 
+BPredUnit::BranchType
+BPredUnit::getBranchType(const StaticInstPtr &inst)
+{
+    if (inst->isReturn())
+        return Return;
+    if (inst->isCall())
+        return inst->isDirectCtrl() ? DirectCall : IndirectCall;
+    if (inst->isDirectCtrl())
+        return inst->isCondCtrl() ? DirectCond : DirectUncond;
+    return inst->isCondCtrl() ? IndirectCond : IndirectUncond;
+}
+
+Counter
+BPredUnit::committedInsts() const
+{
+    return cpu ? cpu->totalInsts() - instsAtReset : 0;
+}
+
+void
+BPredUnit::resetStats()
+{
+    SimObject::resetStats();
+
+    instsAtReset = cpu ? cpu->totalInsts() : 0;
+}
+
 void
 BPredUnit::regStats()
 {
@@ -149,6 +171,45 @@ BPredUnit::regStats()
         .desc("Number of mispredicted indirect branches.")
         ;
 
+    static const char *typeNames[NumBranchTypes] = {
+        "DirectCond", "DirectUncond", "DirectCall", "IndirectCond",
+        "IndirectUncond", "IndirectCall", "Return"
+    };
+
+    lookupsByType
+        .init(NumBranchTypes)
+        .name(name() + ".lookupsByType")
+        .desc("Number of BP lookups by kind of branch")
+        .flags(Stats::total)
+        ;
+
+    mispredictsByType
+        .init(NumBranchTypes)
+        .name(name() + ".mispredictsByType")
+        .desc("Number of mispredictions by kind of branch")
+        .flags(Stats::total)
+        ;
+
+    committedInstsStat
+        .method(this, &BPredUnit::committedInsts)
+        .name(name() + ".committedInsts")
+        .desc("Number of instructions committed by the CPU")
+        ;
+
+    mpki
+        .name(name() + ".mpki")
+        .desc("Mispredictions per thousand committed instructions by "
+              "kind of branch")
+        .flags(Stats::total)
+        .precision(6)
+        ;
+    mpki = mispredictsByType * 1000 / committedInstsStat;
+
+    for (int i = 0; i < NumBranchTypes; ++i) {
+        lookupsByType.subname(i, typeNames[i]);
+        mispredictsByType.subname(i, typeNames[i]);
+        mpki.subname(i, typeNames[i]);
+    }
 }
 
 ProbePoints::PMUUPtr
@@ -191,6 +252,9 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
     ++lookups;
     ppBranches->notify(1);
 
+    const BranchType type = getBranchType(inst);
+    ++lookupsByType[type];
+
     void *bp_history = NULL;
 
     if (inst->isUncondCtrl()) {
@@ -211,6 +275,7 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
 
     PredictorHistory predict_record(seqNum, pc.instAddr(),
                                     pred_taken, bp_history, tid);
+    predict_record.type = type;
 
     // Now lookup in the BTB or RAS.
     if (pred_taken) {
@@ -280,7 +345,7 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
                 predict_record.wasIndirect = true;
                 ++indirectLookups;
                 //Consult indirect predictor on indirect control
-                if (iPred.lookup(pc.instAddr(), getGHR(tid, bp_history),
+                if (iPred->lookup(pc.instAddr(), getGHR(tid, bp_history),
                         target, tid)) {
                     // Indirect predictor hit
                     ++indirectHits;
@@ -299,8 +364,8 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
                     }
                     TheISA::advancePC(target, inst);
                 }
-                iPred.recordIndirect(pc.instAddr(), target.instAddr(), seqNum,
-                        tid);
+                iPred->recordIndirect(pc.instAddr(), target.instAddr(),
+                                      seqNum, tid);
             }
         }
     } else {
@@ -326,7 +391,8 @@ BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
     DPRINTF(Branch, "[tid:%i]: Committing branches until "
             "[sn:%lli].\n", tid, done_sn);
 
-    iPred.commit(done_sn, tid);
+    if (useIndirect)
+        iPred->commit(done_sn, tid);
     while (!predHist[tid].empty() &&
            predHist[tid].back().seqNum <= done_sn) {
         // Update the branch predictor with the correct results.
@@ -343,7 +409,8 @@ BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
 {
     History &pred_hist = predHist[tid];
 
-    iPred.squash(squashed_sn, tid);
+    if (useIndirect)
+        iPred->squash(squashed_sn, tid);
     while (!pred_hist.empty() &&
            pred_hist.front().seqNum > squashed_sn) {
         if (pred_hist.front().usedRAS) {
@@ -420,6 +487,8 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
         }
 
 
+        ++mispredictsByType[hist_it->type];
+
         if ((*hist_it).usedRAS) {
             ++RASIncorrect;
             DPRINTF(Branch, "[tid:%i]: Incorrect RAS [sn:%i]\n",
@@ -454,7 +523,7 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
             }
             if (hist_it->wasIndirect) {
                 ++indirectMispredicted;
-                iPred.recordTarget(hist_it->seqNum, ghr, corrTarget, tid);
+                iPred->recordTarget(hist_it->seqNum, ghr, corrTarget, tid);
             } else {
                 DPRINTF(Branch,"[tid: %i] BTB Update called for [sn:%i]"
                         " PC: %s\n", tid,hist_it->seqNum, hist_it->pc);
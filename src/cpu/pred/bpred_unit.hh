@@ -60,6 +60,8 @@
 #include "sim/probe/pmu.hh"
 #include "sim/sim_object.hh"
 
+class BaseCPU;
+
 /**
  * Basically a wrapper class to hold both the branch predictor
  * and the BTB.
@@ -73,11 +75,34 @@ class BPredUnit : public SimObject
      */
     BPredUnit(const Params *p);
 
+    /** Kinds of branches the lookups and mispredictions are counted by. */
+    enum BranchType {
+        DirectCond,
+        DirectUncond,
+        DirectCall,
+        IndirectCond,
+        IndirectUncond,
+        IndirectCall,
+        Return,
+        NumBranchTypes
+    };
+
+    /** Classify a control instruction. */
+    static BranchType getBranchType(const StaticInstPtr &inst);
+
+    /**
+     * Set the CPU whose committed instructions the misprediction rates
+     * are reported against.
+     */
+    void setCPU(BaseCPU *_cpu) { cpu = _cpu; }
+
     /**
      * Registers statistics.
      */
     void regStats() override;
 
+    void resetStats() override;
+
     void regProbePoints() override;
 
     /** Perform sanity checks after a drain. */
@@ -154,18 +179,23 @@ class BPredUnit : public SimObject
     /**
      * Looks up a given PC in the BTB to see if a matching entry exists.
      * @param inst_PC The PC to look up.
+     * @param tid The thread id.
      * @return Whether the BTB contains the given PC.
      */
-    bool BTBValid(Addr instPC)
-    { return BTB.valid(instPC, 0); }
+    bool BTBValid(Addr instPC, ThreadID tid = 0)
+    { return BTB.valid(instPC, tid); }
 
     /**
      * Looks up a given PC in the BTB to get the predicted target.
      * @param inst_PC The PC to look up.
+     * @param tid The thread id.
      * @return The address of the target of the branch.
      */
-    TheISA::PCState BTBLookup(Addr instPC)
-    { return BTB.lookup(instPC, 0); }
+    TheISA::PCState BTBLookup(Addr instPC, ThreadID tid = 0)
+    { return BTB.lookup(instPC, tid); }
+
+    /** Number of bits instruction addresses are shifted by. */
+    unsigned getInstShiftAmt() const { return instShiftAmt; }
 
     /**
      * Updates the BP with taken/not taken information.
@@ -203,7 +233,8 @@ class BPredUnit : public SimObject
                          ThreadID _tid)
             : seqNum(seq_num), pc(instPC), bpHistory(bp_history), RASTarget(0),
               RASIndex(0), tid(_tid), predTaken(pred_taken), usedRAS(0), pushedRAS(0),
-              wasCall(0), wasReturn(0), wasIndirect(0)
+              wasCall(0), wasReturn(0), wasIndirect(0),
+              type(DirectCond)
         {}
 
         bool operator==(const PredictorHistory &entry) const {
@@ -248,6 +279,9 @@ class BPredUnit : public SimObject
 
         /** Wether this instruction was an indirect branch */
         bool wasIndirect;
+
+        /** The kind of branch, for the statistics. */
+        BranchType type;
     };
 
     typedef std::deque<PredictorHistory> History;
@@ -273,7 +307,16 @@ class BPredUnit : public SimObject
     const bool useIndirect;
 
     /** The indirect target predictor. */
-    IndirectPredictor iPred;
+    IndirectPredictor *iPred;
+
+    /** The CPU the predictor belongs to, if it was told. */
+    BaseCPU *cpu;
+
+    /** Instructions the CPU had committed when the stats were reset. */
+    Counter instsAtReset;
+
+    /** Instructions committed by the CPU since the stats were reset. */
+    Counter committedInsts() const;
 
     /** Stat for number of BP lookups. */
     Stats::Scalar lookups;
@@ -303,6 +346,15 @@ class BPredUnit : public SimObject
     /** Stat for the number of indirect target mispredictions.*/
     Stats::Scalar indirectMispredicted;
 
+    /** Stat for the number of lookups of each kind of branch. */
+    Stats::Vector lookupsByType;
+    /** Stat for the number of mispredictions of each kind of branch. */
+    Stats::Vector mispredictsByType;
+    /** Stat for the number of instructions committed by the CPU. */
+    Stats::Value committedInstsStat;
+    /** Stat for the mispredictions per thousand committed instructions. */
+    Stats::Formula mpki;
+
   protected:
     /** Number of bits to shift instructions by for predictor addresses. */
     const unsigned instShiftAmt;
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/hashed_perceptron.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "base/misc.hh"
+
+HashedPerceptronBP::HashedPerceptronBP(
+        const HashedPerceptronBPParams *params)
+    : BPredUnit(params),
+      numTables(params->numTables),
+      logTableSize(params->logTableSize),
+      maxWeight((1 << (params->weightBits - 1)) - 1),
+      minWeight(-(1 << (params->weightBits - 1))),
+      histLengths(params->numTables, 0),
+      weights(params->numTables << params->logTableSize, 0),
+      globalHistory(params->numThreads,
+                    std::vector<uint64_t>((params->maxHist + 63) / 64, 0)),
+      theta(int(1.93 * params->numTables + 14)),
+      thetaCounter(0)
+{
+    fatal_if(numTables < 2,
+             "The hashed perceptron needs at least two weight tables");
+    fatal_if(logTableSize == 0 || logTableSize >= 32,
+             "Invalid hashed perceptron table size");
+    fatal_if(params->weightBits < 2 || params->weightBits > 8,
+             "Hashed perceptron weights must be 2 to 8 bits wide");
+    fatal_if(params->maxHist == 0,
+             "The hashed perceptron needs some global history");
+
+    // The first table only sees the address, the others geometric history
+    // lengths from 2 bits up to the maximum
+    for (unsigned i = 1; i < numTables; ++i) {
+        double frac = numTables > 2 ?
+            double(i - 1) / (numTables - 2) : 1.0;
+        unsigned len =
+            unsigned(2 * std::pow(params->maxHist / 2.0, frac) + 0.5);
+        histLengths[i] = std::max(1u, std::min(len, params->maxHist));
+    }
+}
+
+void
+HashedPerceptronBP::updateGlobalHist(std::vector<uint64_t> &hist, bool taken)
+{
+    for (size_t w = hist.size() - 1; w > 0; --w)
+        hist[w] = (hist[w] << 1) | (hist[w - 1] >> 63);
+    hist[0] = (hist[0] << 1) | taken;
+}
+
+void
+HashedPerceptronBP::computeIndices(Addr branch_addr, BPHistory *history)
+{
+    const Addr pc = branch_addr >> instShiftAmt;
+    const uint64_t mask = (ULL(1) << logTableSize) - 1;
+
+    history->indices.resize(numTables);
+    history->sum = 0;
+
+    for (unsigned i = 0; i < numTables; ++i) {
+        // Fold the history slice of the table down to the index width
+        uint64_t h = 0;
+        unsigned len = histLengths[i];
+        for (unsigned w = 0; len > 0; ++w) {
+            uint64_t bits = history->globalHistory[w];
+            if (len < 64)
+                bits &= (ULL(1) << len) - 1;
+            len -= std::min(len, 64u);
+
+            h = ((h << 1) | (h >> (logTableSize - 1))) & mask;
+            for (; bits; bits >>= logTableSize)
+                h ^= bits & mask;
+        }
+
+        const unsigned idx = (pc ^ (pc >> (i + 1)) ^ h) & mask;
+        history->indices[i] = idx;
+        history->sum += weights[(i << logTableSize) + idx];
+    }
+}
+
+void
+HashedPerceptronBP::uncondBranch(ThreadID tid, Addr pc, void * &bp_history)
+{
+    BPHistory *history = new BPHistory;
+    history->globalHistory = globalHistory[tid];
+    history->sum = 0;
+    bp_history = static_cast<void*>(history);
+    updateGlobalHist(globalHistory[tid], true);
+}
+
+void
+HashedPerceptronBP::squash(ThreadID tid, void *bp_history)
+{
+    BPHistory *history = static_cast<BPHistory*>(bp_history);
+    globalHistory[tid] = history->globalHistory;
+
+    delete history;
+}
+
+bool
+HashedPerceptronBP::lookup(ThreadID tid, Addr branch_addr,
+                           void * &bp_history)
+{
+    BPHistory *history = new BPHistory;
+    history->globalHistory = globalHistory[tid];
+    computeIndices(branch_addr, history);
+
+    const bool taken = history->sum >= 0;
+    bp_history = static_cast<void*>(history);
+    updateGlobalHist(globalHistory[tid], taken);
+
+    return taken;
+}
+
+void
+HashedPerceptronBP::btbUpdate(ThreadID tid, Addr branch_addr,
+                              void * &bp_history)
+{
+    globalHistory[tid][0] &= ~ULL(1);
+}
+
+void
+HashedPerceptronBP::update(ThreadID tid, Addr branch_addr, bool taken,
+                           void *bp_history, bool squashed)
+{
+    assert(bp_history);
+
+    BPHistory *history = static_cast<BPHistory*>(bp_history);
+
+    // The weights are only trained at commit, a squash just repairs the
+    // global history
+    if (squashed) {
+        globalHistory[tid] = history->globalHistory;
+        updateGlobalHist(globalHistory[tid], taken);
+        return;
+    }
+
+    if (!history->indices.empty()) {
+        const bool correct = (history->sum >= 0) == taken;
+
+        if (!correct || std::abs(history->sum) <= theta) {
+            for (unsigned i = 0; i < numTables; ++i) {
+                int8_t &w = weights[(i << logTableSize) +
+                                    history->indices[i]];
+                if (taken) {
+                    if (w < maxWeight)
+                        ++w;
+                } else if (w > minWeight) {
+                    --w;
+                }
+            }
+        }
+
+        // Adjust the threshold so that there are about as many updates
+        // on mispredictions as on correct low confidence predictions
+        if (!correct) {
+            if (++thetaCounter >= 63) {
+                ++theta;
+                thetaCounter = 0;
+            }
+        } else if (std::abs(history->sum) <= theta) {
+            if (--thetaCounter <= -64) {
+                if (theta > 0)
+                    --theta;
+                thetaCounter = 0;
+            }
+        }
+    }
+
+    delete history;
+}
+
+unsigned
+HashedPerceptronBP::getGHR(ThreadID tid, void *bp_history) const
+{
+    return static_cast<BPHistory*>(bp_history)->globalHistory[0];
+}
+
+HashedPerceptronBP*
+HashedPerceptronBPParams::create()
+{
+    return new HashedPerceptronBP(this);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Implementation of a hashed perceptron branch predictor
+ */
+
+#ifndef __CPU_PRED_HASHED_PERCEPTRON_HH__
+#define __CPU_PRED_HASHED_PERCEPTRON_HH__
+
+#include <vector>
+
+#include "cpu/pred/bpred_unit.hh"
+#include "params/HashedPerceptronBP.hh"
+
+/**
+ * Implements a hashed perceptron branch predictor. Each table holds small
+ * signed weights. The first table is indexed by the branch address only,
+ * the others by the address hashed with geometrically longer slices of
+ * the global history. The prediction is the sign of the sum of the
+ * selected weights, and the weights are trained when the prediction is
+ * wrong or the sum is below an adaptive threshold.
+ */
+class HashedPerceptronBP : public BPredUnit
+{
+  public:
+    HashedPerceptronBP(const HashedPerceptronBPParams *params);
+    void uncondBranch(ThreadID tid, Addr pc, void * &bp_history) override;
+    void squash(ThreadID tid, void *bp_history) override;
+    bool lookup(ThreadID tid, Addr branch_addr, void * &bp_history) override;
+    void btbUpdate(ThreadID tid, Addr branch_addr,
+                   void * &bp_history) override;
+    void update(ThreadID tid, Addr branch_addr, bool taken, void *bp_history,
+                bool squashed) override;
+    unsigned getGHR(ThreadID tid, void *bp_history) const override;
+
+  private:
+    struct BPHistory {
+        /** Global history before the branch was shifted in */
+        std::vector<uint64_t> globalHistory;
+        /** Weight indices of a conditional branch, empty otherwise */
+        std::vector<unsigned> indices;
+        int sum;
+    };
+
+    /** Shift an outcome into a global history. */
+    void updateGlobalHist(std::vector<uint64_t> &hist, bool taken);
+
+    /** Compute the weight indices of a branch and their sum. */
+    void computeIndices(Addr branch_addr, BPHistory *history);
+
+    const unsigned numTables;
+    const unsigned logTableSize;
+    const int maxWeight;
+    const int minWeight;
+
+    /** History bits hashed by each table */
+    std::vector<unsigned> histLengths;
+
+    /** The weight tables, packed one after the other */
+    std::vector<int8_t> weights;
+
+    /** Per-thread global history, most recent outcome in bit 0 */
+    std::vector<std::vector<uint64_t>> globalHistory;
+
+    /** Adaptive training threshold and the counter that adjusts it */
+    int theta;
+    int thetaCounter;
+};
+
+#endif // __CPU_PRED_HASHED_PERCEPTRON_HH__
@@ -33,19 +33,22 @@
 #include "base/intmath.hh"
 #include "debug/Indirect.hh"
 
-IndirectPredictor::IndirectPredictor(bool hash_ghr, bool hash_targets,
-    unsigned num_sets, unsigned num_ways,
-    unsigned tag_bits, unsigned path_len, unsigned inst_shift,
-    unsigned num_threads)
-    : hashGHR(hash_ghr), hashTargets(hash_targets),
-      numSets(num_sets), numWays(num_ways), tagBits(tag_bits),
-      pathLength(path_len), instShift(inst_shift)
+SimpleIndirectPredictor::SimpleIndirectPredictor(
+    const SimpleIndirectPredictorParams *params)
+    : IndirectPredictor(params),
+      hashGHR(params->indirectHashGHR),
+      hashTargets(params->indirectHashTargets),
+      numSets(params->indirectSets),
+      numWays(params->indirectWays),
+      tagBits(params->indirectTagSize),
+      pathLength(params->indirectPathLength),
+      instShift(params->instShiftAmt)
 {
     if (!isPowerOf2(numSets)) {
       panic("Indirect predictor requires power of 2 number of sets");
     }
 
-    threadInfo.resize(num_threads);
+    threadInfo.resize(params->numThreads);
 
     targetCache.resize(numSets);
     for (unsigned i = 0; i < numSets; i++) {
@@ -54,8 +57,8 @@ IndirectPredictor::IndirectPredictor(bool hash_ghr, bool hash_targets,
 }
 
 bool
-IndirectPredictor::lookup(Addr br_addr, unsigned ghr, TheISA::PCState& target,
-    ThreadID tid)
+SimpleIndirectPredictor::lookup(Addr br_addr, unsigned ghr,
+    TheISA::PCState& target, ThreadID tid)
 {
     Addr set_index = getSetIndex(br_addr, ghr, tid);
     Addr tag = getTag(br_addr);
@@ -76,7 +79,7 @@ IndirectPredictor::lookup(Addr br_addr, unsigned ghr, TheISA::PCState& target,
 }
 
 void
-IndirectPredictor::recordIndirect(Addr br_addr, Addr tgt_addr,
+SimpleIndirectPredictor::recordIndirect(Addr br_addr, Addr tgt_addr,
     InstSeqNum seq_num, ThreadID tid)
 {
     DPRINTF(Indirect, "Recording %x seq:%d\n", br_addr, seq_num);
@@ -85,7 +88,7 @@ IndirectPredictor::recordIndirect(Addr br_addr, Addr tgt_addr,
 }
 
 void
-IndirectPredictor::commit(InstSeqNum seq_num, ThreadID tid)
+SimpleIndirectPredictor::commit(InstSeqNum seq_num, ThreadID tid)
 {
     DPRINTF(Indirect, "Committing seq:%d\n", seq_num);
     ThreadInfo &t_info = threadInfo[tid];
@@ -103,7 +106,7 @@ IndirectPredictor::commit(InstSeqNum seq_num, ThreadID tid)
 }
 
 void
-IndirectPredictor::squash(InstSeqNum seq_num, ThreadID tid)
+SimpleIndirectPredictor::squash(InstSeqNum seq_num, ThreadID tid)
 {
     DPRINTF(Indirect, "Squashing seq:%d\n", seq_num);
     ThreadInfo &t_info = threadInfo[tid];
@@ -123,7 +126,7 @@ IndirectPredictor::squash(InstSeqNum seq_num, ThreadID tid)
 
 
 void
-IndirectPredictor::recordTarget(InstSeqNum seq_num, unsigned ghr,
+SimpleIndirectPredictor::recordTarget(InstSeqNum seq_num, unsigned ghr,
         const TheISA::PCState& target, ThreadID tid)
 {
     ThreadInfo &t_info = threadInfo[tid];
@@ -159,7 +162,8 @@ IndirectPredictor::recordTarget(InstSeqNum seq_num, unsigned ghr,
 
 
 inline Addr
-IndirectPredictor::getSetIndex(Addr br_addr, unsigned ghr, ThreadID tid)
+SimpleIndirectPredictor::getSetIndex(Addr br_addr, unsigned ghr,
+                                     ThreadID tid)
 {
     ThreadInfo &t_info = threadInfo[tid];
 
@@ -179,7 +183,13 @@ IndirectPredictor::getSetIndex(Addr br_addr, unsigned ghr, ThreadID tid)
 }
 
 inline Addr
-IndirectPredictor::getTag(Addr br_addr)
+SimpleIndirectPredictor::getTag(Addr br_addr)
 {
     return (br_addr >> instShift) & ((0x1<<tagBits)-1);
 }
+
+SimpleIndirectPredictor *
+SimpleIndirectPredictorParams::create()
+{
+    return new SimpleIndirectPredictor(this);
+}
@@ -36,22 +36,64 @@
 #include "arch/isa_traits.hh"
 #include "config/the_isa.hh"
 #include "cpu/inst_seq.hh"
+#include "params/IndirectPredictor.hh"
+#include "params/SimpleIndirectPredictor.hh"
+#include "sim/sim_object.hh"
 
-class IndirectPredictor
+/**
+ * Interface of the predictors of the targets of indirect branches.
+ */
+class IndirectPredictor : public SimObject
 {
   public:
-    IndirectPredictor(bool hash_ghr, bool hash_targets,
-                      unsigned num_sets, unsigned num_ways,
-                      unsigned tag_bits, unsigned path_len,
-                      unsigned inst_shift, unsigned num_threads);
+    typedef IndirectPredictorParams Params;
+
+    IndirectPredictor(const Params *params) : SimObject(params) { }
+
+    /**
+     * Predicts the target of an indirect branch.
+     * @return Whether a target was found.
+     */
+    virtual bool lookup(Addr br_addr, unsigned ghr,
+                        TheISA::PCState& br_target, ThreadID tid) = 0;
+
+    /** Records a predicted indirect branch and the target it goes to. */
+    virtual void recordIndirect(Addr br_addr, Addr tgt_addr,
+                                InstSeqNum seq_num, ThreadID tid) = 0;
+
+    /** Commits the indirect branches up to a sequence number. */
+    virtual void commit(InstSeqNum seq_num, ThreadID tid) = 0;
+
+    /** Squashes the indirect branches younger than a sequence number. */
+    virtual void squash(InstSeqNum seq_num, ThreadID tid) = 0;
+
+    /**
+     * Corrects the target of the youngest indirect branch, which was
+     * mispredicted.
+     */
+    virtual void recordTarget(InstSeqNum seq_num, unsigned ghr,
+                              const TheISA::PCState& target,
+                              ThreadID tid) = 0;
+};
+
+/**
+ * A set associative cache of targets indexed with the branch address,
+ * optionally hashed with the global history and the path of the previous
+ * indirect branches.
+ */
+class SimpleIndirectPredictor : public IndirectPredictor
+{
+  public:
+    SimpleIndirectPredictor(const SimpleIndirectPredictorParams *params);
+
     bool lookup(Addr br_addr, unsigned ghr, TheISA::PCState& br_target,
-                ThreadID tid);
+                ThreadID tid) override;
     void recordIndirect(Addr br_addr, Addr tgt_addr, InstSeqNum seq_num,
-                        ThreadID tid);
-    void commit(InstSeqNum seq_num, ThreadID tid);
-    void squash(InstSeqNum seq_num, ThreadID tid);
+                        ThreadID tid) override;
+    void commit(InstSeqNum seq_num, ThreadID tid) override;
+    void squash(InstSeqNum seq_num, ThreadID tid) override;
     void recordTarget(InstSeqNum seq_num, unsigned ghr,
-                      const TheISA::PCState& target, ThreadID tid);
+                      const TheISA::PCState& target, ThreadID tid) override;
 
   private:
     const bool hashGHR;
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/ittage.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/misc.hh"
+#include "base/random.hh"
+#include "base/trace.hh"
+#include "debug/Indirect.hh"
+
+// Updates between two halvings of the useful counters
+static const uint64_t usefulAgingPeriod = 1 << 18;
+
+ITTAGE::ITTAGE(const ITTAGEParams *params)
+    : IndirectPredictor(params),
+      numTables(params->numTables), logTableSize(params->logTableSize),
+      logBaseSize(params->logBaseSize), tagBits(params->tagBits),
+      maxPathLength(params->maxPathLength),
+      instShift(params->instShiftAmt),
+      maxConf(3), maxUseful(3),
+      ghrBits(numTables + 1, 0), pathLengths(numTables + 1, 0),
+      entries(numTables << logTableSize),
+      targets(numTables << logTableSize),
+      baseTargets(1 << logBaseSize),
+      baseValid(1 << logBaseSize, false),
+      baseConf(1 << logBaseSize, false),
+      threadInfo(params->numThreads), updates(0)
+{
+    fatal_if(numTables == 0, "ITTAGE needs at least one tagged table");
+    fatal_if(tagBits == 0 || tagBits > 16,
+             "ITTAGE tags must be 1 to 16 bits wide");
+    fatal_if(logTableSize == 0 || logTableSize >= 32 || logBaseSize >= 32,
+             "Invalid ITTAGE table size");
+
+    // Geometric global history lengths from 2 bits up to the 32 bits of
+    // the GHR, and path lengths from 1 target up to the maximum
+    for (unsigned bank = 1; bank <= numTables; ++bank) {
+        double frac = numTables > 1 ?
+            double(bank - 1) / (numTables - 1) : 1.0;
+        ghrBits[bank] =
+            std::min(32u, unsigned(2 * std::pow(16.0, frac) + 0.5));
+        pathLengths[bank] = std::max(1u,
+            unsigned(std::pow(double(maxPathLength), frac) + 0.5));
+    }
+
+    for (auto &t : threadInfo) {
+        t.pending.indices.resize(numTables + 1);
+        t.pending.tags.resize(numTables + 1);
+    }
+}
+
+uint32_t
+ITTAGE::historyHash(const ThreadInfo &t, unsigned ghr, unsigned bank) const
+{
+    uint32_t h = ghrBits[bank] >= 32 ? ghr :
+        ghr & ((1u << ghrBits[bank]) - 1);
+
+    const unsigned n = t.pathHist.size();
+    const unsigned len = std::min(pathLengths[bank], n);
+    for (unsigned k = 0; k < len; ++k) {
+        Addr tgt = t.pathHist[n - 1 - k].targetAddr >> instShift;
+        h = ((h << 5) | (h >> 27)) ^ uint32_t(tgt) ^ uint32_t(tgt >> 16);
+    }
+    return h;
+}
+
+bool
+ITTAGE::lookup(Addr br_addr, unsigned ghr, TheISA::PCState& br_target,
+               ThreadID tid)
+{
+    ThreadInfo &t = threadInfo[tid];
+    HistoryEntry &e = t.pending;
+
+    e.pcAddr = br_addr;
+    e.mispredicted = false;
+
+    const Addr pc = br_addr >> instShift;
+    const unsigned table_mask = (1u << logTableSize) - 1;
+    const unsigned tag_mask = (1u << tagBits) - 1;
+
+    e.indices[0] = pc & ((1u << logBaseSize) - 1);
+    for (unsigned bank = 1; bank <= numTables; ++bank) {
+        const uint32_t h = historyHash(t, ghr, bank);
+
+        uint32_t idx = pc ^ (pc >> logTableSize) ^ (bank << 1);
+        for (unsigned s = 0; s < 32; s += logTableSize)
+            idx ^= h >> s;
+        e.indices[bank] = idx & table_mask;
+        e.tags[bank] = (pc ^ (pc >> tagBits) ^
+                        ((h * 0x9e3779b1) >> (32 - tagBits))) & tag_mask;
+    }
+
+    // The longest matching table provides, the next one is the alternate
+    int provider = -1;
+    int alt = -1;
+    for (int bank = numTables; bank >= 1 && alt < 0; --bank) {
+        const Entry &ent = entries[entryIdx(bank, e.indices[bank])];
+        if (ent.valid && ent.tag == e.tags[bank]) {
+            if (provider < 0)
+                provider = bank;
+            else
+                alt = bank;
+        }
+    }
+    if (baseValid[e.indices[0]]) {
+        if (provider < 0)
+            provider = 0;
+        else if (alt < 0)
+            alt = 0;
+    }
+
+    e.provider = provider;
+    e.altProvider = alt;
+    e.used = provider;
+
+    // A newly allocated entry is not trusted over the alternate
+    if (provider > 0 && alt >= 0 &&
+        entries[entryIdx(provider, e.indices[provider])].conf == 0) {
+        e.used = alt;
+    }
+
+    if (e.used < 0) {
+        DPRINTF(Indirect, "ITTAGE miss (br:%x)\n", br_addr);
+        return false;
+    }
+
+    br_target = e.used == 0 ? baseTargets[e.indices[0]] :
+        targets[entryIdx(e.used, e.indices[e.used])];
+
+    DPRINTF(Indirect, "ITTAGE hit (br:%x table:%d target:%s)\n",
+            br_addr, e.used, br_target);
+    return true;
+}
+
+void
+ITTAGE::recordIndirect(Addr br_addr, Addr tgt_addr, InstSeqNum seq_num,
+                       ThreadID tid)
+{
+    ThreadInfo &t = threadInfo[tid];
+
+    assert(t.pending.pcAddr == br_addr);
+    t.pending.targetAddr = tgt_addr;
+    t.pending.seqNum = seq_num;
+    t.pathHist.push_back(t.pending);
+}
+
+void
+ITTAGE::commit(InstSeqNum seq_num, ThreadID tid)
+{
+    ThreadInfo &t = threadInfo[tid];
+
+    while (t.numCommitted < t.pathHist.size() &&
+           t.pathHist[t.numCommitted].seqNum <= seq_num) {
+        updateTables(t.pathHist[t.numCommitted]);
+        ++t.numCommitted;
+    }
+
+    // Keep the committed targets the longest path still hashes
+    while (t.numCommitted > maxPathLength) {
+        t.pathHist.pop_front();
+        --t.numCommitted;
+    }
+}
+
+void
+ITTAGE::squash(InstSeqNum seq_num, ThreadID tid)
+{
+    ThreadInfo &t = threadInfo[tid];
+
+    while (t.pathHist.size() > t.numCommitted &&
+           t.pathHist.back().seqNum > seq_num) {
+        t.pathHist.pop_back();
+    }
+}
+
+void
+ITTAGE::recordTarget(InstSeqNum seq_num, unsigned ghr,
+                     const TheISA::PCState& target, ThreadID tid)
+{
+    ThreadInfo &t = threadInfo[tid];
+
+    // Should have just squashed so this branch should be the youngest
+    assert(t.pathHist.size() > t.numCommitted);
+    HistoryEntry &e = t.pathHist.back();
+    assert(e.seqNum == seq_num);
+
+    DPRINTF(Indirect, "ITTAGE target correction (seq: %d br:%x target:%s)\n",
+            seq_num, e.pcAddr, target);
+
+    // The tables are only trained when the branch commits
+    e.targetAddr = target.instAddr();
+    e.correctTarget = target;
+    e.mispredicted = true;
+}
+
+void
+ITTAGE::updateTables(const HistoryEntry &e)
+{
+    if (e.used < 0 && !e.mispredicted)
+        return;
+
+    // Entries may have been replaced since the lookup, so compare the
+    // targets they hold now
+    bool alt_correct = false;
+    if (e.altProvider == 0) {
+        alt_correct = baseTargets[e.indices[0]].instAddr() == e.targetAddr;
+    } else if (e.altProvider > 0) {
+        unsigned i = entryIdx(e.altProvider, e.indices[e.altProvider]);
+        alt_correct = entries[i].valid &&
+            entries[i].tag == e.tags[e.altProvider] &&
+            targets[i].instAddr() == e.targetAddr;
+    }
+
+    if (e.provider > 0) {
+        unsigned i = entryIdx(e.provider, e.indices[e.provider]);
+        Entry &p = entries[i];
+        if (p.valid && p.tag == e.tags[e.provider]) {
+            bool correct = targets[i].instAddr() == e.targetAddr;
+            if (correct) {
+                if (p.conf < maxConf)
+                    ++p.conf;
+                if (!alt_correct && p.useful < maxUseful)
+                    ++p.useful;
+            } else {
+                if (p.conf > 0)
+                    --p.conf;
+                else if (e.mispredicted)
+                    targets[i] = e.correctTarget;
+                if (alt_correct && p.useful > 0)
+                    --p.useful;
+            }
+        }
+    }
+
+    if (e.provider <= 0 || e.used == 0) {
+        const unsigned b = e.indices[0];
+        if (baseValid[b] && baseTargets[b].instAddr() == e.targetAddr) {
+            baseConf[b] = true;
+        } else if (e.mispredicted) {
+            if (baseValid[b] && baseConf[b]) {
+                baseConf[b] = false;
+            } else {
+                baseTargets[b] = e.correctTarget;
+                baseValid[b] = true;
+                baseConf[b] = false;
+            }
+        }
+    }
+
+    if (e.mispredicted && e.provider < int(numTables))
+        allocate(e);
+
+    if (++updates >= usefulAgingPeriod) {
+        updates = 0;
+        for (auto &ent : entries)
+            ent.useful >>= 1;
+    }
+}
+
+void
+ITTAGE::allocate(const HistoryEntry &e)
+{
+    unsigned start = std::max(e.provider, 0) + 1;
+
+    // Skip a table now and then so that the allocations spread over the
+    // longer histories
+    if (start < numTables && random_mt.random<int>(0, 1))
+        ++start;
+
+    for (unsigned bank = start; bank <= numTables; ++bank) {
+        unsigned i = entryIdx(bank, e.indices[bank]);
+        Entry &ent = entries[i];
+        if (ent.useful == 0) {
+            ent.tag = e.tags[bank];
+            ent.conf = 0;
+            ent.valid = true;
+            targets[i] = e.correctTarget;
+            return;
+        }
+    }
+
+    for (unsigned bank = start; bank <= numTables; ++bank) {
+        Entry &ent = entries[entryIdx(bank, e.indices[bank])];
+        if (ent.useful > 0)
+            --ent.useful;
+    }
+}
+
+ITTAGE *
+ITTAGEParams::create()
+{
+    return new ITTAGE(this);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_ITTAGE_HH__
+#define __CPU_PRED_ITTAGE_HH__
+
+#include <deque>
+#include <vector>
+
+#include "cpu/pred/indirect.hh"
+#include "params/ITTAGE.hh"
+
+/**
+ * An ITTAGE indirect target predictor. A tagless base table indexed by the
+ * branch address is backed by tagged tables whose indices and tags also
+ * hash geometrically longer global histories and paths of previous
+ * indirect targets. The table with the longest matching history provides
+ * the target. The tables are only trained when the branches commit, so
+ * the speculative state is just the path of in flight targets.
+ */
+class ITTAGE : public IndirectPredictor
+{
+  public:
+    ITTAGE(const ITTAGEParams *params);
+
+    bool lookup(Addr br_addr, unsigned ghr, TheISA::PCState& br_target,
+                ThreadID tid) override;
+    void recordIndirect(Addr br_addr, Addr tgt_addr, InstSeqNum seq_num,
+                        ThreadID tid) override;
+    void commit(InstSeqNum seq_num, ThreadID tid) override;
+    void squash(InstSeqNum seq_num, ThreadID tid) override;
+    void recordTarget(InstSeqNum seq_num, unsigned ghr,
+                      const TheISA::PCState& target, ThreadID tid) override;
+
+  private:
+    /** Tagged entry, its target is kept in a parallel vector */
+    struct Entry
+    {
+        Entry() : tag(0), conf(0), useful(0), valid(false) { }
+        uint16_t tag;
+        uint8_t conf;
+        uint8_t useful;
+        bool valid;
+    };
+
+    /** An indirect branch, from its lookup until it leaves the path */
+    struct HistoryEntry
+    {
+        HistoryEntry()
+            : pcAddr(0), targetAddr(0), seqNum(0), provider(-1),
+              altProvider(-1), used(-1), mispredicted(false),
+              correctTarget(0)
+        { }
+
+        Addr pcAddr;
+        Addr targetAddr;
+        InstSeqNum seqNum;
+
+        /**
+         * Tables that matched and the one that gave the prediction, 0 for
+         * the base table and -1 for none
+         */
+        int provider;
+        int altProvider;
+        int used;
+
+        bool mispredicted;
+        TheISA::PCState correctTarget;
+
+        /** Index in each table, and tag in each tagged table */
+        std::vector<unsigned> indices;
+        std::vector<unsigned> tags;
+    };
+
+    struct ThreadInfo
+    {
+        ThreadInfo() : numCommitted(0) { }
+
+        /** Indirect branches, oldest first, the committed ones first */
+        std::deque<HistoryEntry> pathHist;
+        unsigned numCommitted;
+        /** The last lookup, until it is recorded */
+        HistoryEntry pending;
+    };
+
+    /** Hash of the global and path histories a tagged table uses. */
+    uint32_t historyHash(const ThreadInfo &t, unsigned ghr,
+                         unsigned bank) const;
+
+    /** Position of an entry of a tagged table in the packed vectors. */
+    unsigned entryIdx(unsigned bank, unsigned idx) const
+    { return ((bank - 1) << logTableSize) + idx; }
+
+    /** Train the tables with a committed branch. */
+    void updateTables(const HistoryEntry &e);
+
+    /** Allocate entries in tables longer than a mispredicting one. */
+    void allocate(const HistoryEntry &e);
+
+    const unsigned numTables;
+    const unsigned logTableSize;
+    const unsigned logBaseSize;
+    const unsigned tagBits;
+    const unsigned maxPathLength;
+    const unsigned instShift;
+
+    const uint8_t maxConf;
+    const uint8_t maxUseful;
+
+    /** Global history bits and previous targets each table hashes */
+    std::vector<unsigned> ghrBits;
+    std::vector<unsigned> pathLengths;
+
+    /** Tagged tables, packed one after the other */
+    std::vector<Entry> entries;
+    std::vector<TheISA::PCState> targets;
+
+    /** Base table with a hysteresis bit per target */
+    std::vector<TheISA::PCState> baseTargets;
+    std::vector<bool> baseValid;
+    std::vector<bool> baseConf;
+
+    std::vector<ThreadInfo> threadInfo;
+
+    /** Updates since the useful counters were last aged */
+    uint64_t updates;
+};
+
+#endif // __CPU_PRED_ITTAGE_HH__
@@ -0,0 +1,750 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/tage_sc_l.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/misc.hh"
+#include "base/random.hh"
+#include "base/trace.hh"
+#include "debug/TageSCL.hh"
+
+TAGE_SC_L::TAGE_SC_L(const TAGE_SC_LParams *params)
+  : BPredUnit(params),
+    logSizeBiMP(params->logSizeBiMP),
+    logSizeTagTables(params->logSizeTagTables),
+    logSizeLoopPred(params->logSizeLoopPred),
+    nHistoryTables(params->nHistoryTables),
+    tagTableCounterBits(params->tagTableCounterBits),
+    tagTableUBits(params->tagTableUBits),
+    histBufferSize(params->histBufferSize),
+    minHist(params->minHist),
+    maxHist(params->maxHist),
+    pathHistBits(params->pathHistBits),
+    logUResetPeriod(params->logUResetPeriod),
+    logSizeSC(params->logSizeSC),
+    scCounterBits(params->scCounterBits),
+    scHistLengths(params->scHistLengths),
+    numSCTables(scHistLengths.size()),
+    numFolded(3 * nHistoryTables + numSCTables),
+    threadHistory(params->numThreads),
+    loopUseCounter(0),
+    useAltPredForNewlyAllocated(0),
+    tCounter(0),
+    scThreshold(35),
+    scThresholdCtr(0)
+{
+    fatal_if(nHistoryTables < 2 || nHistoryTables > 63,
+             "TAGE-SC-L needs between 2 and 63 tagged tables.\n");
+    fatal_if(histBufferSize <= maxHist * 2,
+             "The history buffer must hold more than twice maxHist.\n");
+    fatal_if(params->maxTagWidth > 16 || params->minTagWidth < 2 ||
+             params->minTagWidth > params->maxTagWidth,
+             "Tag widths must be between 2 and 16 bits.\n");
+    fatal_if(tagTableCounterBits > 8 || tagTableUBits > 8 ||
+             scCounterBits > 8, "Counters are at most 8 bits wide.\n");
+    fatal_if(logSizeBiMP < 2 || logSizeLoopPred < 2,
+             "The bimodal and loop tables need at least 4 entries.\n");
+    for (auto len : scHistLengths) {
+        fatal_if(len > maxHist, "Statistical corrector history length %d "
+                 "is longer than maxHist.\n", len);
+    }
+
+    histLengths.resize(nHistoryTables + 1);
+    tagWidths.resize(nHistoryTables + 1);
+    logTableSizes.resize(nHistoryTables + 1);
+    tableBase.resize(nHistoryTables + 1);
+
+    int num_entries = 0;
+    for (int i = 1; i <= nHistoryTables; i++) {
+        // History lengths grow geometrically, tag widths linearly
+        histLengths[i] = (int) (((double) minHist *
+                    pow((double) maxHist / (double) minHist,
+                        (double) (i - 1) / (double) (nHistoryTables - 1)))
+                    + 0.5);
+        tagWidths[i] = params->minTagWidth +
+            (params->maxTagWidth - params->minTagWidth) * (i - 1) /
+            (nHistoryTables - 1);
+        logTableSizes[i] = logSizeTagTables;
+
+        tableBase[i] = num_entries;
+        num_entries += 1 << logTableSizes[i];
+
+        DPRINTF(TageSCL, "HistLength:%d, TTSize:%d, TTTWidth:%d\n",
+                histLengths[i], logTableSizes[i], tagWidths[i]);
+    }
+
+    tags.assign(num_entries, 0);
+    ctrs.assign(num_entries, 0);
+    useful.assign(num_entries, 0);
+
+    foldOrigLength.resize(numFolded);
+    foldCompLength.resize(numFolded);
+    for (int i = 1; i <= nHistoryTables; i++) {
+        foldOrigLength[foldIndex(i)] = histLengths[i];
+        foldCompLength[foldIndex(i)] = logTableSizes[i];
+        foldOrigLength[foldTag0(i)] = histLengths[i];
+        foldCompLength[foldTag0(i)] = tagWidths[i];
+        foldOrigLength[foldTag1(i)] = histLengths[i];
+        foldCompLength[foldTag1(i)] = tagWidths[i] - 1;
+    }
+    for (int j = 1; j <= numSCTables; j++) {
+        foldOrigLength[foldSC(j)] = scHistLengths[j - 1];
+        foldCompLength[foldSC(j)] = logSizeSC;
+    }
+    foldOutpoint.resize(numFolded);
+    for (int i = 0; i < numFolded; i++)
+        foldOutpoint[i] = foldOrigLength[i] % foldCompLength[i];
+
+    bimodalPred.assign(ULL(1) << logSizeBiMP, 0);
+    bimodalHyst.assign(ULL(1) << (logSizeBiMP - 2), 1);
+    ltable.resize(ULL(1) << logSizeLoopPred);
+    scTables.assign((numSCTables + 1) << logSizeSC, 0);
+
+    for (auto& history : threadHistory) {
+        history.pathHist = 0;
+        history.globalHistory.assign(histBufferSize, 0);
+        history.ptGhist = 0;
+        history.folded.assign(numFolded, 0);
+    }
+}
+
+void
+TAGE_SC_L::updateFolded(int *folded, const uint8_t *h) const
+{
+    for (int i = 0; i < numFolded; i++) {
+        int comp = (folded[i] << 1) | h[0];
+        comp ^= h[foldOrigLength[i]] << foldOutpoint[i];
+        comp ^= comp >> foldCompLength[i];
+        folded[i] = comp & ((1 << foldCompLength[i]) - 1);
+    }
+}
+
+int
+TAGE_SC_L::F(int A, int size, int bank) const
+{
+    int log_size = logTableSizes[bank];
+    int mask = (1 << log_size) - 1;
+    int shift = bank % log_size;
+
+    A = A & ((1 << size) - 1);
+    int A1 = A & mask;
+    int A2 = A >> log_size;
+    if (shift) {
+        A2 = ((A2 << shift) & mask) + (A2 >> (log_size - shift));
+    }
+    A = A1 ^ A2;
+    if (shift) {
+        A = ((A << shift) & mask) + (A >> (log_size - shift));
+    }
+    return A;
+}
+
+int
+TAGE_SC_L::gindex(ThreadID tid, Addr pc, int bank) const
+{
+    const ThreadHistory &tHist = threadHistory[tid];
+    int hlen = std::min<int>(histLengths[bank], pathHistBits);
+    int index = pc ^ (pc >> (abs(logTableSizes[bank] - bank) + 1)) ^
+        tHist.folded[foldIndex(bank)] ^ F(tHist.pathHist, hlen, bank);
+
+    return index & ((1 << logTableSizes[bank]) - 1);
+}
+
+uint16_t
+TAGE_SC_L::gtag(ThreadID tid, Addr pc, int bank) const
+{
+    const ThreadHistory &tHist = threadHistory[tid];
+    int tag = pc ^ tHist.folded[foldTag0(bank)] ^
+        (tHist.folded[foldTag1(bank)] << 1);
+
+    return tag & ((1 << tagWidths[bank]) - 1);
+}
+
+template <class T>
+void
+TAGE_SC_L::ctrUpdate(T &ctr, bool taken, int nbits)
+{
+    if (taken) {
+        if (ctr < ((1 << (nbits - 1)) - 1))
+            ctr++;
+    } else {
+        if (ctr > -(1 << (nbits - 1)))
+            ctr--;
+    }
+}
+
+bool
+TAGE_SC_L::getBimodePred(const BranchInfo *bi) const
+{
+    return bimodalPred[bi->bimodalIndex];
+}
+
+void
+TAGE_SC_L::baseUpdate(bool taken, const BranchInfo *bi)
+{
+    int hyst_index = bi->bimodalIndex >> 2;
+    int inter = (bimodalPred[bi->bimodalIndex] << 1) + bimodalHyst[hyst_index];
+    if (taken) {
+        if (inter < 3)
+            inter++;
+    } else if (inter > 0) {
+        inter--;
+    }
+    bimodalPred[bi->bimodalIndex] = inter >> 1;
+    bimodalHyst[hyst_index] = inter & 1;
+}
+
+int
+TAGE_SC_L::lindex(Addr pc) const
+{
+    return (pc & ((ULL(1) << (logSizeLoopPred - 2)) - 1)) << 2;
+}
+
+bool
+TAGE_SC_L::getLoop(Addr pc, BranchInfo *bi) const
+{
+    bi->loopHit = -1;
+    bi->loopPredValid = false;
+    bi->loopIndex = lindex(pc);
+    bi->loopTag = (pc >> (logSizeLoopPred - 2)) & 0xffff;
+
+    for (int i = 0; i < 4; i++) {
+        const LoopEntry &loop = ltable[bi->loopIndex + i];
+        if (loop.tag == bi->loopTag) {
+            bi->loopHit = i;
+            bi->loopPredValid = loop.confidence >= 3;
+            bi->currentIter = loop.currentIterSpec;
+            if (loop.currentIterSpec + 1 == loop.numIter)
+                return !loop.dir;
+            return loop.dir;
+        }
+    }
+    return false;
+}
+
+void
+TAGE_SC_L::specLoopUpdate(bool taken, BranchInfo *bi)
+{
+    if (bi->loopHit >= 0) {
+        LoopEntry &loop = ltable[bi->loopIndex + bi->loopHit];
+        if (taken != loop.dir) {
+            loop.currentIterSpec = 0;
+        } else {
+            loop.currentIterSpec++;
+        }
+    }
+}
+
+void
+TAGE_SC_L::restoreLoop(const BranchInfo *bi)
+{
+    if (bi->condBranch && bi->loopHit >= 0)
+        ltable[bi->loopIndex + bi->loopHit].currentIterSpec = bi->currentIter;
+}
+
+void
+TAGE_SC_L::loopUpdate(bool taken, BranchInfo *bi)
+{
+    if (bi->loopHit >= 0) {
+        LoopEntry &loop = ltable[bi->loopIndex + bi->loopHit];
+
+        if (bi->loopPredValid) {
+            if (taken != bi->loopPred) {
+                // free the entry
+                loop.numIter = 0;
+                loop.age = 0;
+                loop.confidence = 0;
+                loop.currentIter = 0;
+                return;
+            } else if (bi->loopPred != bi->tagePred) {
+                if (loop.age < 7)
+                    loop.age++;
+            }
+        }
+
+        loop.currentIter++;
+        if (loop.currentIter > loop.numIter) {
+            loop.confidence = 0;
+            if (loop.numIter != 0) {
+                // free the entry
+                loop.numIter = 0;
+                loop.age = 0;
+            }
+        }
+
+        if (taken != loop.dir) {
+            if (loop.currentIter == loop.numIter) {
+                if (loop.confidence < 7)
+                    loop.confidence++;
+                // do not predict loops of one or two iterations
+                if (loop.numIter < 3) {
+                    loop.dir = taken;
+                    loop.numIter = 0;
+                    loop.age = 0;
+                    loop.confidence = 0;
+                }
+            } else if (loop.numIter == 0) {
+                // first complete nest
+                loop.confidence = 0;
+                loop.numIter = loop.currentIter;
+            } else {
+                // not the same number of iterations as last time
+                loop.numIter = 0;
+                loop.age = 0;
+                loop.confidence = 0;
+            }
+            loop.currentIter = 0;
+        }
+    } else if (taken) {
+        // try to allocate an entry on a taken branch
+        int nrand = random_mt.random<int>();
+        for (int i = 0; i < 4; i++) {
+            LoopEntry &loop = ltable[bi->loopIndex + ((nrand + i) & 3)];
+            if (loop.age == 0) {
+                DPRINTF(TageSCL, "Allocating loop pred entry for branch "
+                        "%lx\n", bi->branchPC);
+                loop.dir = !taken;
+                loop.tag = bi->loopTag;
+                loop.numIter = 0;
+                loop.age = 7;
+                loop.confidence = 0;
+                loop.currentIter = 1;
+                break;
+            }
+            loop.age--;
+        }
+    }
+}
+
+void
+TAGE_SC_L::scPredict(ThreadID tid, Addr pc, BranchInfo *bi) const
+{
+    const ThreadHistory &tHist = threadHistory[tid];
+    int mask = (1 << logSizeSC) - 1;
+
+    // The bias table learns how often TAGE is right for a branch
+    bi->scIndices[0] =
+        ((pc << 2) | (bi->tagePred << 1) | bi->highConf) & mask;
+    for (int j = 1; j <= numSCTables; j++) {
+        int index = (pc ^ (pc >> (j + 1)) ^ tHist.folded[foldSC(j)]) & mask;
+        bi->scIndices[j] = (j << logSizeSC) + index;
+    }
+
+    int sum = 0;
+    for (int j = 0; j <= numSCTables; j++)
+        sum += 2 * scTables[bi->scIndices[j]] + 1;
+
+    bi->scSum = sum;
+    bi->scPred = sum >= 0;
+
+    // Only a confident sum reverts a confident TAGE prediction
+    int threshold = bi->highConf ? scThreshold : scThreshold / 2;
+    bi->scUsed = bi->scPred != bi->tagePred && abs(sum) >= threshold;
+}
+
+void
+TAGE_SC_L::scUpdate(bool taken, const BranchInfo *bi)
+{
+    // Raise the threshold when the corrector is wrong against TAGE, lower
+    // it when it is right
+    if (bi->scPred != bi->tagePred) {
+        ctrUpdate(scThresholdCtr, bi->scPred != taken, 6);
+        if (scThresholdCtr == 31) {
+            scThreshold = std::min(scThreshold + 2, 255);
+            scThresholdCtr = 0;
+        } else if (scThresholdCtr == -32) {
+            scThreshold = std::max(scThreshold - 2, 4);
+            scThresholdCtr = 0;
+        }
+    }
+
+    if (bi->scPred != taken || abs(bi->scSum) < scThreshold) {
+        for (int j = 0; j <= numSCTables; j++)
+            ctrUpdate(scTables[bi->scIndices[j]], taken, scCounterBits);
+    }
+}
+
+void
+TAGE_SC_L::tageUpdate(bool taken, BranchInfo *bi)
+{
+    const int max_u = (1 << tagTableUBits) - 1;
+
+    // try to allocate a new entry only if the prediction was wrong
+    bool longest_match_pred = false;
+    bool alloc = (bi->tagePred != taken) && (bi->hitBank < nHistoryTables);
+    if (bi->hitBank > 0) {
+        longest_match_pred = bi->longestMatchPred;
+        // an entry is considered as newly allocated if its prediction
+        // counter is weak
+        if (bi->pseudoNewAlloc) {
+            // no need to allocate if the provider was right even if the
+            // overall prediction was wrong
+            if (longest_match_pred == taken)
+                alloc = false;
+            if (longest_match_pred != bi->altTaken) {
+                ctrUpdate(useAltPredForNewlyAllocated,
+                          bi->altTaken == taken, 4);
+            }
+        }
+    }
+
+    if (alloc) {
+        // to avoid ping-pong, do not always allocate in the next table but
+        // in one of the 3 next ones
+        int nrand = random_mt.random<int>(0, 3);
+        int Y = nrand & ((ULL(1) << (nHistoryTables - bi->hitBank - 1)) - 1);
+        int X = bi->hitBank + 1;
+        if (Y & 1) {
+            X++;
+            if (Y & 2)
+                X++;
+        }
+
+        bool allocated = false;
+        for (int i = X; i <= nHistoryTables; i++) {
+            int e = entry(i, bi->tableIndices[i]);
+            if (useful[e] == 0) {
+                tags[e] = bi->tableTags[i];
+                ctrs[e] = taken ? 0 : -1;
+                allocated = true;
+                break;
+            }
+        }
+
+        // no entry is available, age the ones that were candidates
+        if (!allocated) {
+            for (int i = X; i <= nHistoryTables; i++) {
+                int e = entry(i, bi->tableIndices[i]);
+                if (useful[e] > 0)
+                    useful[e]--;
+            }
+        }
+    }
+
+    // periodic aging of the useful counters
+    tCounter++;
+    if ((tCounter & ((ULL(1) << logUResetPeriod) - 1)) == 0) {
+        for (auto &u : useful)
+            u >>= 1;
+    }
+
+    if (bi->hitBank > 0) {
+        int hit = entry(bi->hitBank, bi->hitBankIndex);
+        DPRINTF(TageSCL, "Updating tag table entry (%d,%d) for branch %lx\n",
+                bi->hitBank, bi->hitBankIndex, bi->branchPC);
+        ctrUpdate(ctrs[hit], taken, tagTableCounterBits);
+
+        // if the provider entry is not certified to be useful also update
+        // the alternate prediction
+        if (useful[hit] == 0) {
+            if (bi->altBank > 0) {
+                ctrUpdate(ctrs[entry(bi->altBank, bi->altBankIndex)], taken,
+                          tagTableCounterBits);
+            } else {
+                baseUpdate(taken, bi);
+            }
+        }
+
+        // update the useful counter
+        if (longest_match_pred != bi->altTaken) {
+            if (longest_match_pred == taken) {
+                if (useful[hit] < max_u)
+                    useful[hit]++;
+            } else if (useful[hit] > 0) {
+                useful[hit]--;
+            }
+        }
+    } else {
+        baseUpdate(taken, bi);
+    }
+}
+
+unsigned
+TAGE_SC_L::getGHR(ThreadID tid, void *bp_history) const
+{
+    const BranchInfo *bi = static_cast<const BranchInfo *>(bp_history);
+    const ThreadHistory &tHist = threadHistory[tid];
+    unsigned val = 0;
+    for (unsigned i = 0; i < 32 && bi->ptGhist + i < histBufferSize; i++)
+        val |= (tHist.globalHistory[bi->ptGhist + i] & 0x1) << i;
+
+    return val;
+}
+
+bool
+TAGE_SC_L::predict(ThreadID tid, Addr pc, bool cond_branch, void* &b)
+{
+    BranchInfo *bi = new BranchInfo(nHistoryTables + 1, numSCTables + 1,
+                                    numFolded);
+    b = (void*)(bi);
+    bool pred_taken = true;
+
+    if (cond_branch) {
+        for (int i = 1; i <= nHistoryTables; i++) {
+            bi->tableIndices[i] = gindex(tid, pc, i);
+            bi->tableTags[i] = gtag(tid, pc, i);
+        }
+        bi->bimodalIndex = pc & ((ULL(1) << logSizeBiMP) - 1);
+
+        // Compare the tags of all the tables first, the longest and the
+        // second longest matches are then the two highest bits set
+        uint64_t hits = 0;
+        for (int i = 1; i <= nHistoryTables; i++) {
+            hits |= (uint64_t)(tags[entry(i, bi->tableIndices[i])] ==
+                               bi->tableTags[i]) << i;
+        }
+
+        bi->hitBank = 0;
+        bi->altBank = 0;
+        if (hits) {
+            bi->hitBank = findMsbSet(hits);
+            bi->hitBankIndex = bi->tableIndices[bi->hitBank];
+            hits &= ~(ULL(1) << bi->hitBank);
+            if (hits) {
+                bi->altBank = findMsbSet(hits);
+                bi->altBankIndex = bi->tableIndices[bi->altBank];
+            }
+        }
+
+        if (bi->hitBank > 0) {
+            if (bi->altBank > 0) {
+                bi->altTaken =
+                    ctrs[entry(bi->altBank, bi->altBankIndex)] >= 0;
+            } else {
+                bi->altTaken = getBimodePred(bi);
+            }
+
+            int ctr = ctrs[entry(bi->hitBank, bi->hitBankIndex)];
+            bi->longestMatchPred = ctr >= 0;
+            bi->pseudoNewAlloc = abs(2 * ctr + 1) <= 1;
+            bi->highConf = abs(2 * ctr + 1) == (1 << tagTableCounterBits) - 1;
+
+            // use the alternate prediction for a newly allocated entry
+            // when it was found to be better
+            if (useAltPredForNewlyAllocated < 0 || !bi->pseudoNewAlloc)
+                bi->tagePred = bi->longestMatchPred;
+            else
+                bi->tagePred = bi->altTaken;
+        } else {
+            bi->altTaken = getBimodePred(bi);
+            bi->tagePred = bi->altTaken;
+            bi->longestMatchPred = bi->altTaken;
+            bi->highConf = bimodalPred[bi->bimodalIndex] ==
+                bimodalHyst[bi->bimodalIndex >> 2];
+        }
+
+        bi->loopPred = getLoop(pc, bi);
+        scPredict(tid, pc, bi);
+
+        if (loopUseCounter >= 0 && bi->loopPredValid) {
+            bi->loopUsed = true;
+            bi->scUsed = false;
+            pred_taken = bi->loopPred;
+        } else {
+            pred_taken = bi->scUsed ? bi->scPred : bi->tagePred;
+        }
+
+        DPRINTF(TageSCL, "Predict for %lx: taken?:%d, loopTaken?:%d, "
+                "loopValid?:%d, loopUseCounter:%d, tagePred:%d, altPred:%d, "
+                "scSum:%d\n", pc, pred_taken, bi->loopPred,
+                bi->loopPredValid, loopUseCounter, bi->tagePred,
+                bi->altTaken, bi->scSum);
+    }
+    bi->condBranch = cond_branch;
+    specLoopUpdate(pred_taken, bi);
+    return pred_taken;
+}
+
+void
+TAGE_SC_L::update(ThreadID tid, Addr branch_pc, bool taken, void *bp_history,
+                  bool squashed)
+{
+    assert(bp_history);
+
+    BranchInfo *bi = static_cast<BranchInfo*>(bp_history);
+
+    if (squashed) {
+        // This restores the histories, then updates them with the actual
+        // outcome
+        squash(tid, taken, bp_history);
+        return;
+    }
+
+    if (bi->condBranch) {
+        DPRINTF(TageSCL, "Updating tables for branch:%lx; taken?:%d\n",
+                branch_pc, taken);
+        loopUpdate(taken, bi);
+
+        if (bi->loopPredValid && bi->tagePred != bi->loopPred)
+            ctrUpdate(loopUseCounter, bi->loopPred == taken, 7);
+
+        scUpdate(taken, bi);
+        tageUpdate(taken, bi);
+
+        if (bi->loopUsed) {
+            ++loopUsed;
+            if (bi->loopPred != taken)
+                ++loopIncorrect;
+        }
+        if (bi->scUsed) {
+            ++scUsed;
+            if (bi->scPred != taken)
+                ++scIncorrect;
+        }
+    }
+
+    delete bi;
+}
+
+void
+TAGE_SC_L::updateHistories(ThreadID tid, Addr pc, bool taken, void *b)
+{
+    BranchInfo *bi = static_cast<BranchInfo*>(b);
+    ThreadHistory &tHist = threadHistory[tid];
+
+    if (tHist.ptGhist == 0) {
+        // Copy the beginning of the buffer to its end, such that the last
+        // maxHist outcomes are still reachable from the new position
+        std::copy(tHist.globalHistory.begin(),
+                  tHist.globalHistory.begin() + maxHist,
+                  tHist.globalHistory.end() - maxHist);
+        tHist.ptGhist = histBufferSize - maxHist;
+    }
+    tHist.ptGhist--;
+    tHist.globalHistory[tHist.ptGhist] = taken;
+    tHist.pathHist = ((tHist.pathHist << 1) + (pc & 1)) &
+        ((ULL(1) << pathHistBits) - 1);
+
+    bi->ptGhist = tHist.ptGhist;
+    bi->pathHist = tHist.pathHist;
+    std::copy(tHist.folded.begin(), tHist.folded.end(), bi->folded);
+    updateFolded(tHist.folded.data(), &tHist.globalHistory[tHist.ptGhist]);
+}
+
+void
+TAGE_SC_L::squash(ThreadID tid, bool taken, void *bp_history)
+{
+    BranchInfo *bi = static_cast<BranchInfo*>(bp_history);
+    ThreadHistory &tHist = threadHistory[tid];
+    DPRINTF(TageSCL, "Restoring branch info: %lx; taken? %d; "
+            "PathHistory:%x, pointer:%d\n", bi->branchPC, taken,
+            bi->pathHist, bi->ptGhist);
+
+    tHist.pathHist = bi->pathHist;
+    tHist.ptGhist = bi->ptGhist;
+    tHist.globalHistory[tHist.ptGhist] = taken;
+    std::copy(bi->folded, bi->folded + numFolded, tHist.folded.begin());
+    updateFolded(tHist.folded.data(), &tHist.globalHistory[tHist.ptGhist]);
+
+    restoreLoop(bi);
+    specLoopUpdate(taken, bi);
+}
+
+void
+TAGE_SC_L::squash(ThreadID tid, void *bp_history)
+{
+    BranchInfo *bi = static_cast<BranchInfo*>(bp_history);
+    DPRINTF(TageSCL, "Deleting branch info: %lx\n", bi->branchPC);
+    restoreLoop(bi);
+
+    delete bi;
+}
+
+bool
+TAGE_SC_L::lookup(ThreadID tid, Addr branch_pc, void* &bp_history)
+{
+    Addr pc = branch_pc >> instShiftAmt;
+    bool retval = predict(tid, pc, true, bp_history);
+    static_cast<BranchInfo*>(bp_history)->branchPC = branch_pc;
+
+    DPRINTF(TageSCL, "Lookup branch: %lx; predict:%d\n", branch_pc, retval);
+    updateHistories(tid, pc, retval, bp_history);
+
+    return retval;
+}
+
+void
+TAGE_SC_L::btbUpdate(ThreadID tid, Addr branch_pc, void* &bp_history)
+{
+    BranchInfo *bi = static_cast<BranchInfo*>(bp_history);
+    ThreadHistory &tHist = threadHistory[tid];
+    DPRINTF(TageSCL, "BTB miss resets prediction: %lx\n", branch_pc);
+
+    tHist.globalHistory[tHist.ptGhist] = 0;
+    std::copy(bi->folded, bi->folded + numFolded, tHist.folded.begin());
+    updateFolded(tHist.folded.data(), &tHist.globalHistory[tHist.ptGhist]);
+}
+
+void
+TAGE_SC_L::uncondBranch(ThreadID tid, Addr br_pc, void* &bp_history)
+{
+    DPRINTF(TageSCL, "UnConditionalBranch: %lx\n", br_pc);
+    Addr pc = br_pc >> instShiftAmt;
+    predict(tid, pc, false, bp_history);
+    static_cast<BranchInfo*>(bp_history)->branchPC = br_pc;
+    updateHistories(tid, pc, true, bp_history);
+}
+
+void
+TAGE_SC_L::regStats()
+{
+    BPredUnit::regStats();
+
+    loopUsed
+        .name(name() + ".loopUsed")
+        .desc("Number of conditional branches predicted by the loop "
+              "predictor")
+        ;
+
+    loopIncorrect
+        .name(name() + ".loopIncorrect")
+        .desc("Number of incorrect loop predictor predictions")
+        ;
+
+    scUsed
+        .name(name() + ".scUsed")
+        .desc("Number of TAGE predictions reverted by the statistical "
+              "corrector")
+        ;
+
+    scIncorrect
+        .name(name() + ".scIncorrect")
+        .desc("Number of incorrect statistical corrector reversals")
+        ;
+}
+
+TAGE_SC_L*
+TAGE_SC_LParams::create()
+{
+    return new TAGE_SC_L(this);
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Implementation of a TAGE-SC-L branch predictor. It has the same TAGE
+ * and loop predictor components as L-TAGE, and adds a statistical
+ * corrector: a few tables of counters, indexed with the PC, the TAGE
+ * prediction and short global histories, whose sum can revert a TAGE
+ * prediction of low confidence that is statistically wrong.
+ *
+ * The tagged tables are kept as separate packed arrays of tags, counters
+ * and useful bits rather than arrays of entries, and all the folded
+ * histories of a thread are stored together, so that the speculative
+ * history update, its checkpoint and its repair are each a single pass
+ * over one array.
+ */
+
+#ifndef __CPU_PRED_TAGE_SC_L_HH__
+#define __CPU_PRED_TAGE_SC_L_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "params/TAGE_SC_L.hh"
+
+class TAGE_SC_L : public BPredUnit
+{
+  public:
+    TAGE_SC_L(const TAGE_SC_LParams *params);
+
+    // Base class methods.
+    void uncondBranch(ThreadID tid, Addr br_pc, void* &bp_history) override;
+    bool lookup(ThreadID tid, Addr branch_addr, void* &bp_history) override;
+    void btbUpdate(ThreadID tid, Addr branch_addr, void* &bp_history) override;
+    void update(ThreadID tid, Addr branch_addr, bool taken, void *bp_history,
+                bool squashed) override;
+    void squash(ThreadID tid, void *bp_history) override;
+    unsigned getGHR(ThreadID tid, void *bp_history) const override;
+
+    void regStats() override;
+
+  private:
+    // Loop Predictor Entry
+    struct LoopEntry
+    {
+        uint16_t numIter;
+        uint16_t currentIter;
+        uint16_t currentIterSpec;
+        uint8_t confidence;
+        uint16_t tag;
+        uint8_t age;
+        bool dir;
+
+        LoopEntry() : numIter(0), currentIter(0), currentIterSpec(0),
+                      confidence(0), tag(0), age(0), dir(0) { }
+    };
+
+    // Information recorded at prediction time to update and repair the
+    // predictor
+    struct BranchInfo
+    {
+        int pathHist;
+        int ptGhist;
+        int hitBank;
+        int hitBankIndex;
+        int altBank;
+        int altBankIndex;
+        int bimodalIndex;
+
+        bool tagePred;
+        bool altTaken;
+        bool longestMatchPred;
+        bool pseudoNewAlloc;
+        bool highConf;
+
+        int loopTag;
+        uint16_t currentIter;
+        bool loopPred;
+        bool loopPredValid;
+        int loopIndex;
+        int loopHit;
+        bool loopUsed;
+
+        int scSum;
+        bool scPred;
+        bool scUsed;
+
+        bool condBranch;
+        Addr branchPC;
+
+        // A single allocation holds the arrays below
+        int *storage;
+
+        // Index and tag for each tagged table
+        int *tableIndices;
+        int *tableTags;
+        // Index for each statistical corrector table
+        int *scIndices;
+        // Folded histories before this branch updated them
+        int *folded;
+
+        BranchInfo(int num_banks, int num_sc_tables, int num_folded)
+            : pathHist(0), ptGhist(0),
+              hitBank(0), hitBankIndex(0), altBank(0), altBankIndex(0),
+              bimodalIndex(0), tagePred(false), altTaken(false),
+              longestMatchPred(false), pseudoNewAlloc(false),
+              highConf(false), loopTag(0), currentIter(0), loopPred(false),
+              loopPredValid(false), loopIndex(0), loopHit(-1),
+              loopUsed(false), scSum(0), scPred(false), scUsed(false),
+              condBranch(false), branchPC(0)
+        {
+            storage = new int[2 * num_banks + num_sc_tables + num_folded];
+            tableIndices = storage;
+            tableTags = tableIndices + num_banks;
+            scIndices = tableTags + num_banks;
+            folded = scIndices + num_sc_tables;
+        }
+
+        ~BranchInfo()
+        {
+            delete[] storage;
+        }
+    };
+
+    // Per-thread speculative histories, to support SMT
+    struct ThreadHistory
+    {
+        // Path history (LSB of the branch addresses)
+        int pathHist;
+
+        // Direction history, a circular buffer filled downwards
+        std::vector<uint8_t> globalHistory;
+
+        // Index of the most recent branch outcome
+        int ptGhist;
+
+        // All the folded histories, see foldIndex() and co.
+        std::vector<int> folded;
+    };
+
+    /** @{ Position of the folded histories of a table */
+    int foldIndex(int bank) const { return bank - 1; }
+    int foldTag0(int bank) const { return nHistoryTables + bank - 1; }
+    int foldTag1(int bank) const { return 2 * nHistoryTables + bank - 1; }
+    int foldSC(int table) const { return 3 * nHistoryTables + table - 1; }
+    /** @} */
+
+    /** Position of an entry of a tagged table in the packed arrays. */
+    int entry(int bank, int index) const { return tableBase[bank] + index; }
+
+    /**
+     * Adds the most recent outcome to the folded histories.
+     * @param folded The folded histories to update.
+     * @param h The direction history, most recent outcome first.
+     */
+    void updateFolded(int *folded, const uint8_t *h) const;
+
+    /** Rotates the path history depending on the table accessed. */
+    int F(int phist, int size, int bank) const;
+
+    /** Index in a tagged table. */
+    int gindex(ThreadID tid, Addr pc, int bank) const;
+
+    /** Partial tag in a tagged table. */
+    uint16_t gtag(ThreadID tid, Addr pc, int bank) const;
+
+    /** Updates a signed saturating counter. */
+    template <class T>
+    static void ctrUpdate(T &ctr, bool taken, int nbits);
+
+    /** @{ The bimodal table, with one hysteresis bit per 4 entries */
+    bool getBimodePred(const BranchInfo *bi) const;
+    void baseUpdate(bool taken, const BranchInfo *bi);
+    /** @} */
+
+    /** @{ The loop predictor */
+    int lindex(Addr pc) const;
+    bool getLoop(Addr pc, BranchInfo *bi) const;
+    void specLoopUpdate(bool taken, BranchInfo *bi);
+    void loopUpdate(bool taken, BranchInfo *bi);
+    /** @} */
+
+    /** @{ The statistical corrector */
+    void scPredict(ThreadID tid, Addr pc, BranchInfo *bi) const;
+    void scUpdate(bool taken, const BranchInfo *bi);
+    /** @} */
+
+    /** Updates the TAGE tables with the outcome of a branch. */
+    void tageUpdate(bool taken, BranchInfo *bi);
+
+    /** Makes a prediction, the branch PC is already shifted. */
+    bool predict(ThreadID tid, Addr pc, bool cond_branch, void* &b);
+
+    /** Updates the speculative histories with a predicted outcome. */
+    void updateHistories(ThreadID tid, Addr pc, bool taken, void *b);
+
+    /** Repairs the histories with the actual outcome of a branch. */
+    void squash(ThreadID tid, bool taken, void *bp_history);
+
+    /** Undoes the speculative update of the loop iteration count. */
+    void restoreLoop(const BranchInfo *bi);
+
+    const unsigned logSizeBiMP;
+    const unsigned logSizeTagTables;
+    const unsigned logSizeLoopPred;
+    const unsigned nHistoryTables;
+    const unsigned tagTableCounterBits;
+    const unsigned tagTableUBits;
+    const unsigned histBufferSize;
+    const unsigned minHist;
+    const unsigned maxHist;
+    const unsigned pathHistBits;
+    const unsigned logUResetPeriod;
+    const unsigned logSizeSC;
+    const unsigned scCounterBits;
+    const std::vector<unsigned> scHistLengths;
+    const unsigned numSCTables;
+    const unsigned numFolded;
+
+    /** Bimodal prediction bits and shared hysteresis bits */
+    std::vector<uint8_t> bimodalPred;
+    std::vector<uint8_t> bimodalHyst;
+
+    /** @{ The tagged tables, one after the other */
+    std::vector<uint16_t> tags;
+    std::vector<int8_t> ctrs;
+    std::vector<uint8_t> useful;
+    /** @} */
+
+    /** Position of the first entry of each tagged table */
+    std::vector<int> tableBase;
+    std::vector<int> histLengths;
+    std::vector<int> tagWidths;
+    std::vector<int> logTableSizes;
+
+    /** @{ Lengths and positions of the folded histories */
+    std::vector<int> foldOrigLength;
+    std::vector<int> foldCompLength;
+    std::vector<int> foldOutpoint;
+    /** @} */
+
+    std::vector<LoopEntry> ltable;
+
+    /** Statistical corrector tables: the bias table, then one per
+     *  history length
+     */
+    std::vector<int8_t> scTables;
+
+    std::vector<ThreadHistory> threadHistory;
+
+    int8_t loopUseCounter;
+    int8_t useAltPredForNewlyAllocated;
+    uint64_t tCounter;
+
+    /** Sum under which the statistical corrector is trained */
+    int scThreshold;
+    int8_t scThresholdCtr;
+
+    Stats::Scalar loopUsed;
+    Stats::Scalar loopIncorrect;
+    Stats::Scalar scUsed;
+    Stats::Scalar scIncorrect;
+};
+
+#endif // __CPU_PRED_TAGE_SC_L_HH__
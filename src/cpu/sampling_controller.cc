@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/sampling_controller.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/misc.hh"
+#include "cpu/base.hh"
+#include "debug/Sampling.hh"
+#include "sim/sim_exit.hh"
+
+/** Standard score z such that P(|X| < z) = confidence for X ~ N(0, 1) */
+static double
+normalQuantile(double confidence)
+{
+    double lo = 0, hi = 10;
+    for (int i = 0; i < 100; ++i) {
+        double mid = (lo + hi) / 2;
+        if (std::erf(mid / std::sqrt(2.0)) < confidence)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return (lo + hi) / 2;
+}
+
+SamplingController::SamplingController(const Params *p)
+    : SimObject(p),
+      fastCPUs(p->fast_cpus), detailedCPUs(p->detailed_cpus),
+      fastForwardInsts(p->period - p->warmup - p->measure),
+      warmupInsts(p->warmup), measureInsts(p->measure),
+      maxSamples(p->max_samples), targetError(p->target_error),
+      zScore(0), phase(Done),
+      phaseEvent([this]{ phaseEnd(); }, name()), phaseQueue(NULL),
+      startInsts(p->detailed_cpus.size(), 0),
+      startCycles(p->detailed_cpus.size(), Cycles(0)),
+      numSamples(0), cpiSum(p->detailed_cpus.size(), 0),
+      cpiSumSq(p->detailed_cpus.size(), 0), totalSamples(0),
+      sampleStream(NULL)
+{
+    fatal_if(fastCPUs.empty() || fastCPUs.size() != detailedCPUs.size(),
+             "%s: needs as many fast as detailed CPUs.\n", name());
+    fatal_if(p->measure == 0, "%s: the measurement interval is empty.\n",
+             name());
+    fatal_if(p->period <= p->warmup + p->measure,
+             "%s: the period leaves no room to fast-forward.\n", name());
+    fatal_if(p->confidence <= 0 || p->confidence >= 1,
+             "%s: confidence must be between 0 and 1.\n", name());
+
+    zScore = normalQuantile(p->confidence);
+
+    if (!p->sample_file.empty()) {
+        sampleStream = simout.create(p->sample_file);
+        *sampleStream->stream()
+            << "# sample tick cpu insts cycles cpi" << std::endl;
+    }
+}
+
+SamplingController::~SamplingController()
+{
+    if (phaseEvent.scheduled())
+        phaseQueue->deschedule(&phaseEvent);
+    if (sampleStream)
+        simout.close(sampleStream);
+}
+
+void
+SamplingController::startup()
+{
+    if (!fastCPUs[0]->switchedOut())
+        startFastForward();
+    else if (!detailedCPUs[0]->switchedOut())
+        startWarmup();
+    else
+        fatal("%s: none of the CPUs are active.\n", name());
+}
+
+void
+SamplingController::drainResume()
+{
+    // Other drains, e.g. for checkpoints, leave the active CPUs alone
+    if (phase == SwitchToDetailed && !detailedCPUs[0]->switchedOut())
+        startWarmup();
+    else if (phase == SwitchToFast && !fastCPUs[0]->switchedOut())
+        startFastForward();
+}
+
+void
+SamplingController::schedulePhaseEnd(BaseCPU *cpu, Counter insts)
+{
+    if (phaseEvent.scheduled())
+        phaseQueue->deschedule(&phaseEvent);
+
+    phaseQueue = cpu->comInstEventQueue[0];
+    phaseQueue->schedule(&phaseEvent, phaseQueue->getCurTick() + insts);
+}
+
+void
+SamplingController::startFastForward()
+{
+    DPRINTF(Sampling, "Fast-forwarding %d instructions\n",
+            fastForwardInsts);
+    phase = FastForward;
+    schedulePhaseEnd(fastCPUs[0], fastForwardInsts);
+}
+
+void
+SamplingController::startWarmup()
+{
+    if (warmupInsts == 0) {
+        startMeasure();
+        return;
+    }
+
+    DPRINTF(Sampling, "Warming up for %d instructions\n", warmupInsts);
+    phase = Warmup;
+    schedulePhaseEnd(detailedCPUs[0], warmupInsts);
+}
+
+void
+SamplingController::startMeasure()
+{
+    DPRINTF(Sampling, "Measuring %d instructions\n", measureInsts);
+    phase = Measure;
+
+    for (size_t i = 0; i < detailedCPUs.size(); ++i) {
+        startInsts[i] = detailedCPUs[i]->totalInsts();
+        startCycles[i] = detailedCPUs[i]->curCycle();
+    }
+
+    schedulePhaseEnd(detailedCPUs[0], measureInsts);
+}
+
+void
+SamplingController::phaseEnd()
+{
+    switch (phase) {
+      case FastForward:
+        phase = SwitchToDetailed;
+        exitSimLoop("sampling: switch to detailed");
+        break;
+
+      case Warmup:
+        startMeasure();
+        break;
+
+      case Measure:
+        endMeasure();
+        if (maxSamples && totalSamples >= maxSamples) {
+            phase = Done;
+            exitSimLoop("sampling: done");
+        } else {
+            phase = SwitchToFast;
+            exitSimLoop("sampling: switch to fast");
+        }
+        break;
+
+      default:
+        panic("%s: phase %d ended unexpectedly.\n", name(), phase);
+    }
+}
+
+void
+SamplingController::endMeasure()
+{
+    ++numSamples;
+    ++totalSamples;
+
+    for (size_t i = 0; i < detailedCPUs.size(); ++i) {
+        Counter insts = detailedCPUs[i]->totalInsts() - startInsts[i];
+        Cycles cycles = detailedCPUs[i]->curCycle() - startCycles[i];
+        // An idle CPU does not tell anything about the CPI
+        double sample_cpi = insts ? double(cycles) / insts : 0;
+
+        cpiSum[i] += sample_cpi;
+        cpiSumSq[i] += sample_cpi * sample_cpi;
+
+        DPRINTF(Sampling, "Sample %d of %s: %d insts, %d cycles\n",
+                totalSamples, detailedCPUs[i]->name(), insts, cycles);
+
+        if (sampleStream) {
+            *sampleStream->stream()
+                << totalSamples << " " << curTick() << " "
+                << detailedCPUs[i]->name() << " " << insts << " "
+                << cycles << " " << sample_cpi << std::endl;
+        }
+    }
+
+    updateStats();
+}
+
+void
+SamplingController::updateStats()
+{
+    samples = numSamples;
+
+    for (size_t i = 0; i < detailedCPUs.size(); ++i) {
+        double n = numSamples;
+        double mean = n ? cpiSum[i] / n : 0;
+        double var = n > 1 ?
+            std::max(0.0, (cpiSumSq[i] - n * mean * mean) / (n - 1)) : 0;
+        double stddev = std::sqrt(var);
+        double half_width = n ? zScore * stddev / std::sqrt(n) : 0;
+
+        cpi[i] = mean;
+        cpiStdDev[i] = stddev;
+        cpiConfidence[i] = half_width;
+        cpiRelError[i] = mean ? half_width / mean : 0;
+
+        double needed = mean ? zScore * stddev / (targetError * mean) : 0;
+        requiredSamples[i] = std::ceil(needed * needed);
+    }
+}
+
+void
+SamplingController::regStats()
+{
+    SimObject::regStats();
+
+    samples
+        .name(name() + ".samples")
+        .desc("Number of measurement intervals")
+        ;
+
+    cpi
+        .init(detailedCPUs.size())
+        .name(name() + ".cpi")
+        .desc("Mean CPI of the samples")
+        ;
+
+    cpiStdDev
+        .init(detailedCPUs.size())
+        .name(name() + ".cpiStdDev")
+        .desc("Standard deviation of the CPI of the samples")
+        ;
+
+    cpiConfidence
+        .init(detailedCPUs.size())
+        .name(name() + ".cpiConfidence")
+        .desc("Half-width of the confidence interval of the mean CPI")
+        ;
+
+    cpiRelError
+        .init(detailedCPUs.size())
+        .name(name() + ".cpiRelError")
+        .desc("Confidence half-width relative to the mean CPI")
+        ;
+
+    requiredSamples
+        .init(detailedCPUs.size())
+        .name(name() + ".requiredSamples")
+        .desc("Samples needed to reach the target relative error")
+        ;
+
+    for (size_t i = 0; i < detailedCPUs.size(); ++i) {
+        const std::string &cpu_name = detailedCPUs[i]->name();
+        cpi.subname(i, cpu_name);
+        cpiStdDev.subname(i, cpu_name);
+        cpiConfidence.subname(i, cpu_name);
+        cpiRelError.subname(i, cpu_name);
+        requiredSamples.subname(i, cpu_name);
+    }
+}
+
+void
+SamplingController::resetStats()
+{
+    SimObject::resetStats();
+
+    numSamples = 0;
+    std::fill(cpiSum.begin(), cpiSum.end(), 0);
+    std::fill(cpiSumSq.begin(), cpiSumSq.end(), 0);
+}
+
+SamplingController *
+SamplingControllerParams::create()
+{
+    return new SamplingController(this);
+}
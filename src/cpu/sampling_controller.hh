@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SAMPLING_CONTROLLER_HH__
+#define __CPU_SAMPLING_CONTROLLER_HH__
+
+#include <vector>
+
+#include "base/output.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "params/SamplingController.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+class BaseCPU;
+
+/**
+ * Drives SMARTS-style sampled simulation.
+ *
+ * Execution is split into periods of a fixed number of instructions. Each
+ * period starts with a functional fast-forward on the fast CPUs, and ends
+ * with a detailed warmup followed by a measurement interval on the
+ * detailed CPUs. The controller counts the instructions of each phase and
+ * asks the simulation script to switch CPUs by exiting the simulation
+ * loop with the causes "sampling: switch to detailed" and "sampling:
+ * switch to fast". It picks up where it left off once the switch is done
+ * and the system resumes.
+ *
+ * The CPI of each measurement interval is a sample. The mean CPI of the
+ * samples is reported for each detailed CPU together with the half-width
+ * of its confidence interval, and the number of samples needed to reach
+ * the target relative error at the same confidence.
+ */
+class SamplingController : public SimObject
+{
+  public:
+    typedef SamplingControllerParams Params;
+
+    SamplingController(const Params *p);
+    ~SamplingController();
+
+    void startup() override;
+    void drainResume() override;
+
+    void regStats() override;
+    void resetStats() override;
+
+  private:
+    enum Phase {
+        FastForward,
+        SwitchToDetailed,
+        Warmup,
+        Measure,
+        SwitchToFast,
+        Done
+    };
+
+    /** Start each phase, counting instructions on the CPUs it runs on */
+    void startFastForward();
+    void startWarmup();
+    void startMeasure();
+
+    /** Called when the instruction count of a phase is reached */
+    void phaseEnd();
+
+    /** Record the CPI of a measurement interval and update the stats. */
+    void endMeasure();
+    void updateStats();
+
+    /** Schedule the end of the phase after a CPU commits insts more. */
+    void schedulePhaseEnd(BaseCPU *cpu, Counter insts);
+
+    std::vector<BaseCPU *> fastCPUs;
+    std::vector<BaseCPU *> detailedCPUs;
+
+    /** Instructions of fast-forward, warmup and measurement per period */
+    const Counter fastForwardInsts;
+    const Counter warmupInsts;
+    const Counter measureInsts;
+
+    /** Stop after this many samples, or never if 0 */
+    const Counter maxSamples;
+
+    /** Relative error of the mean CPI that is aimed for */
+    const double targetError;
+
+    /** Standard score of the confidence level */
+    double zScore;
+
+    Phase phase;
+
+    /** Ends the current phase, on the queue of committed instructions */
+    EventFunctionWrapper phaseEvent;
+    EventQueue *phaseQueue;
+
+    /** State of the detailed CPUs when the measurement started */
+    std::vector<Counter> startInsts;
+    std::vector<Cycles> startCycles;
+
+    /** Accumulated CPI of the samples since the last stats reset */
+    Counter numSamples;
+    std::vector<double> cpiSum;
+    std::vector<double> cpiSumSq;
+
+    /** Samples taken since the start of the simulation */
+    Counter totalSamples;
+
+    /** Per-sample output, NULL if disabled */
+    OutputStream *sampleStream;
+
+    Stats::Scalar samples;
+    Stats::Vector cpi;
+    Stats::Vector cpiStdDev;
+    Stats::Vector cpiConfidence;
+    Stats::Vector cpiRelError;
+    Stats::Vector requiredSamples;
+};
+
+#endif // __CPU_SAMPLING_CONTROLLER_HH__
@@ -61,9 +61,14 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
-    fastmem = Param.Bool(False, "Access memory directly")
+    fastmem = Param.Bool(False, "Access memory directly (the stats of the "
+        "memories do not count plain accesses)")
+    block_cache = Param.Bool(False, "Reuse decoded basic blocks instead of "
+        "fetching and decoding every instruction (for fast-forwarding, "
+        "the instruction fetches are not simulated)")
 
-    def addSimPointProbe(self, interval):
+    def addSimPointProbe(self, interval, max_k = 0):
         simpoint = SimPoint()
         simpoint.interval = interval
+        simpoint.max_k = max_k
         self.probeListener = simpoint
@@ -43,6 +43,8 @@
 
 #include "cpu/simple/atomic.hh"
 
+#include <algorithm>
+
 #include "arch/locked_mem.hh"
 #include "arch/mmapped_ipr.hh"
 #include "arch/utility.hh"
@@ -53,6 +55,7 @@
 #include "debug/Drain.hh"
 #include "debug/ExecFaulting.hh"
 #include "debug/SimpleCPU.hh"
+#include "mem/abstract_mem.hh"
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
 #include "mem/physical.hh"
@@ -73,8 +76,21 @@ AtomicSimpleCPU::init()
     ifetch_req.setContext(cid);
     data_read_req.setContext(cid);
     data_write_req.setContext(cid);
+
+    // The decoded blocks are dropped by the thread of the CPU writing
+    // the code, which must not race with the thread using them
+    if (blockCache) {
+        for (auto cpu : allCPUs) {
+            if (cpu->eventQueue() != eventQueue()) {
+                fatal("%s: block_cache needs the atomic CPUs to be on the "
+                      "same event queue, %s is not\n", name(), cpu->name());
+            }
+        }
+    }
 }
 
+std::vector<AtomicSimpleCPU *> AtomicSimpleCPU::allCPUs;
+
 AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
     : BaseSimpleCPU(p),
       tickEvent([this]{ tick(); }, "AtomicSimpleCPU tick",
@@ -84,10 +100,14 @@ AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
       simulate_inst_stalls(p->simulate_inst_stalls),
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
-      fastmem(p->fastmem), dcache_access(false), dcache_latency(0),
+      fastmem(p->fastmem), hostPages(numHostPages),
+      dcache_access(false), dcache_latency(0),
+      blockCache(p->block_cache ? new BlockCache(numThreads) : nullptr),
       ppCommit(nullptr)
 {
     _status = Idle;
+    flushHostPages();
+    allCPUs.push_back(this);
 }
 
 
@@ -96,6 +116,8 @@ AtomicSimpleCPU::~AtomicSimpleCPU()
     if (tickEvent.scheduled()) {
         deschedule(tickEvent);
     }
+
+    allCPUs.erase(std::find(allCPUs.begin(), allCPUs.end(), this));
 }
 
 DrainState
@@ -145,6 +167,11 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed by anyone while we were drained
+    if (blockCache)
+        blockCache->flush();
+    flushHostPages();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -290,6 +317,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
         for (auto &t_info : cpu->threadInfo) {
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
+        cpu->codeWritten(pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -317,6 +345,50 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
     }
+
+    if (pkt->isInvalidate() || pkt->isWrite())
+        cpu->codeWritten(pkt->getAddr(), pkt->getSize());
+}
+
+uint8_t *
+AtomicSimpleCPU::hostAddr(Addr paddr, unsigned size, bool write)
+{
+    Addr page = roundDown(paddr, TheISA::PageBytes);
+    HostPage &entry = hostPages[(page / TheISA::PageBytes) % numHostPages];
+
+    if (entry.page != page) {
+        entry.page = page;
+        entry.host = system->getPhysMem().hostAddr(
+            RangeSize(page, TheISA::PageBytes), entry.mem);
+    }
+
+    if (!entry.host || paddr + size > page + TheISA::PageBytes)
+        return NULL;
+
+    // A write has to clear the locked addresses it matches, and has to
+    // be snooped by the other threads
+    if (write && (!entry.mem || !entry.mem->getLockedAddrList().empty() ||
+                  numThreads > 1)) {
+        return NULL;
+    }
+
+    return entry.host + (paddr - page);
+}
+
+void
+AtomicSimpleCPU::flushHostPages()
+{
+    for (auto &entry : hostPages)
+        entry.page = MaxAddr;
+}
+
+void
+AtomicSimpleCPU::fastmemWritten(PacketPtr pkt)
+{
+    for (auto cpu : allCPUs) {
+        if (cpu != this && !cpu->switchedOut())
+            cpu->dcachePort.recvAtomicSnoop(pkt);
+    }
 }
 
 Fault
@@ -353,7 +425,18 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t * data, unsigned size,
                                                           BaseTLB::Read);
 
         // Now do the access.
-        if (fault == NoFault && !req->getFlags().isSet(Request::NO_ACCESS)) {
+        uint8_t *host = NULL;
+        if (fastmem && fault == NoFault && !req->isLLSC() &&
+            !req->isMmappedIpr() &&
+            !req->getFlags().isSet(Request::NO_ACCESS)) {
+            host = hostAddr(req->getPaddr(), size, false);
+        }
+
+        if (host) {
+            memcpy(data, host, size);
+            dcache_access = true;
+        } else if (fault == NoFault &&
+                   !req->getFlags().isSet(Request::NO_ACCESS)) {
             Packet pkt(req, Packet::makeReadCmd(req));
             pkt.dataStatic(data);
 
@@ -471,7 +554,24 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 }
             }
 
-            if (do_access && !req->getFlags().isSet(Request::NO_ACCESS)) {
+            uint8_t *host = NULL;
+            if (fastmem && do_access && cmd == MemCmd::WriteReq &&
+                !req->isMmappedIpr() &&
+                !req->getFlags().isSet(Request::NO_ACCESS)) {
+                host = hostAddr(req->getPaddr(), size, true);
+            }
+
+            if (host) {
+                memcpy(host, data, size);
+                codeWritten(req->getPaddr(), size);
+                if (allCPUs.size() > 1) {
+                    Packet pkt(req, cmd);
+                    pkt.dataStatic(data);
+                    fastmemWritten(&pkt);
+                }
+                dcache_access = true;
+            } else if (do_access &&
+                       !req->getFlags().isSet(Request::NO_ACCESS)) {
                 Packet pkt = Packet(req, cmd);
                 pkt.dataStatic(data);
 
@@ -479,13 +579,16 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                     dcache_latency +=
                         TheISA::handleIprWrite(thread->getTC(), &pkt);
                 } else {
-                    if (fastmem && system->isMemAddr(pkt.getAddr()))
+                    if (fastmem && system->isMemAddr(pkt.getAddr())) {
                         system->getPhysMem().access(&pkt);
-                    else
+                        fastmemWritten(&pkt);
+                    } else {
                         dcache_latency += dcachePort.sendAtomic(&pkt);
+                    }
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+                    codeWritten(pkt.getAddr(), pkt.getSize());
                 }
                 dcache_access = true;
                 assert(!pkt.isError());
@@ -575,7 +678,13 @@ AtomicSimpleCPU::tick()
 
         bool needToFetch = !isRomMicroPC(pcState.microPC()) &&
                            !curMacroStaticInst;
-        if (needToFetch) {
+
+        // The rest of a decoded block needs neither fetch nor translation
+        const BlockCache::Inst *decoded = NULL;
+        if (needToFetch && blockCache)
+            decoded = blockCache->next(curThread, pcState);
+
+        if (needToFetch && !decoded) {
             ifetch_req.taskId(taskId());
             setupFetchRequest(&ifetch_req);
             fault = thread->itb->translateAtomic(&ifetch_req, thread->getTC(),
@@ -587,7 +696,19 @@ AtomicSimpleCPU::tick()
             bool icache_access = false;
             dcache_access = false; // assume no dcache access
 
-            if (needToFetch) {
+            if (needToFetch && !decoded && blockCache) {
+                if (t_info.fetchOffset == 0) {
+                    decoded = blockCache->lookup(curThread, pcState,
+                                                 ifetch_req.getVaddr(),
+                                                 ifetch_req.getPaddr());
+                }
+                if (!decoded) {
+                    blockCache->fetched(curThread, ifetch_req.getVaddr(),
+                                        ifetch_req.getPaddr());
+                }
+            }
+
+            if (needToFetch && !decoded) {
                 // This is commented out because the decoder would act like
                 // a tiny cache otherwise. It wouldn't be flushed when needed
                 // like the I cache. It should be flushed, and when that works
@@ -596,22 +717,45 @@ AtomicSimpleCPU::tick()
                 //if (decoder.needMoreBytes())
                 //{
                     icache_access = true;
-                    Packet ifetch_pkt = Packet(&ifetch_req, MemCmd::ReadReq);
-                    ifetch_pkt.dataStatic(&inst);
-
-                    if (fastmem && system->isMemAddr(ifetch_pkt.getAddr()))
-                        system->getPhysMem().access(&ifetch_pkt);
-                    else
-                        icache_latency = icachePort.sendAtomic(&ifetch_pkt);
-
-                    assert(!ifetch_pkt.isError());
+                    uint8_t *host = fastmem ?
+                        hostAddr(ifetch_req.getPaddr(), sizeof(inst), false) :
+                        NULL;
+
+                    if (host) {
+                        memcpy(&inst, host, sizeof(inst));
+                    } else {
+                        Packet ifetch_pkt = Packet(&ifetch_req,
+                                                   MemCmd::ReadReq);
+                        ifetch_pkt.dataStatic(&inst);
+
+                        if (fastmem &&
+                            system->isMemAddr(ifetch_pkt.getAddr()))
+                            system->getPhysMem().access(&ifetch_pkt);
+                        else
+                            icache_latency =
+                                icachePort.sendAtomic(&ifetch_pkt);
+
+                        assert(!ifetch_pkt.isError());
+                    }
 
                     // ifetch_req is initialized to read the instruction directly
                     // into the CPU object's inst field.
                 //}
             }
 
-            preExecute();
+            if (decoded) {
+                thread->pcState(decoded->decodedPC);
+                preExecute(decoded->staticInst);
+                numBlockCacheInsts++;
+            } else {
+                preExecute();
+
+                if (needToFetch && blockCache && !t_info.stayAtPC) {
+                    blockCache->record(curThread, pcState, thread->pcState(),
+                        curMacroStaticInst ? curMacroStaticInst :
+                                             curStaticInst);
+                }
+            }
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
@@ -635,6 +779,15 @@ AtomicSimpleCPU::tick()
                 }
 
                 postExecute();
+
+                // Instructions could decode differently after a mode
+                // change, which only serializing instructions can make
+                if (blockCache && (curStaticInst->isSerializeAfter() ||
+                                   curStaticInst->isIprAccess() ||
+                                   curStaticInst->isSquashAfter()) &&
+                    (FullSystem || !curStaticInst->isSyscall())) {
+                    blockCache->flush();
+                }
             }
 
             // @todo remove me after debugging with legion done
@@ -657,6 +810,10 @@ AtomicSimpleCPU::tick()
             }
 
         }
+        // Faults may change the mode too
+        if (fault != NoFault && blockCache)
+            blockCache->flush();
+
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
     }
@@ -672,6 +829,26 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+void
+AtomicSimpleCPU::regStats()
+{
+    BaseSimpleCPU::regStats();
+
+    if (!blockCache)
+        return;
+
+    numBlockCacheInsts
+        .name(name() + ".block_cache_insts")
+        .desc("Number of instructions issued from decoded blocks")
+        ;
+
+    numBlockCacheFlushes
+        .method(blockCache.get(), &BlockCache::numFlushes)
+        .name(name() + ".block_cache_flushes")
+        .desc("Number of times the decoded blocks were flushed")
+        ;
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
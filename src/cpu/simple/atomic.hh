@@ -43,12 +43,18 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+#include <vector>
+
 #include "cpu/simple/base.hh"
+#include "cpu/simple/block_cache.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
 #include "params/AtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
 
+class AbstractMemory;
+
 class AtomicSimpleCPU : public BaseSimpleCPU
 {
   public:
@@ -152,6 +158,8 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         virtual Tick recvAtomicSnoop(PacketPtr pkt);
         virtual void recvFunctionalSnoop(PacketPtr pkt);
+
+        friend class AtomicSimpleCPU;
     };
 
 
@@ -159,6 +167,43 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     AtomicCPUDPort dcachePort;
 
     bool fastmem;
+
+    /** A guest physical page and the host memory behind it */
+    struct HostPage
+    {
+        Addr page;
+        uint8_t *host;
+        /** The memory the page is in, if it is all in one */
+        AbstractMemory *mem;
+    };
+
+    /** Direct mapped cache of host pages for fastmem accesses */
+    static const unsigned numHostPages = 256;
+    std::vector<HostPage> hostPages;
+
+    /**
+     * Get a host pointer to access guest physical memory directly,
+     * bypassing the packet based access of the physical memory.
+     *
+     * @param write Whether this is a plain write, which is only done
+     * directly if the memory has no locked addresses to clear.
+     * @return The pointer, or NULL if a packet must be sent
+     */
+    uint8_t *hostAddr(Addr paddr, unsigned size, bool write);
+
+    /** Forget the host pages, e.g. after a checkpoint is restored. */
+    void flushHostPages();
+
+    /** All the atomic CPUs, which snoop each other's fastmem writes */
+    static std::vector<AtomicSimpleCPU *> allCPUs;
+
+    /**
+     * Have the other CPUs snoop a write that bypassed the memory system,
+     * as it would have, so that they clear their locks and drop the
+     * decoded blocks of the code it overwrites.
+     */
+    void fastmemWritten(PacketPtr pkt);
+
     Request ifetch_req;
     Request data_read_req;
     Request data_write_req;
@@ -166,6 +211,22 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     bool dcache_access;
     Tick dcache_latency;
 
+    /** Decoded blocks, if instructions are not fetched one by one */
+    std::unique_ptr<BlockCache> blockCache;
+
+    /** Flush the decoded blocks if code is written. */
+    void
+    codeWritten(Addr paddr, unsigned size)
+    {
+        if (blockCache)
+            blockCache->invalidate(paddr, size);
+    }
+
+    /** Number of instructions that were neither fetched nor decoded */
+    Stats::Scalar numBlockCacheInsts;
+    /** Number of times the decoded blocks were dropped */
+    Stats::Value numBlockCacheFlushes;
+
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>> *ppCommit;
 
@@ -204,6 +265,8 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     void regProbePoints() override;
 
+    void regStats() override;
+
     /**
      * Print state of address in memory system via PrintReq (for
      * debugging).
@@ -123,6 +123,9 @@ BaseSimpleCPU::BaseSimpleCPU(BaseSimpleCPUParams *p)
     } else {
         checker = NULL;
     }
+
+    if (branchPred)
+        branchPred->setCPU(this);
 }
 
 void
@@ -485,7 +488,7 @@ BaseSimpleCPU::setupFetchRequest(Request *req)
 
 
 void
-BaseSimpleCPU::preExecute()
+BaseSimpleCPU::preExecute(const StaticInstPtr &decoded_inst)
 {
     SimpleExecContext &t_info = *threadInfo[curThread];
     SimpleThread* thread = t_info.thread;
@@ -509,6 +512,16 @@ BaseSimpleCPU::preExecute()
         t_info.stayAtPC = false;
         curStaticInst = microcodeRom.fetchMicroop(pcState.microPC(),
                                                   curMacroStaticInst);
+    } else if (!curMacroStaticInst && decoded_inst) {
+        //The instruction was decoded before, skip fetch and decode
+        t_info.stayAtPC = false;
+        if (decoded_inst->isMacroop()) {
+            curMacroStaticInst = decoded_inst;
+            curStaticInst =
+                curMacroStaticInst->fetchMicroop(pcState.microPC());
+        } else {
+            curStaticInst = decoded_inst;
+        }
     } else if (!curMacroStaticInst) {
         //We're not in the middle of a macro instruction
         StaticInstPtr instPtr = NULL;
@@ -661,7 +674,7 @@ BaseSimpleCPU::postExecute()
     }
 
     // Call CPU instruction commit probes
-    probeInstCommit(curStaticInst);
+    probeInstCommit(curStaticInst, thread->contextId(), instAddr);
 }
 
 void
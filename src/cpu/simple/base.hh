@@ -130,7 +130,15 @@ class BaseSimpleCPU : public BaseCPU
 
     void checkForInterrupts();
     void setupFetchRequest(Request *req);
-    void preExecute();
+    /**
+     * Prepare the instruction at the current PC for execution.
+     *
+     * @param decoded_inst The instruction if it was decoded before, in
+     * which case the decoder is bypassed. The PC state must then be the
+     * one the decoder produced.
+     */
+    void preExecute(const StaticInstPtr &decoded_inst =
+                    StaticInst::nullStaticInstPtr);
     void postExecute();
     void advancePC(const Fault &fault);
 
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/block_cache.hh"
+
+#include "arch/isa_traits.hh"
+#include "base/intmath.hh"
+
+// Bound the memory used by the blocks of many address spaces
+static const size_t maxBlocks = 1 << 16;
+
+BlockCache::BlockCache(ThreadID num_threads)
+    : threads(num_threads), flushes(0)
+{
+}
+
+const BlockCache::Inst *
+BlockCache::next(ThreadID tid, const TheISA::PCState &pc)
+{
+    ThreadState &thread = threads[tid];
+
+    if (thread.replay && thread.replayPos < thread.replay->insts.size()) {
+        const Inst &inst = thread.replay->insts[thread.replayPos];
+        if (inst.fetchPC == pc) {
+            ++thread.replayPos;
+            return &inst;
+        }
+    }
+
+    thread.replay = NULL;
+    return NULL;
+}
+
+const BlockCache::Inst *
+BlockCache::lookup(ThreadID tid, const TheISA::PCState &pc,
+                   Addr fetch_vaddr, Addr fetch_paddr)
+{
+    ThreadState &thread = threads[tid];
+    thread.replay = NULL;
+
+    auto it = blocks.find(pc.instAddr());
+    if (it != blocks.end() && it->second.paddr == fetch_paddr &&
+        it->second.insts[0].fetchPC == pc) {
+        const Block *block = &it->second;
+
+        if (thread.recording) {
+            if (thread.recordStart == pc.instAddr()) {
+                // Another thread recorded the same block meanwhile
+                thread.recording = false;
+                thread.building.insts.clear();
+            } else {
+                commit(thread);
+            }
+        }
+
+        thread.replay = block;
+        thread.replayPos = 1;
+        return &block->insts[0];
+    }
+
+    // Carry on with the block being recorded while the instructions are
+    // fetched from the same page, or start a new one
+    if (thread.recording) {
+        thread.crossedPage = false;
+        fetched(tid, fetch_vaddr, fetch_paddr);
+        if (thread.crossedPage)
+            commit(thread);
+    }
+
+    if (!thread.recording) {
+        if (blocks.size() >= maxBlocks)
+            flush();
+
+        thread.recording = true;
+        thread.recordStart = pc.instAddr();
+        thread.recordVaddr = fetch_vaddr;
+        thread.recordPaddr = fetch_paddr;
+        thread.building.paddr = fetch_paddr;
+        thread.building.insts.clear();
+    }
+    thread.crossedPage = false;
+
+    return NULL;
+}
+
+void
+BlockCache::fetched(ThreadID tid, Addr fetch_vaddr, Addr fetch_paddr)
+{
+    ThreadState &thread = threads[tid];
+
+    if (!thread.recording)
+        return;
+
+    if (roundDown(fetch_vaddr, TheISA::PageBytes) !=
+        roundDown(thread.recordVaddr, TheISA::PageBytes) ||
+        fetch_paddr - fetch_vaddr !=
+        thread.recordPaddr - thread.recordVaddr) {
+        thread.crossedPage = true;
+    }
+}
+
+void
+BlockCache::record(ThreadID tid, const TheISA::PCState &fetch_pc,
+                   const TheISA::PCState &decoded_pc,
+                   const StaticInstPtr &inst)
+{
+    ThreadState &thread = threads[tid];
+
+    if (!thread.recording)
+        return;
+
+    // An instruction that is partly on another page ends the block
+    // without being part of it
+    if (thread.crossedPage) {
+        commit(thread);
+        return;
+    }
+
+    Inst block_inst;
+    block_inst.fetchPC = fetch_pc;
+    block_inst.decodedPC = decoded_pc;
+    block_inst.staticInst = inst;
+    thread.building.insts.push_back(block_inst);
+
+    if (inst->isControl() || inst->isSerializing() ||
+        inst->isNonSpeculative() || inst->isSquashAfter() ||
+        thread.building.insts.size() >= maxBlockInsts) {
+        commit(thread);
+    }
+}
+
+void
+BlockCache::commit(ThreadState &thread)
+{
+    thread.recording = false;
+    if (thread.building.insts.empty())
+        return;
+
+    Block block;
+    std::swap(block, thread.building);
+
+    // Nobody may go on replaying a block that is replaced
+    auto it = blocks.find(thread.recordStart);
+    if (it != blocks.end()) {
+        for (auto &t : threads) {
+            if (t.replay == &it->second)
+                t.replay = NULL;
+        }
+    }
+
+    codePages.insert(roundDown(block.paddr, TheISA::PageBytes));
+    blocks[thread.recordStart] = std::move(block);
+}
+
+void
+BlockCache::invalidate(Addr paddr, unsigned size)
+{
+    if (codePages.empty())
+        return;
+
+    Addr last = roundDown(paddr + size - 1, TheISA::PageBytes);
+    for (Addr page = roundDown(paddr, TheISA::PageBytes); page <= last;
+         page += TheISA::PageBytes) {
+        if (codePages.count(page)) {
+            flush();
+            return;
+        }
+    }
+}
+
+void
+BlockCache::flush()
+{
+    blocks.clear();
+    codePages.clear();
+
+    for (auto &thread : threads) {
+        thread.replay = NULL;
+        thread.recording = false;
+        thread.building.insts.clear();
+    }
+
+    ++flushes;
+}
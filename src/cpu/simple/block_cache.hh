@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_BLOCK_CACHE_HH__
+#define __CPU_SIMPLE_BLOCK_CACHE_HH__
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "arch/types.hh"
+#include "base/types.hh"
+#include "cpu/static_inst.hh"
+
+/**
+ * A cache of decoded basic blocks for the atomic CPU.
+ *
+ * Blocks are recorded as the CPU fetches and decodes instructions, and
+ * are keyed by the virtual address of their first instruction. All the
+ * instructions of a block are fetched from the same page, so translating
+ * the fetch of the first instruction is enough to tell whether a block
+ * still maps to the memory it was decoded from. The instructions that
+ * follow are handed out as long as the PC of the thread matches the PC
+ * they were decoded at, without fetching or decoding them again.
+ *
+ * The cache has to be flushed whenever instructions could decode
+ * differently, e.g. on a mode change, and when code is written.
+ */
+class BlockCache
+{
+  public:
+    /** A decoded instruction of a block */
+    struct Inst
+    {
+        /** The PC state the instruction was fetched at */
+        TheISA::PCState fetchPC;
+        /** The PC state as updated by the decoder */
+        TheISA::PCState decodedPC;
+        /** The decoded instruction, possibly a macroop */
+        StaticInstPtr staticInst;
+    };
+
+    /** Maximum number of instructions in a block */
+    static const unsigned maxBlockInsts = 64;
+
+    BlockCache(ThreadID num_threads);
+
+    /**
+     * Get the next instruction of the block a thread is executing.
+     *
+     * @return The instruction, or NULL if the thread left the block.
+     */
+    const Inst *next(ThreadID tid, const TheISA::PCState &pc);
+
+    /**
+     * Look up the block starting at a PC. On a miss, a new block is
+     * recorded from the instructions the thread decodes next.
+     *
+     * @param fetch_vaddr Virtual address of the first instruction fetch.
+     * @param fetch_paddr Physical address of the first instruction fetch.
+     * @return The first instruction of the block, or NULL on a miss.
+     */
+    const Inst *lookup(ThreadID tid, const TheISA::PCState &pc,
+                       Addr fetch_vaddr, Addr fetch_paddr);
+
+    /** Note an instruction fetch of a thread that is recording a block. */
+    void fetched(ThreadID tid, Addr fetch_vaddr, Addr fetch_paddr);
+
+    /** Add an instruction decoded by a thread to the block it records. */
+    void record(ThreadID tid, const TheISA::PCState &fetch_pc,
+                const TheISA::PCState &decoded_pc,
+                const StaticInstPtr &inst);
+
+    /** Flush the cache if a physical address range holds code. */
+    void invalidate(Addr paddr, unsigned size);
+
+    /** Drop all the blocks. */
+    void flush();
+
+    /** Number of times the cache was flushed */
+    Counter numFlushes() const { return flushes; }
+
+  private:
+    struct Block
+    {
+        /** Physical address of the first instruction fetch */
+        Addr paddr;
+        std::vector<Inst> insts;
+    };
+
+    struct ThreadState
+    {
+        ThreadState()
+            : replay(NULL), replayPos(0), recording(false), recordStart(0),
+              recordVaddr(0), recordPaddr(0), crossedPage(false)
+        {}
+
+        /** Block being executed and the position of its next instruction */
+        const Block *replay;
+        size_t replayPos;
+
+        /** Block being recorded, its PC and where its first fetch was */
+        bool recording;
+        Addr recordStart;
+        Addr recordVaddr;
+        Addr recordPaddr;
+        Block building;
+        /** The instruction being fetched is not all in the block page */
+        bool crossedPage;
+    };
+
+    /** Add the block a thread records to the cache. */
+    void commit(ThreadState &thread);
+
+    /** Blocks by the virtual address of their first instruction */
+    std::unordered_map<Addr, Block> blocks;
+    /** Physical pages the blocks are decoded from */
+    std::unordered_set<Addr> codePages;
+
+    std::vector<ThreadState> threads;
+
+    Counter flushes;
+};
+
+#endif // __CPU_SIMPLE_BLOCK_CACHE_HH__
@@ -0,0 +1,60 @@
+# Copyright (c) 2026
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.SimObject import SimObject
+
+class LoopPoint(SimObject):
+    """Probe selecting regions of multi-threaded programs, delimited by
+    the number of times loop headers were run by all the threads."""
+
+    type = 'LoopPoint'
+    cxx_header = "cpu/simple/probes/looppoint.hh"
+
+    cpus = VectorParam.BaseCPU("CPUs running the threads of the program")
+    switch_cpus = VectorParam.BaseCPU([], "CPUs the threads are switched "
+                                      "to, if any")
+
+    region_length = Param.UInt64(800000000, "Approximate number of insts "
+                                 "of all the threads in a region")
+
+    # Markers are either the given PCs, or the targets of the backward
+    # branches taken within the given code, e.g. the text of the program
+    # without the synchronisation libraries
+    marker_pcs = VectorParam.Addr([], "Loop header PCs to use as markers")
+    marker_ranges = VectorParam.AddrRange([], "Code to take the loop "
+                                          "headers from, all if empty")
+
+    # Exit the simulation loop when a marker is run for the given time,
+    # e.g. to take a checkpoint at the start of a region or to end its
+    # simulation
+    exit_pcs = VectorParam.Addr([], "PCs of the markers to exit at")
+    exit_counts = VectorParam.UInt64([], "Counts of the markers to exit at")
+
+    profile_file = Param.String("looppoint.bb.gz", "BBV (output) file of "
+                                "the regions, empty for none")
+    regions_file = Param.String("looppoint.regions", "Region boundary "
+                                "(output) file, empty for none")
@@ -45,4 +45,28 @@ class SimPoint(ProbeListenerObject):
     cxx_header = "cpu/simple/probes/simpoint.hh"
 
     interval = Param.UInt64(100000000, "Interval Size (insts)")
-    profile_file = Param.String("simpoint.bb.gz", "BBV (output) file")
+    profile_file = Param.String("simpoint.bb.gz",
+                                "BBV (output) file, empty for none")
+
+    # The BBVs can be reduced to a few dimensions by random projection,
+    # like the SimPoint tool does before clustering them. The projected
+    # vectors are small enough to be kept and clustered at the end of the
+    # simulation, which spares writing out and post-processing the BBVs.
+    projection_dims = Param.Unsigned(15, "Dimensions of the randomly "
+                                     "projected BBVs")
+    projection_file = Param.String("", "Projected BBV (output) file, "
+                                   "which 'simpoint -loadVectorsTxtFmt' "
+                                   "reads, empty for none")
+    seed = Param.UInt32(2042712918, "Seed of the random projection and "
+                        "of the clustering")
+
+    max_k = Param.Unsigned(0, "Maximum number of clusters of the "
+                           "projected BBVs, 0 to not cluster them")
+    num_init_seeds = Param.Unsigned(5, "Number of clusterings tried for "
+                                    "each number of clusters")
+    bic_threshold = Param.Float(0.9, "Pick the fewest clusters scoring "
+                                "this fraction of the BIC range")
+    # The names of the SimPoint and weight files are prefixed with the name
+    # of the probe, e.g. system.cpu.probeListener.simpoints
+    simpoints_file = Param.String("simpoints", "SimPoint (output) file")
+    weights_file = Param.String("weights", "SimPoint weight (output) file")
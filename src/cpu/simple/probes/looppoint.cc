@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/probes/looppoint.hh"
+
+#include <algorithm>
+
+#include "base/callback.hh"
+#include "sim/core.hh"
+#include "sim/sim_exit.hh"
+
+LoopPoint::LoopPoint(const LoopPointParams *p)
+    : SimObject(p),
+      cpus(p->cpus),
+      switchCPUs(p->switch_cpus),
+      regionLength(p->region_length),
+      markerPCs(p->marker_pcs.begin(), p->marker_pcs.end()),
+      markerRanges(p->marker_ranges),
+      numSlots(0),
+      profileStream(NULL),
+      regionsStream(NULL),
+      globalInsts(0),
+      regionStartInsts(0),
+      region(0),
+      regionStart(0, 0)
+{
+    fatal_if(p->exit_pcs.size() != p->exit_counts.size(),
+             "%s: exit_pcs and exit_counts must have the same size\n",
+             name());
+    for (size_t i = 0; i < p->exit_pcs.size(); ++i)
+        exitMarkers[p->exit_pcs[i]].insert(p->exit_counts[i]);
+
+    for (auto cpu : cpus)
+        numSlots += cpu->numThreads;
+
+    if (!p->profile_file.empty()) {
+        profileStream = simout.create(p->profile_file, false);
+        if (!profileStream)
+            fatal("unable to open LoopPoint profile_file");
+    }
+
+    if (!p->regions_file.empty()) {
+        regionsStream = simout.create(p->regions_file, false);
+        if (!regionsStream)
+            fatal("unable to open LoopPoint regions_file");
+        *regionsStream->stream() << "# region start_pc start_count "
+            "end_pc end_count insts\n";
+    }
+
+    // The last region ends with the simulation
+    registerExitCallback(new MakeCallback<LoopPoint, &LoopPoint::finish>(
+                             this));
+}
+
+LoopPoint::~LoopPoint()
+{
+    if (profileStream)
+        simout.close(profileStream);
+    if (regionsStream)
+        simout.close(regionsStream);
+}
+
+void
+LoopPoint::regProbeListeners()
+{
+    for (auto cpu : cpus) {
+        listeners.emplace_back(
+            new CommitListener(*this, cpu->getProbeManager()));
+    }
+    for (auto cpu : switchCPUs) {
+        listeners.emplace_back(
+            new CommitListener(*this, cpu->getProbeManager()));
+    }
+}
+
+bool
+LoopPoint::isMarker(Addr pc, bool backward) const
+{
+    if (!markerPCs.empty())
+        return markerPCs.count(pc);
+
+    // Take the targets of backward branches as loop headers
+    if (!backward)
+        return false;
+    if (markerRanges.empty())
+        return true;
+    for (const auto &range : markerRanges) {
+        if (range.contains(pc))
+            return true;
+    }
+    return false;
+}
+
+void
+LoopPoint::profile(const CommitArg &p)
+{
+    const StaticInstPtr &inst = p.inst;
+
+    if (inst->isMicroop() && !inst->isLastMicroop())
+        return;
+
+    auto thread_itr = threads.find(p.contextId);
+    if (thread_itr == threads.end()) {
+        panic_if(threads.size() == numSlots,
+                 "%s: More threads than thread contexts\n", name());
+        thread_itr = threads.emplace(p.contextId, ThreadState()).first;
+        thread_itr->second.slot = threads.size() - 1;
+    }
+    ThreadState &state = thread_itr->second;
+
+    const Addr pc = p.pc;
+    const bool backward = state.lastControl && pc <= state.lastPC;
+    state.lastPC = pc;
+    state.lastControl = inst->isControl();
+
+    // A marker starts the next region, before the inst is counted
+    if (isMarker(pc, backward))
+        hitMarker(pc);
+
+    ++globalInsts;
+
+    if (!state.bbInsts)
+        state.bb.first = pc;
+    ++state.bbInsts;
+
+    // If inst is control inst, assume end of basic block, like SimPoint
+    if (inst->isControl()) {
+        state.bb.second = pc;
+        auto id_itr = bbIds.find(state.bb);
+        if (id_itr == bbIds.end())
+            id_itr = bbIds.emplace(state.bb, bbIds.size() + 1).first;
+        state.counts[id_itr->second] += state.bbInsts;
+        state.bbInsts = 0;
+    }
+}
+
+void
+LoopPoint::hitMarker(Addr pc)
+{
+    const uint64_t count = ++markerCounts[pc];
+
+    if (globalInsts - regionStartInsts >= regionLength)
+        endRegion(Marker(pc, count));
+
+    auto exit_itr = exitMarkers.find(pc);
+    if (exit_itr != exitMarkers.end() && exit_itr->second.count(count))
+        exitSimLoop("looppoint marker reached");
+}
+
+void
+LoopPoint::endRegion(const Marker &end)
+{
+    // Lay the BBVs of the threads side by side, interleaved so that
+    // the BB ids seen later do not need to be known in advance
+    std::vector<std::pair<uint64_t, uint64_t>> counts;
+    for (auto &thread : threads) {
+        ThreadState &state = thread.second;
+        for (const auto &count : state.counts) {
+            counts.push_back(std::make_pair(
+                (count.first - 1) * numSlots + state.slot + 1,
+                count.second));
+        }
+        state.counts.clear();
+    }
+    std::sort(counts.begin(), counts.end());
+
+    if (profileStream) {
+        std::ostream &os = *profileStream->stream();
+        os << "T";
+        for (const auto &count : counts)
+            os << ":" << count.first << ":" << count.second << " ";
+        os << "\n";
+    }
+
+    if (regionsStream) {
+        ccprintf(*regionsStream->stream(), "%d %#x %d %#x %d %d\n",
+                 region, regionStart.first, regionStart.second,
+                 end.first, end.second, globalInsts - regionStartInsts);
+    }
+
+    ++region;
+    regionStart = end;
+    regionStartInsts = globalInsts;
+}
+
+void
+LoopPoint::finish()
+{
+    // The last region has no end marker
+    if (globalInsts != regionStartInsts)
+        endRegion(Marker(0, 0));
+
+    if (profileStream)
+        profileStream->stream()->flush();
+    if (regionsStream)
+        regionsStream->stream()->flush();
+}
+
+void
+LoopPoint::serialize(CheckpointOut &cp) const
+{
+    std::vector<Addr> marker_pcs;
+    std::vector<uint64_t> marker_counts;
+    for (const auto &marker : markerCounts) {
+        marker_pcs.push_back(marker.first);
+        marker_counts.push_back(marker.second);
+    }
+
+    SERIALIZE_CONTAINER(marker_pcs);
+    SERIALIZE_CONTAINER(marker_counts);
+    SERIALIZE_SCALAR(globalInsts);
+    SERIALIZE_SCALAR(region);
+    paramOut(cp, "region_start_pc", regionStart.first);
+    paramOut(cp, "region_start_count", regionStart.second);
+}
+
+void
+LoopPoint::unserialize(CheckpointIn &cp)
+{
+    std::vector<Addr> marker_pcs;
+    std::vector<uint64_t> marker_counts;
+    UNSERIALIZE_CONTAINER(marker_pcs);
+    UNSERIALIZE_CONTAINER(marker_counts);
+    UNSERIALIZE_SCALAR(globalInsts);
+    UNSERIALIZE_SCALAR(region);
+    paramIn(cp, "region_start_pc", regionStart.first);
+    paramIn(cp, "region_start_count", regionStart.second);
+
+    markerCounts.clear();
+    for (size_t i = 0; i < marker_pcs.size(); ++i)
+        markerCounts[marker_pcs[i]] = marker_counts[i];
+
+    // Profiling carries on with a new region
+    regionStartInsts = globalInsts;
+}
+
+LoopPoint*
+LoopPointParams::create()
+{
+    return new LoopPoint(this);
+}
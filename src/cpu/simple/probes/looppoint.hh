@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_PROBES_LOOPPOINT_HH__
+#define __CPU_SIMPLE_PROBES_LOOPPOINT_HH__
+
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/output.hh"
+#include "cpu/base.hh"
+#include "cpu/simple/probes/simpoint.hh"
+#include "params/LoopPoint.hh"
+#include "sim/probe/probe.hh"
+#include "sim/serialize.hh"
+#include "sim/sim_object.hh"
+
+/**
+ * Probe for LoopPoint style region selection of multi-threaded programs.
+ *
+ * The probe listens to the committed instructions of all the CPUs that
+ * run the threads of a program, and of the CPUs they are switched to. The execution is split into regions of
+ * roughly a given number of instructions of all the threads together.
+ * As the threads run at different paces, regions are not delimited by
+ * instruction counts but by markers: the number of times a loop header
+ * was executed by all the threads. Markers are the same from one run to
+ * the next, as long as the loops do not depend on the timing of the
+ * threads, which is why the loops of e.g. synchronisation libraries
+ * should be left out by restricting the markers to the code of the
+ * program.
+ *
+ * The probe writes a BBV per region, made of the BBVs of all the threads,
+ * which the SimPoint tool can cluster, and the markers delimiting the
+ * regions. The simulation loop can also be exited at given markers, to
+ * take checkpoints at the start of the regions of interest and to end
+ * their simulation. The marker counts are checkpointed, so that a region
+ * can be simulated from a checkpoint taken at its start, with any CPU
+ * model.
+ */
+class LoopPoint : public SimObject
+{
+  public:
+    /** Argument of the committed instruction probe point of the CPUs */
+    typedef BaseCPU::CommittedInst CommitArg;
+
+    LoopPoint(const LoopPointParams *params);
+    ~LoopPoint();
+
+    void regProbeListeners() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+    /** Note an instruction committed by a thread. */
+    void profile(const CommitArg &p);
+
+    /** Write the last region. Called when the simulation exits. */
+    void finish();
+
+  private:
+    /** Listener of the committed instructions of a CPU */
+    class CommitListener : public ProbeListenerArgBase<CommitArg>
+    {
+      public:
+        CommitListener(LoopPoint &_parent, ProbeManager *manager)
+            : ProbeListenerArgBase<CommitArg>(manager, "CommittedInst"),
+              parent(_parent)
+        {}
+
+        void notify(const CommitArg &arg) override { parent.profile(arg); }
+
+      private:
+        LoopPoint &parent;
+    };
+
+    /** A marker: a loop header, and the number of times it was run */
+    typedef std::pair<Addr, uint64_t> Marker;
+
+    /** Profiling state of a thread */
+    struct ThreadState
+    {
+        ThreadState()
+            : slot(0), lastPC(0), lastControl(false), bbInsts(0)
+        {}
+
+        /** Position of the thread's BBV in the BBV of a region */
+        unsigned slot;
+        /** PC of the last instruction, and whether it was a branch */
+        Addr lastPC;
+        bool lastControl;
+        /** Basic block being executed and its inst count so far */
+        BasicBlockRange bb;
+        uint64_t bbInsts;
+        /** Insts executed by each BB in the region, by BB id */
+        std::unordered_map<uint64_t, uint64_t> counts;
+    };
+
+    /** Whether a PC is a marker, given it was branched back to */
+    bool isMarker(Addr pc, bool backward) const;
+
+    /** Count a marker, ending the region or the simulation loop. */
+    void hitMarker(Addr pc);
+
+    /** Write the BBV and the boundaries of the region ending. */
+    void endRegion(const Marker &end);
+
+    /** CPUs running the threads of the program, and the CPUs the
+     *  threads may be switched to */
+    const std::vector<BaseCPU *> cpus;
+    const std::vector<BaseCPU *> switchCPUs;
+    std::vector<std::unique_ptr<CommitListener>> listeners;
+
+    /** Approximate number of insts of all the threads in a region */
+    const uint64_t regionLength;
+
+    /** Explicit markers, if any */
+    const std::unordered_set<Addr> markerPCs;
+    /** Code the loop headers found on the fly are taken from */
+    const std::vector<AddrRange> markerRanges;
+
+    /** Markers to exit the simulation loop at */
+    std::unordered_map<Addr, std::set<uint64_t>> exitMarkers;
+
+    /** Number of thread contexts of all the CPUs */
+    unsigned numSlots;
+
+    /** Output streams for the BBVs and region boundaries, if any */
+    OutputStream *profileStream;
+    OutputStream *regionsStream;
+
+    /** Ids of the basic blocks seen so far, shared by all threads */
+    std::unordered_map<BasicBlockRange, uint64_t> bbIds;
+
+    /** Profiling state by thread context id */
+    std::unordered_map<ContextID, ThreadState> threads;
+
+    /** Times each marker was executed by all the threads */
+    std::unordered_map<Addr, uint64_t> markerCounts;
+
+    /** Insts of all the threads so far, and when the region started */
+    uint64_t globalInsts;
+    uint64_t regionStartInsts;
+
+    /** Index of the current region and the marker it started at */
+    uint64_t region;
+    Marker regionStart;
+};
+
+#endif // __CPU_SIMPLE_PROBES_LOOPPOINT_HH__
@@ -40,7 +40,11 @@
 
 #include "cpu/simple/probes/simpoint.hh"
 
+#include <algorithm>
+
+#include "base/callback.hh"
 #include "base/output.hh"
+#include "sim/core.hh"
 
 SimPoint::SimPoint(const SimPointParams *p)
     : ProbeListenerObject(p),
@@ -48,17 +52,47 @@ SimPoint::SimPoint(const SimPointParams *p)
       intervalCount(0),
       intervalDrift(0),
       simpointStream(NULL),
+      projectionStream(NULL),
+      project(!p->projection_file.empty() || p->max_k != 0),
+      clusterer(p->projection_dims, p->seed),
+      maxK(p->max_k),
+      numInitSeeds(p->num_init_seeds),
+      bicThreshold(p->bic_threshold),
+      // Several CPUs may be profiled, so the files are named after the
+      // probe
+      simpointsFile(name() + "." + p->simpoints_file),
+      weightsFile(name() + "." + p->weights_file),
       currentBBV(0, 0),
       currentBBVInstCount(0)
 {
-    simpointStream = simout.create(p->profile_file, false);
-    if (!simpointStream)
-        fatal("unable to open SimPoint profile_file");
+    if (!p->profile_file.empty()) {
+        simpointStream = simout.create(p->profile_file, false);
+        if (!simpointStream)
+            fatal("unable to open SimPoint profile_file");
+    }
+
+    fatal_if(project && p->projection_dims == 0,
+             "SimPoint projection_dims must be at least 1\n");
+
+    if (!p->projection_file.empty()) {
+        projectionStream = simout.create(p->projection_file, false);
+        if (!projectionStream)
+            fatal("unable to open SimPoint projection_file");
+    }
+
+    // There is no telling when profiling ends, so the intervals are
+    // clustered as the simulation exits
+    if (maxK != 0)
+        registerExitCallback(new MakeCallback<SimPoint, &SimPoint::cluster>(
+                                 this));
 }
 
 SimPoint::~SimPoint()
 {
-    simout.close(simpointStream);
+    if (simpointStream)
+        simout.close(simpointStream);
+    if (projectionStream)
+        simout.close(projectionStream);
 }
 
 void
@@ -101,6 +135,8 @@ SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
             info.id = bbMap.size() + 1;
             info.insts = currentBBVInstCount;
             info.count = currentBBVInstCount;
+            if (project)
+                info.projection = clusterer.column();
             bbMap.insert(std::make_pair(currentBBV, info));
         } else {
             // If basic block is seen before, just increment the count by the
@@ -114,26 +150,7 @@ SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
         // (intervalCount) and the excessive inst count from the previous
         // interval (intervalDrift) is greater than/equal to the interval size.
         if (intervalCount + intervalDrift >= intervalSize) {
-            // summarize interval and display BBV info
-            std::vector<std::pair<uint64_t, uint64_t> > counts;
-            for (auto map_itr = bbMap.begin(); map_itr != bbMap.end();
-                    ++map_itr) {
-                BBInfo& info = map_itr->second;
-                if (info.count != 0) {
-                    counts.push_back(std::make_pair(info.id, info.count));
-                    info.count = 0;
-                }
-            }
-            std::sort(counts.begin(), counts.end());
-
-            // Print output BBV info
-            *simpointStream->stream() << "T";
-            for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
-                    ++cnt_itr) {
-                *simpointStream->stream() << ":" << cnt_itr->first
-                                << ":" << cnt_itr->second << " ";
-            }
-            *simpointStream->stream() << "\n";
+            endInterval();
 
             intervalDrift = (intervalCount + intervalDrift) - intervalSize;
             intervalCount = 0;
@@ -141,6 +158,78 @@ SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
     }
 }
 
+void
+SimPoint::endInterval()
+{
+    // summarize interval and display BBV info
+    std::vector<std::pair<uint64_t, uint64_t> > counts;
+    std::vector<std::pair<const SimPointClusterer::Vector *, uint64_t>> bbv;
+    for (auto map_itr = bbMap.begin(); map_itr != bbMap.end(); ++map_itr) {
+        BBInfo& info = map_itr->second;
+        if (info.count != 0) {
+            counts.push_back(std::make_pair(info.id, info.count));
+            if (project)
+                bbv.push_back(std::make_pair(&info.projection, info.count));
+            info.count = 0;
+        }
+    }
+
+    // Print output BBV info
+    if (simpointStream) {
+        std::sort(counts.begin(), counts.end());
+
+        *simpointStream->stream() << "T";
+        for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
+                ++cnt_itr) {
+            *simpointStream->stream() << ":" << cnt_itr->first
+                            << ":" << cnt_itr->second << " ";
+        }
+        *simpointStream->stream() << "\n";
+    }
+
+    if (!project)
+        return;
+
+    SimPointClusterer::Vector vector = clusterer.project(bbv);
+
+    if (projectionStream) {
+        std::ostream &os = *projectionStream->stream();
+        for (unsigned i = 0; i < vector.size(); ++i)
+            os << (i ? " " : "") << vector[i];
+        os << "\n";
+    }
+
+    if (maxK != 0)
+        clusterer.add(std::move(vector));
+}
+
+void
+SimPoint::cluster()
+{
+    if (!clusterer.size()) {
+        warn("%s: No complete interval to pick SimPoints from\n", name());
+        return;
+    }
+
+    auto picks = clusterer.pick(maxK, numInitSeeds, bicThreshold);
+
+    OutputStream *simpoints = simout.create(simpointsFile, false);
+    OutputStream *weights = simout.create(weightsFile, false);
+    if (!simpoints || !weights)
+        fatal("unable to open SimPoint simpoints_file or weights_file");
+
+    for (const auto &pick : picks) {
+        *simpoints->stream() << pick.interval << " " << pick.cluster << "\n";
+        *weights->stream() << pick.weight << " " << pick.cluster << "\n";
+    }
+
+    simout.close(simpoints);
+    simout.close(weights);
+
+    inform("%s: Picked %d SimPoints out of %d intervals\n", name(),
+           picks.size(), clusterer.size());
+}
+
 /** SimPoint SimObject */
 SimPoint*
 SimPointParams::create()
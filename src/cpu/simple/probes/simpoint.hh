@@ -42,14 +42,22 @@
 #define __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 
 #include <unordered_map>
+#include <vector>
 
 #include "base/output.hh"
+#include "cpu/simple/probes/simpoint_cluster.hh"
 #include "cpu/simple_thread.hh"
 #include "params/SimPoint.hh"
 #include "sim/probe/probe.hh"
 
 /**
  * Probe for SimPoints BBV generation
+ *
+ * Besides writing out the BBVs, the probe can reduce them to a few
+ * dimensions by random projection and cluster the projected vectors
+ * with k-means when the simulation ends, picking the number of clusters
+ * by their BIC score. This is what the SimPoint tool does, and produces
+ * its simpoints and weights files without writing the BBVs.
  */
 
 /**
@@ -89,7 +97,16 @@ class SimPoint : public ProbeListenerObject
      */
     void profile(const std::pair<SimpleThread*, StaticInstPtr>&);
 
+    /**
+     * Cluster the projected BBVs and write the SimPoints and their
+     * weights. Called when the simulation exits.
+     */
+    void cluster();
+
   private:
+    /** Write the BBV of an interval and its projection. */
+    void endInterval();
+
     /** SimPoint profiling interval size in instructions */
     const uint64_t intervalSize;
 
@@ -100,6 +117,20 @@ class SimPoint : public ProbeListenerObject
     /** Pointer to SimPoint BBV output stream */
     OutputStream *simpointStream;
 
+    /** Pointer to the projected BBV output stream */
+    OutputStream *projectionStream;
+    /** Whether the BBVs are projected, to be written or clustered */
+    const bool project;
+    /** Projection of the BBVs, and clustering of the projected ones */
+    SimPointClusterer clusterer;
+
+    /** Clustering parameters, see the Python object */
+    const unsigned maxK;
+    const unsigned numInitSeeds;
+    const double bicThreshold;
+    const std::string simpointsFile;
+    const std::string weightsFile;
+
     /** Basic Block information */
     struct BBInfo {
         /** Unique ID */
@@ -108,6 +139,8 @@ class SimPoint : public ProbeListenerObject
         uint64_t insts;
         /** Accumulated dynamic inst count executed by BB */
         uint64_t count;
+        /** Column of the projection matrix for the BB */
+        SimPointClusterer::Vector projection;
     };
 
     /** Hash table containing all previously seen basic blocks */
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/probes/simpoint_cluster.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SimPointClusterer::SimPointClusterer(unsigned dims, uint32_t _seed)
+    : numDims(dims), seed(_seed), projectionRng(_seed)
+{
+}
+
+SimPointClusterer::Vector
+SimPointClusterer::column()
+{
+    Vector column(numDims);
+    for (auto &entry : column)
+        entry = 2 * projectionRng.random<double>() - 1;
+    return column;
+}
+
+SimPointClusterer::Vector
+SimPointClusterer::project(
+    const std::vector<std::pair<const Vector *, uint64_t>> &bbv) const
+{
+    // Project the BBV as is, and normalise it after, like the SimPoint
+    // tool
+    Vector vector(numDims, 0.0);
+    uint64_t total = 0;
+    for (const auto &bb : bbv) {
+        for (unsigned i = 0; i < numDims; ++i)
+            vector[i] += bb.second * (*bb.first)[i];
+        total += bb.second;
+    }
+
+    if (total) {
+        for (auto &value : vector)
+            value /= total;
+    }
+    return vector;
+}
+
+double
+SimPointClusterer::distance(const Vector &a, const Vector &b)
+{
+    double sum = 0;
+    for (unsigned i = 0; i < a.size(); ++i)
+        sum += (a[i] - b[i]) * (a[i] - b[i]);
+    return sum;
+}
+
+void
+SimPointClusterer::kmeans(unsigned k, Random &rng,
+                          Clustering &clustering) const
+{
+    const size_t n = vectors.size();
+    auto &centers = clustering.centers;
+    auto &assignment = clustering.assignment;
+
+    // Pick the first centroid at random, and each next one with a
+    // probability proportional to the squared distance to the closest
+    // centroid so far
+    centers.assign(1, vectors[rng.random<size_t>(0, n - 1)]);
+    std::vector<double> closest(n);
+    for (size_t i = 0; i < n; ++i)
+        closest[i] = distance(vectors[i], centers[0]);
+    while (centers.size() < k) {
+        double sum = 0;
+        for (auto d : closest)
+            sum += d;
+        if (sum == 0)
+            break;
+
+        double target = rng.random<double>() * sum;
+        size_t pick = 0;
+        while (pick < n - 1 && target >= closest[pick])
+            target -= closest[pick++];
+
+        centers.push_back(vectors[pick]);
+        for (size_t i = 0; i < n; ++i)
+            closest[i] = std::min(closest[i],
+                                  distance(vectors[i], centers.back()));
+    }
+
+    // Refine the clusters until no interval moves
+    const unsigned max_iterations = 100;
+    assignment.assign(n, 0);
+    for (unsigned iter = 0; iter < max_iterations; ++iter) {
+        bool moved = false;
+        for (size_t i = 0; i < n; ++i) {
+            unsigned best = 0;
+            double best_distance = std::numeric_limits<double>::max();
+            for (unsigned c = 0; c < centers.size(); ++c) {
+                double d = distance(vectors[i], centers[c]);
+                if (d < best_distance) {
+                    best = c;
+                    best_distance = d;
+                }
+            }
+            moved |= iter == 0 || assignment[i] != best;
+            assignment[i] = best;
+        }
+
+        if (!moved)
+            break;
+
+        // Move the centroids to the mean of their intervals, leaving
+        // those of empty clusters where they are
+        std::vector<Vector> sums(centers.size(), Vector(numDims, 0.0));
+        std::vector<size_t> sizes(centers.size(), 0);
+        for (size_t i = 0; i < n; ++i) {
+            for (unsigned d = 0; d < numDims; ++d)
+                sums[assignment[i]][d] += vectors[i][d];
+            ++sizes[assignment[i]];
+        }
+        for (unsigned c = 0; c < centers.size(); ++c) {
+            if (sizes[c] == 0)
+                continue;
+            for (unsigned d = 0; d < numDims; ++d)
+                centers[c][d] = sums[c][d] / sizes[c];
+        }
+    }
+
+    clustering.distortion = 0;
+    for (size_t i = 0; i < n; ++i)
+        clustering.distortion += distance(vectors[i],
+                                          centers[assignment[i]]);
+}
+
+double
+SimPointClusterer::bic(const Clustering &clustering) const
+{
+    // Score the clustering as a mixture of spherical gaussians sharing
+    // the same variance, as in X-means
+    const double r = vectors.size();
+    const double m = numDims;
+    const double k = clustering.centers.size();
+    if (r <= k)
+        return -std::numeric_limits<double>::max();
+
+    std::vector<size_t> sizes(clustering.centers.size(), 0);
+    for (auto c : clustering.assignment)
+        ++sizes[c];
+
+    const double variance =
+        std::max(clustering.distortion / ((r - k) * m),
+                 std::numeric_limits<double>::min());
+    double likelihood = -r * m / 2 * std::log(2 * M_PI * variance) -
+        (r - k) * m / 2;
+    for (auto size : sizes) {
+        if (size)
+            likelihood += size * std::log(size / r);
+    }
+
+    const double parameters = (k - 1) + k * m + 1;
+    return likelihood - parameters / 2 * std::log(r);
+}
+
+std::vector<SimPointClusterer::Pick>
+SimPointClusterer::pick(unsigned max_k, unsigned num_init_seeds,
+                        double bic_threshold) const
+{
+    std::vector<Pick> picks;
+    if (vectors.empty() || max_k == 0)
+        return picks;
+
+    // Keep the best of a few clusterings for each number of clusters
+    max_k = std::min<size_t>(max_k, vectors.size());
+    num_init_seeds = std::max(num_init_seeds, 1u);
+    std::vector<Clustering> clusterings(max_k);
+    std::vector<double> scores(max_k);
+    for (unsigned k = 1; k <= max_k; ++k) {
+        Clustering &best = clusterings[k - 1];
+        best.distortion = std::numeric_limits<double>::max();
+        for (unsigned s = 0; s < num_init_seeds; ++s) {
+            Random rng(seed + s);
+            Clustering clustering;
+            kmeans(k, rng, clustering);
+            if (clustering.distortion < best.distortion)
+                best = std::move(clustering);
+        }
+        scores[k - 1] = bic(best);
+    }
+
+    // Pick the fewest clusters that score well enough
+    const double min_score = *std::min_element(scores.begin(), scores.end());
+    const double max_score = *std::max_element(scores.begin(), scores.end());
+    unsigned picked = max_k - 1;
+    for (unsigned k = 0; k < max_k; ++k) {
+        if (scores[k] >= min_score + bic_threshold * (max_score - min_score)) {
+            picked = k;
+            break;
+        }
+    }
+    const Clustering &clustering = clusterings[picked];
+
+    // Represent each cluster with the interval closest to its centroid,
+    // weighted by the share of intervals in the cluster
+    const size_t num_clusters = clustering.centers.size();
+    std::vector<size_t> representative(num_clusters, 0);
+    std::vector<double> closest(num_clusters,
+                                std::numeric_limits<double>::max());
+    std::vector<size_t> sizes(num_clusters, 0);
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        unsigned c = clustering.assignment[i];
+        double d = distance(vectors[i], clustering.centers[c]);
+        if (d < closest[c]) {
+            closest[c] = d;
+            representative[c] = i;
+        }
+        ++sizes[c];
+    }
+
+    for (unsigned c = 0; c < num_clusters; ++c) {
+        if (!sizes[c])
+            continue;
+        Pick pick;
+        pick.interval = representative[c];
+        pick.cluster = c;
+        pick.weight = double(sizes[c]) / vectors.size();
+        picks.push_back(pick);
+    }
+    return picks;
+}
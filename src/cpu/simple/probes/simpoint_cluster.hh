@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_PROBES_SIMPOINT_CLUSTER_HH__
+#define __CPU_SIMPLE_PROBES_SIMPOINT_CLUSTER_HH__
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/random.hh"
+
+/**
+ * Picks SimPoints the way the SimPoint tool does. The BBVs of the
+ * intervals are reduced to a few dimensions by random projection, and the
+ * projected vectors are clustered with k-means from centroids picked with
+ * k-means++. The number of clusters is picked by the BIC score of the
+ * clusterings, and each cluster is represented by the interval closest
+ * to its centroid.
+ */
+class SimPointClusterer
+{
+  public:
+    /** Projected BBV */
+    typedef std::vector<double> Vector;
+
+    /** A clustering of the projected BBVs */
+    struct Clustering
+    {
+        /** Cluster of each interval */
+        std::vector<unsigned> assignment;
+        /** Centroid of each cluster */
+        std::vector<Vector> centers;
+        /** Sum of the squared distances to the centroids */
+        double distortion;
+    };
+
+    /** A SimPoint: the interval representing a cluster, and its weight */
+    struct Pick
+    {
+        size_t interval;
+        unsigned cluster;
+        double weight;
+    };
+
+    /**
+     * @param dims Dimensions of the projected BBVs
+     * @param seed Seed of the projection and of the clustering
+     */
+    SimPointClusterer(unsigned dims, uint32_t seed);
+
+    unsigned dims() const { return numDims; }
+
+    /**
+     * Draw the column of the projection matrix for a basic block, with
+     * entries uniformly distributed in [-1, 1).
+     */
+    Vector column();
+
+    /**
+     * Project a BBV, normalised by its number of insts.
+     *
+     * @param bbv The projection matrix columns of the basic blocks run in
+     *            the interval, with the number of insts they ran
+     */
+    Vector project(
+        const std::vector<std::pair<const Vector *, uint64_t>> &bbv) const;
+
+    /** Keep the projected BBV of an interval, to be clustered */
+    void add(Vector vector) { vectors.push_back(std::move(vector)); }
+
+    /** Number of intervals kept */
+    size_t size() const { return vectors.size(); }
+
+    /**
+     * Run k-means from centroids picked with k-means++.
+     *
+     * @param k Number of clusters
+     * @param rng Random number generator picking the centroids
+     * @param clustering Resulting clustering
+     */
+    void kmeans(unsigned k, Random &rng, Clustering &clustering) const;
+
+    /** Bayesian Information Criterion score of a clustering */
+    double bic(const Clustering &clustering) const;
+
+    /**
+     * Cluster the intervals and pick the SimPoints.
+     *
+     * @param max_k Maximum number of clusters
+     * @param num_init_seeds Clusterings tried for each number of
+     *                       clusters, the one with the least distortion
+     *                       being kept
+     * @param bic_threshold Fraction of the range of the BIC scores the
+     *                      fewest clusters picked must score
+     * @return The SimPoints, by cluster
+     */
+    std::vector<Pick> pick(unsigned max_k, unsigned num_init_seeds,
+                           double bic_threshold) const;
+
+    /** Squared euclidean distance between two vectors */
+    static double distance(const Vector &a, const Vector &b);
+
+  private:
+    const unsigned numDims;
+    const uint32_t seed;
+
+    /** Random number generator of the projection */
+    Random projectionRng;
+
+    /** Projected BBVs of the intervals */
+    std::vector<Vector> vectors;
+};
+
+#endif // __CPU_SIMPLE_PROBES_SIMPOINT_CLUSTER_HH__
@@ -409,8 +409,9 @@ RandomGen::nextPacketTick(bool elastic, Tick delay) const
     }
 }
 
-TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceGen::InputStream::InputStream(const std::string& filename,
+                                   Tick start_tick)
+    : trace(filename), startTick(start_tick)
 {
     init();
 }
@@ -426,6 +427,11 @@ TraceGen::InputStream::init()
         panic("Trace was recorded with a different tick frequency %d\n",
               header_msg.tick_freq());
     }
+
+    // Go straight to the part of an indexed trace that holds the start
+    // tick, read() skips the rest
+    if (startTick != 0)
+        trace.skipToTick(startTick);
 }
 
 void
@@ -439,11 +445,14 @@ bool
 TraceGen::InputStream::read(TraceElement& element)
 {
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    while (trace.read(pkt_msg)) {
+        if (pkt_msg.tick() < startTick)
+            continue;
+
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
-        element.tick = pkt_msg.tick();
+        element.tick = pkt_msg.tick() - startTick;
         element.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
         return true;
     }
@@ -549,14 +549,18 @@ class TraceGen : public BaseGen
         /// Input file stream for the protobuf trace
         ProtoInputStream trace;
 
+        /// Tick of the trace to start reading from
+        const Tick startTick;
+
       public:
 
         /**
          * Create a trace input stream for a given file name.
          *
          * @param filename Path to the file to read from
+         * @param start_tick Tick of the trace to start reading from
          */
-        InputStream(const std::string& filename);
+        InputStream(const std::string& filename, Tick start_tick);
 
         /**
          * Reset the stream such that it can be played once
@@ -566,14 +570,15 @@ class TraceGen : public BaseGen
 
         /**
          * Check the trace header to make sure that it is of the right
-         * format.
+         * format, and skip to the start tick.
          */
         void init();
 
         /**
          * Attempt to read a trace element from the stream,
          * and also notify the caller if the end of the file
-         * was reached.
+         * was reached. Elements before the start tick are skipped,
+         * and the ticks are relative to it.
          *
          * @param element Trace element to populate
          * @return True if an element could be read successfully
@@ -591,11 +596,13 @@ class TraceGen : public BaseGen
      * @param _duration duration of this state before transitioning
      * @param trace_file File to read the transactions from
      * @param addr_offset Positive offset to add to trace address
+     * @param start_tick Tick of the trace to start replaying from
      */
     TraceGen(const std::string& _name, MasterID master_id, Tick _duration,
-             const std::string& trace_file, Addr addr_offset)
+             const std::string& trace_file, Addr addr_offset,
+             Tick start_tick = 0)
         : BaseGen(_name, master_id, _duration),
-          trace(trace_file),
+          trace(trace_file, start_tick),
           tickOffset(0),
           addrOffset(addr_offset),
           traceComplete(false)
@@ -295,12 +295,17 @@ TrafficGen::parseConfig()
                 if (mode == "TRACE") {
                     string traceFile;
                     Addr addrOffset;
+                    // Optionally replay from a tick of the trace onwards
+                    Tick startTick = 0;
 
                     is >> traceFile >> addrOffset;
+                    if (!(is >> startTick))
+                        startTick = 0;
                     traceFile = resolveFile(traceFile);
 
                     states[id] = new TraceGen(name(), masterID, duration,
-                                              traceFile, addrOffset);
+                                              traceFile, addrOffset,
+                                              startTick);
                     DPRINTF(TrafficGen, "State: %d TraceGen\n", id);
                 } else if (mode == "IDLE") {
                     states[id] = new IdleGen(name(), masterID, duration);
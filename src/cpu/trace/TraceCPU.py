@@ -87,3 +87,17 @@ class TraceCPU(BaseCPU):
     progressMsgInterval = Param.Unsigned(0, "Interval of committed "\
                                          "instructions at which to print a"\
                                          " progress msg")
+
+    # Replay the traces from a point of the recording onwards, e.g. to
+    # split a trace across simulations. Indexed traces are read from the
+    # part holding the start tick. The data dependency trace is started
+    # at a block boundary, as its records only carry relative delays.
+    traceStartTick = Param.Tick(0, "Tick of the recording to start the "\
+                                "replay from")
+
+    # Read the data dependency trace and resolve the dependencies within
+    # each window on a helper thread, this many windows ahead of the
+    # replay. A value of 0 reads the windows on the simulation thread.
+    decodeAhead = Param.Unsigned(0, "Number of windows of the data "\
+                                 "dependency trace to read ahead on a "\
+                                 "helper thread")
@@ -129,8 +129,9 @@ TraceCPU::init()
 
     BaseCPU::init();
 
-    // Get the send tick of the first instruction read request
-    Tick first_icache_tick = icacheGen.init();
+    // Get the send tick of the first instruction read request, starting
+    // from the same tick of the recording as the data dependency trace
+    Tick first_icache_tick = icacheGen.init(dcacheGen.getStartTick());
 
     // Get the send tick of the first data read/write request
     Tick first_dcache_tick = dcacheGen.init();
@@ -316,6 +317,9 @@ TraceCPU::ElasticDataGen::init()
     DPRINTF(TraceCPUData, "Initializing data memory request generator "
             "DcacheGen: elastic issue with retry.\n");
 
+    if (decodeAhead != 0)
+        decodeThread = std::thread(&ElasticDataGen::decodeLoop, this);
+
     if (!readNextWindow())
         panic("Trace has %d elements. It must have at least %d elements.\n",
               depGraph.size(), 2 * windowSize);
@@ -347,12 +351,123 @@ TraceCPU::ElasticDataGen::adjustInitTraceOffset(Tick& offset) {
     }
 }
 
+TraceCPU::ElasticDataGen::~ElasticDataGen()
+{
+    stopDecoder();
+}
+
 void
 TraceCPU::ElasticDataGen::exit()
 {
+    stopDecoder();
     trace.reset();
 }
 
+void
+TraceCPU::ElasticDataGen::stopDecoder()
+{
+    if (!decodeThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(decodeMutex);
+        stopDecode = true;
+    }
+    decodeCond.notify_all();
+    decodeThread.join();
+
+    for (auto& window : decodedWindows) {
+        for (auto node : window.nodes)
+            delete node;
+    }
+    decodedWindows.clear();
+}
+
+void
+TraceCPU::ElasticDataGen::decodeLoop()
+{
+    bool last = false;
+    while (!last) {
+        {
+            std::unique_lock<std::mutex> lock(decodeMutex);
+            decodeCond.wait(lock, [this]{
+                return stopDecode || decodedWindows.size() < decodeAhead;
+            });
+            if (stopDecode)
+                return;
+        }
+
+        Window window;
+        decodeWindow(window);
+        last = window.last;
+
+        {
+            std::lock_guard<std::mutex> lock(decodeMutex);
+            decodedWindows.push_back(std::move(window));
+        }
+        decodeCond.notify_all();
+    }
+}
+
+void
+TraceCPU::ElasticDataGen::decodeWindow(Window& window)
+{
+    // Nodes of the window by sequence number, which is all the parents
+    // a node can have in the window
+    std::unordered_map<NodeSeqNum, GraphNode*> nodes;
+    nodes.reserve(windowSize);
+    window.nodes.reserve(windowSize);
+
+    while (window.nodes.size() != windowSize) {
+        GraphNode* new_node = new GraphNode;
+        if (!trace.read(new_node)) {
+            delete new_node;
+            window.last = true;
+            return;
+        }
+
+        if (window.nodes.empty())
+            window.firstSeqNum = new_node->seqNum;
+        assert(new_node->seqNum >= window.firstSeqNum);
+
+        addDepsInWindow(window, new_node, new_node->robDep,
+                        new_node->numRobDep, nodes);
+        addDepsInWindow(window, new_node, new_node->regDep,
+                        new_node->numRegDep, nodes);
+
+        nodes[new_node->seqNum] = new_node;
+        window.nodes.push_back(new_node);
+    }
+}
+
+template<typename T> void
+TraceCPU::ElasticDataGen::addDepsInWindow(
+    Window& window, GraphNode *new_node, T& dep_array, uint8_t& num_dep,
+    const std::unordered_map<NodeSeqNum, GraphNode*>& nodes)
+{
+    for (auto& a_dep : dep_array) {
+        // Dependencies are set starting with the first index, so the
+        // first zero ends them
+        if (a_dep == 0)
+            break;
+        // Parents before the window are resolved against the graph
+        if (a_dep < window.firstSeqNum)
+            continue;
+        auto parent_itr = nodes.find(a_dep);
+        if (parent_itr != nodes.end()) {
+            parent_itr->second->dependents.push_back(new_node);
+            window.maxDependents =
+                std::max(window.maxDependents,
+                         parent_itr->second->dependents.size());
+        } else {
+            // The parent is neither in the graph nor in the window, so it
+            // is considered complete like in addDepsOnParent()
+            a_dep = 0;
+            num_dep--;
+        }
+    }
+}
+
 bool
 TraceCPU::ElasticDataGen::readNextWindow()
 {
@@ -369,28 +484,31 @@ TraceCPU::ElasticDataGen::readNextWindow()
     DPRINTF(TraceCPUData, "Start read: Size of depGraph is %d.\n",
             depGraph.size());
 
-    uint32_t num_read = 0;
-    while (num_read != windowSize) {
-
-        // Create a new graph node
-        GraphNode* new_node = new GraphNode;
-
-        // Read the next line to get the next record. If that fails then end of
-        // trace has been reached and traceComplete needs to be set in addition
-        // to returning false.
-        if (!trace.read(new_node)) {
-            DPRINTF(TraceCPUData, "\tTrace complete!\n");
-            traceComplete = true;
-            return false;
-        }
+    // Get the next window, with the dependencies within it resolved,
+    // either from the decode thread or by reading it now
+    Window window;
+    if (decodeAhead != 0) {
+        std::unique_lock<std::mutex> lock(decodeMutex);
+        decodeCond.wait(lock, [this]{ return !decodedWindows.empty(); });
+        window = std::move(decodedWindows.front());
+        decodedWindows.pop_front();
+        lock.unlock();
+        decodeCond.notify_all();
+    } else {
+        decodeWindow(window);
+    }
+    maxDependents = std::max<double>(window.maxDependents,
+                                     maxDependents.value());
 
+    for (auto new_node : window.nodes) {
         // Annotate the ROB dependencies of the new node onto the parent nodes.
-        addDepsOnParent(new_node, new_node->robDep, new_node->numRobDep);
+        addDepsOnParent(new_node, new_node->robDep, new_node->numRobDep,
+                        window.firstSeqNum);
         // Annotate the register dependencies of the new node onto the parent
         // nodes.
-        addDepsOnParent(new_node, new_node->regDep, new_node->numRegDep);
+        addDepsOnParent(new_node, new_node->regDep, new_node->numRegDep,
+                        window.firstSeqNum);
 
-        num_read++;
         // Add to map
         depGraph[new_node->seqNum] = new_node;
         if (new_node->numRobDep == 0 && new_node->numRegDep == 0) {
@@ -401,6 +519,14 @@ TraceCPU::ElasticDataGen::readNextWindow()
         }
     }
 
+    // If the end of the trace was reached, traceComplete needs to be set in
+    // addition to returning false.
+    if (window.last) {
+        DPRINTF(TraceCPUData, "\tTrace complete!\n");
+        traceComplete = true;
+        return false;
+    }
+
     DPRINTF(TraceCPUData, "End read: Size of depGraph is %d.\n",
             depGraph.size());
     return true;
@@ -408,15 +534,19 @@ TraceCPU::ElasticDataGen::readNextWindow()
 
 template<typename T> void
 TraceCPU::ElasticDataGen::addDepsOnParent(GraphNode *new_node,
-                                            T& dep_array, uint8_t& num_dep)
+                                            T& dep_array, uint8_t& num_dep,
+                                            NodeSeqNum first_seq_num)
 {
     for (auto& a_dep : dep_array) {
         // The convention is to set the dependencies starting with the first
-        // index in the ROB and register dependency arrays. Thus, when we reach
-        // a dependency equal to the initialisation value of zero, we know have
-        // iterated over all dependencies and can break.
+        // index in the ROB and register dependency arrays. Dependencies
+        // within the window that were found complete when it was read are
+        // zeroed, so skip the zeroes rather than break on the first one.
         if (a_dep == 0)
-            break;
+            continue;
+        // Dependencies within the window are already resolved
+        if (a_dep >= first_seq_num)
+            continue;
         // We look up the valid dependency, i.e. the parent of this node
         auto parent_itr = depGraph.find(a_dep);
         if (parent_itr != depGraph.end()) {
@@ -1052,11 +1182,13 @@ TraceCPU::FixedRetryGen::regStats()
 }
 
 Tick
-TraceCPU::FixedRetryGen::init()
+TraceCPU::FixedRetryGen::init(Tick start_tick)
 {
     DPRINTF(TraceCPUInst, "Initializing instruction fetch request generator"
             " IcacheGen: fixed issue with retry.\n");
 
+    trace.skipToTick(start_tick);
+
     if (nextExecute()) {
         DPRINTF(TraceCPUInst, "\tFirst tick = %d.\n", currElement.tick);
         return currElement.tick;
@@ -1266,10 +1398,11 @@ TraceCPU::DcachePort::recvReqRetry()
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
     const std::string& filename,
-    const double time_multiplier)
+    const double time_multiplier, Tick start_tick)
     : trace(filename),
       timeMultiplier(time_multiplier),
-      microOpCount(0)
+      microOpCount(0),
+      startTick(start_tick)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::InstDepRecordHeader header_msg;
@@ -1285,6 +1418,14 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
         // when the data dependency trace was captured in the o3cpu model
         windowSize = header_msg.window_size();
     }
+
+    // The records only have delays relative to each other, so they can
+    // only be started from at the block boundaries of an indexed trace.
+    // Dependencies on the records before are considered complete
+    if (start_tick != 0 && !trace.skipToTick(start_tick, &startTick)) {
+        fatal("Trace %s can't be replayed from tick %d as it has no "
+              "index\n", filename, start_tick);
+    }
 }
 
 void
@@ -1480,7 +1621,7 @@ TraceCPU::ElasticDataGen::GraphNode::typeToStr() const
 }
 
 TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+    : trace(filename), startTick(0)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
@@ -1494,6 +1635,16 @@ TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
     }
 }
 
+void
+TraceCPU::FixedRetryGen::InputStream::skipToTick(Tick start_tick)
+{
+    // Go straight to the part of an indexed trace that holds the start
+    // tick, read() skips the rest
+    startTick = start_tick;
+    if (startTick != 0)
+        trace.skipToTick(startTick);
+}
+
 void
 TraceCPU::FixedRetryGen::InputStream::reset()
 {
@@ -1504,11 +1655,14 @@ bool
 TraceCPU::FixedRetryGen::InputStream::read(TraceElement* element)
 {
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    while (trace.read(pkt_msg)) {
+        if (pkt_msg.tick() < startTick)
+            continue;
+
         element->cmd = pkt_msg.cmd();
         element->addr = pkt_msg.addr();
         element->blocksize = pkt_msg.size();
-        element->tick = pkt_msg.tick();
+        element->tick = pkt_msg.tick() - startTick;
         element->flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
         element->pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
         return true;
@@ -43,10 +43,15 @@
 #define __CPU_TRACE_TRACE_CPU_HH__
 
 #include <array>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <mutex>
 #include <queue>
 #include <set>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "arch/registers.hh"
 #include "base/statistics.hh"
@@ -139,6 +144,15 @@
  * A CountedExitEvent that contains a static int belonging to the Trace CPU
  * class as a down counter is used to implement multi Trace CPU simulation
  * exit.
+ *
+ * Decoding the data dependency trace and building the dependency graph can
+ * take a good part of the replay. Optionally, the windows of the trace are
+ * read on a helper thread of each Trace CPU, ahead of the replay. The
+ * dependencies between the nodes of a window are resolved on the helper
+ * thread as well, as they do not depend on the state of the replay, and the
+ * simulation thread only resolves the dependencies on earlier windows. This
+ * leaves the simulation thread with the memory system, which is where the
+ * time goes when many Trace CPUs share a cache hierarchy.
  */
 
 class TraceCPU : public BaseCPU
@@ -398,6 +412,10 @@ class TraceCPU : public BaseCPU
             // Input file stream for the protobuf trace
             ProtoInputStream trace;
 
+            // Tick of the recording to start reading from, which is
+            // the origin of the ticks of the elements
+            Tick startTick;
+
           public:
 
             /**
@@ -407,6 +425,14 @@ class TraceCPU : public BaseCPU
              */
             InputStream(const std::string& filename);
 
+            /**
+             * Start reading from a tick of the recording, which becomes
+             * the origin of the ticks of the elements.
+             *
+             * @param start_tick Tick of the recording to start from
+             */
+            void skipToTick(Tick start_tick);
+
             /**
              * Reset the stream such that it can be played once
              * again.
@@ -444,9 +470,11 @@ class TraceCPU : public BaseCPU
          * Called from TraceCPU init(). Reads the first message from the
          * input trace file and returns the send tick.
          *
+         * @param start_tick Tick of the recording to start from, the same
+         *                   as for the data dependency trace
          * @return Tick when first packet must be sent
          */
-        Tick init();
+        Tick init(Tick start_tick);
 
         /**
          * This tries to send current or retry packet and returns true if
@@ -691,6 +719,29 @@ class TraceCPU : public BaseCPU
             Tick execTick;
         };
 
+        /**
+         * A window of nodes read from the trace, with the dependencies
+         * between them already resolved. The nodes are in program order,
+         * so the dependencies on nodes before the window are the ones
+         * on sequence numbers lower than that of its first node.
+         */
+        struct Window
+        {
+            Window() : firstSeqNum(0), maxDependents(0), last(false) {}
+
+            /** The nodes of the window */
+            std::vector<GraphNode *> nodes;
+
+            /** Sequence number of the first node */
+            NodeSeqNum firstSeqNum;
+
+            /** The most dependents a node got within the window */
+            size_t maxDependents;
+
+            /** Set if the trace ended within the window */
+            bool last;
+        };
+
         /**
          * The HardwareResource class models structures that hold the in-flight
          * nodes. When a node becomes dependency free, first check if resources
@@ -811,6 +862,12 @@ class TraceCPU : public BaseCPU
             /** Count of committed ops read from trace plus the filtered ops */
             uint64_t microOpCount;
 
+            /**
+             * Tick of the recording the replay starts from, the start of
+             * the block of the trace holding the start tick asked for
+             */
+            Tick startTick;
+
             /**
              * The window size that is read from the header of the protobuf
              * trace and used to process the dependency trace
@@ -823,9 +880,10 @@ class TraceCPU : public BaseCPU
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param start_tick Tick of the recording to start from
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier, Tick start_tick);
 
             /**
              * Reset the stream such that it can be played once
@@ -849,6 +907,9 @@ class TraceCPU : public BaseCPU
 
             /** Get number of micro-ops modelled in the TraceCPU replay */
             uint64_t getMicroOpCount() const { return microOpCount; }
+
+            /** Get the tick of the recording the replay starts from */
+            Tick getStartTick() const { return startTick; }
         };
 
         public:
@@ -859,7 +920,8 @@ class TraceCPU : public BaseCPU
             : owner(_owner),
               port(_port),
               masterID(master_id),
-              trace(trace_file, 1.0 / params->freqMultiplier),
+              trace(trace_file, 1.0 / params->freqMultiplier,
+                    params->traceStartTick),
               genName(owner.name() + ".elastic" + _name),
               retryPkt(nullptr),
               traceComplete(false),
@@ -867,12 +929,16 @@ class TraceCPU : public BaseCPU
               execComplete(false),
               windowSize(trace.getWindowSize()),
               hwResource(params->sizeROB, params->sizeStoreBuffer,
-                         params->sizeLoadBuffer)
+                         params->sizeLoadBuffer),
+              decodeAhead(params->decodeAhead),
+              stopDecode(false)
         {
             DPRINTF(TraceCPUData, "Window size in the trace is %d.\n",
                     windowSize);
         }
 
+        ~ElasticDataGen();
+
         /**
          * Called from TraceCPU init(). Reads the first message from the
          * input trace file and returns the send tick.
@@ -906,17 +972,52 @@ class TraceCPU : public BaseCPU
 
         /**
          * Iterate over the dependencies of a new node and add the new node
-         * to the list of dependents of the parent node.
+         * to the list of dependents of the parent node. Dependencies on
+         * the nodes of its own window are left alone, as they are resolved
+         * when the window is read.
          *
          * @param   new_node    new node to add to the graph
          * @tparam  dep_array   the dependency array of type rob or register,
          *                      that is to be iterated, and may get modified
          * @param   num_dep     the number of dependencies set in the array
          *                      which may get modified during iteration
+         * @param   first_seq_num sequence number of the first node of the
+         *                      window of the new node
          */
         template<typename T> void addDepsOnParent(GraphNode *new_node,
                                                     T& dep_array,
-                                                    uint8_t& num_dep);
+                                                    uint8_t& num_dep,
+                                                    NodeSeqNum first_seq_num);
+
+        /**
+         * Read the next window of nodes from the trace and resolve the
+         * dependencies between them. This does not touch the state of the
+         * replay, so that it can run on the decode thread.
+         *
+         * @param window Window to fill
+         */
+        void decodeWindow(Window& window);
+
+        /**
+         * Resolve the dependencies of a node on the earlier nodes of its
+         * window, like addDepsOnParent() does on the graph.
+         *
+         * @param   window      window holding the new node
+         * @param   new_node    new node to add to the window
+         * @tparam  dep_array   the dependency array of type rob or register
+         * @param   num_dep     the number of dependencies set in the array
+         * @param   nodes       earlier nodes of the window by seq. num
+         */
+        template<typename T> void addDepsInWindow(
+            Window& window, GraphNode *new_node, T& dep_array,
+            uint8_t& num_dep,
+            const std::unordered_map<NodeSeqNum, GraphNode*>& nodes);
+
+        /** Main loop of the decode thread. */
+        void decodeLoop();
+
+        /** Stop the decode thread and drop the windows it read. */
+        void stopDecoder();
 
         /**
          * This is the main execute function which consumes nodes from the
@@ -968,6 +1069,13 @@ class TraceCPU : public BaseCPU
          */
         bool isExecComplete() const { return execComplete; }
 
+        /**
+         * Returns the tick of the recording the replay starts from. The
+         * trace can only be started at the start of a block, which may
+         * be before the start tick asked for.
+         */
+        Tick getStartTick() const { return trace.getStartTick(); }
+
         /**
          * Attempts to issue a node once the node's source dependencies are
          * complete. If resources are available then add it to the readyList,
@@ -1034,6 +1142,27 @@ class TraceCPU : public BaseCPU
         /** Store the depGraph of GraphNodes */
         std::unordered_map<NodeSeqNum, GraphNode*> depGraph;
 
+        /**
+         * Number of windows the decode thread reads ahead of the replay,
+         * or 0 if windows are read on the simulation thread when needed.
+         */
+        const unsigned decodeAhead;
+
+        /** Thread reading the trace ahead of the replay */
+        std::thread decodeThread;
+
+        /** Protects the windows read ahead and the stop flag */
+        std::mutex decodeMutex;
+
+        /** Signalled when a window is read ahead or consumed */
+        std::condition_variable decodeCond;
+
+        /** Windows read ahead, in order */
+        std::deque<Window> decodedWindows;
+
+        /** Set to make the decode thread stop */
+        bool stopDecode;
+
         /**
          * Queue of dependency-free nodes that are pending issue because
          * resources are not available. This is chosen to be FIFO so that
@@ -154,18 +154,21 @@ class AbstractMemory : public MemObject
         }
     }
 
+    // The accesses of other event queues update the stats from their
+    // threads in atomic mode, hence the sharding
+
     /** Number of total bytes read from this memory */
-    Stats::Vector bytesRead;
+    Stats::ShardedVector bytesRead;
     /** Number of instruction bytes read from this memory */
-    Stats::Vector bytesInstRead;
+    Stats::ShardedVector bytesInstRead;
     /** Number of bytes written to this memory */
-    Stats::Vector bytesWritten;
+    Stats::ShardedVector bytesWritten;
     /** Number of read requests */
-    Stats::Vector numReads;
+    Stats::ShardedVector numReads;
     /** Number of write requests */
-    Stats::Vector numWrites;
+    Stats::ShardedVector numWrites;
     /** Number of other requests */
-    Stats::Vector numOther;
+    Stats::ShardedVector numOther;
     /** Read bandwidth from this memory */
     Stats::Formula bwRead;
     /** Read bandwidth from this memory */
@@ -395,9 +395,9 @@ class CoherentXBar : public BaseXBar
      */
     bool sinkPacket(const PacketPtr pkt) const;
 
-    Stats::Scalar snoops;
-    Stats::Scalar snoopTraffic;
-    Stats::Distribution snoopFanout;
+    Stats::ShardedScalar snoops;
+    Stats::ShardedScalar snoopTraffic;
+    Stats::ShardedDistribution snoopFanout;
 
   public:
 
@@ -199,7 +199,7 @@ class NoncoherentXBar : public BaseXBar
      * stats
      */
     virtual void regStats();
-    Stats::Scalar totPktSize;
+    Stats::ShardedScalar totPktSize;
 };
 
 #endif //__MEM_NONCOHERENT_XBAR_HH__
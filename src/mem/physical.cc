@@ -304,6 +304,26 @@ PhysicalMemory::access(PacketPtr pkt)
     }
 }
 
+uint8_t *
+PhysicalMemory::hostAddr(const AddrRange &range, AbstractMemory *&mem) const
+{
+    mem = NULL;
+
+    const auto& m = addrMap.find(range.start());
+    if (m == addrMap.end())
+        return NULL;
+
+    if (!m->first.interleaved() && range.isSubset(m->first))
+        mem = m->second;
+
+    for (const auto& s : backingStore) {
+        if (s.inAddrMap && range.isSubset(s.range))
+            return s.pmem + (range.start() - s.range.start());
+    }
+
+    return NULL;
+}
+
 void
 PhysicalMemory::functionalAccess(PacketPtr pkt)
 {
@@ -227,6 +227,21 @@ class PhysicalMemory : public Serializable
      */
     void access(PacketPtr pkt);
 
+    /**
+     * Get a pointer to the host memory backing a range of guest
+     * memory. This is for CPU models that copy data directly instead of
+     * calling access(), and is only safe for accesses that only copy
+     * data, i.e. not for LL/SC or swaps, and for writes only if no
+     * address is locked in the memory. Stats are not updated either.
+     *
+     * @param range Contiguous guest address range, e.g. a page
+     * @param mem Set to the memory the range is in, or NULL if the
+     *            range is spread over several memories
+     * @return Pointer to the start of the range, or NULL if the range
+     *         is not all backed by host memory
+     */
+    uint8_t *hostAddr(const AddrRange &range, AbstractMemory *&mem) const;
+
     /**
      * Perform an untimed memory read or write without changing
      * anything but the memory itself. No stats are affected by this
@@ -120,7 +120,7 @@ MemTraceProbe::handleRequest(const ProbePoints::PacketInfo &pkt_info)
         pkt_msg.set_pc(pkt_info.pc);
     pkt_msg.set_pkt_id(pkt_info.master);
 
-    traceStream->write(pkt_msg);
+    traceStream->write(pkt_msg, curTick());
 }
 
 
@@ -70,6 +70,9 @@ class Consumer
 
     void scheduleEventAbsolute(Tick timeAbs);
 
+    //! Event queue on which wakeups of this consumer are serviced.
+    EventQueue *consumerEventQueue() const { return em->eventQueue(); }
+
   protected:
     void scheduleEvent(Cycles timeDelta);
 
@@ -33,7 +33,9 @@
 
 #include "mem/ruby/network/garnet2.0/GarnetNetwork.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 #include "base/cast.hh"
 #include "base/stl_helpers.hh"
@@ -42,6 +44,7 @@
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
 #include "mem/ruby/network/garnet2.0/CreditLink.hh"
 #include "mem/ruby/network/garnet2.0/GarnetLink.hh"
+#include "mem/ruby/network/garnet2.0/InputUnit.hh"
 #include "mem/ruby/network/garnet2.0/NetworkInterface.hh"
 #include "mem/ruby/network/garnet2.0/NetworkLink.hh"
 #include "mem/ruby/network/garnet2.0/Router.hh"
@@ -50,6 +53,13 @@
 using namespace std;
 using m5::stl_helpers::deletePointers;
 
+// Window over which the link load seen by the analytical model is measured
+static const Cycles analyticalWindow(1000);
+
+// Highest link load the analytical model assumes, keeps the queueing
+// delay finite when the offered load exceeds the network capacity
+static const double analyticalMaxLoad = 0.9;
+
 /*
  * GarnetNetwork sets up the routers and links and collects stats.
  * Default parameters (GarnetNetwork.py) can be overwritten from command line
@@ -57,7 +67,9 @@ using m5::stl_helpers::deletePointers;
  */
 
 GarnetNetwork::GarnetNetwork(const Params *p)
-    : Network(p)
+    : Network(p), m_telemetry_interval(p->telemetry_interval),
+      m_telemetry_event([this]{ sampleTelemetry(); }, name()),
+      m_link_telemetry(nullptr), m_vc_telemetry(nullptr)
 {
     m_num_rows = p->num_rows;
     m_ni_flit_size = p->ni_flit_size;
@@ -65,6 +77,10 @@ GarnetNetwork::GarnetNetwork(const Params *p)
     m_buffers_per_data_vc = p->buffers_per_data_vc;
     m_buffers_per_ctrl_vc = p->buffers_per_ctrl_vc;
     m_routing_algorithm = p->routing_algorithm;
+    m_analytical_mode = p->analytical_mode;
+    m_analytical_window_start = Cycles(0);
+    m_analytical_link_cycles = 0;
+    m_analytical_load = 0;
 
     m_enable_fault_model = p->enable_fault_model;
     if (m_enable_fault_model)
@@ -96,6 +112,14 @@ GarnetNetwork::GarnetNetwork(const Params *p)
         m_nis.push_back(ni);
         ni->init_net_ptr(this);
     }
+
+    // Links are filled in by the topology during init()
+    Cycles unreachable(numeric_limits<uint64_t>::max() / 4);
+    m_zero_load_latency.assign(m_routers.size(),
+        vector<Cycles>(m_routers.size(), unreachable));
+    m_hop_count.assign(m_routers.size(), vector<int>(m_routers.size(), 0));
+    m_ni_inject_latency.assign(m_nodes, Cycles(0));
+    m_ni_eject_latency.assign(m_nodes, Cycles(0));
 }
 
 void
@@ -111,6 +135,25 @@ GarnetNetwork::init()
     // parent network constructor
     assert(m_topology_ptr != NULL);
     m_topology_ptr->createLinks(this);
+    computeZeroLoadLatencies();
+
+    // Routers may be spread across several event queues. Links whose
+    // consumer is serviced by another queue are the only channel between
+    // them, so their latency is the lookahead of the parallel simulation
+    // and has to cover the simulation quantum.
+    vector<NetworkLink *> links(m_networklinks);
+    links.insert(links.end(), m_creditlinks.begin(), m_creditlinks.end());
+    for (auto link : links) {
+        if (!link->crossesEventQueue())
+            continue;
+
+        fatal_if(link->cyclesToTicks(link->getLatency()) < simQuantum ||
+                 simQuantum == 0,
+                 "%s crosses event queues but its latency (%d ticks) does "
+                 "not cover the simulation quantum (%d ticks).\n",
+                 link->name(), link->cyclesToTicks(link->getLatency()),
+                 simQuantum);
+    }
 
     // Initialize topology specific parameters
     if (getNumRows() > 0) {
@@ -143,6 +186,77 @@ GarnetNetwork::init()
     }
 }
 
+void
+GarnetNetwork::startup()
+{
+    Network::startup();
+
+    if (m_telemetry_interval == 0)
+        return;
+
+    // The samples are taken on this network's event queue and are only
+    // approximate if the routers are spread across several event queues
+    for (auto link : m_networklinks) {
+        if (link->crossesEventQueue()) {
+            warn("%s: telemetry of a partitioned network is sampled "
+                 "asynchronously.\n", name());
+            break;
+        }
+    }
+
+    m_link_telemetry = simout.create(name() + ".link_util.csv");
+    *m_link_telemetry->stream() << "cycle,link,type,utilization" << endl;
+
+    m_vc_telemetry = simout.create(name() + ".vc_occupancy.csv");
+    *m_vc_telemetry->stream() << "cycle,router,inport,vc,flits" << endl;
+
+    m_telemetry_link_util.assign(m_networklinks.size(), 0);
+    schedule(m_telemetry_event, clockEdge(m_telemetry_interval));
+}
+
+/*
+ * Writes one sample per network link (fraction of the last interval the
+ * link carried a flit) and one per non-empty router input VC (flits
+ * buffered at the time of the sample).
+*/
+
+void
+GarnetNetwork::sampleTelemetry()
+{
+    static const char *link_type_names[] = { "ext_in", "ext_out", "int" };
+
+    ostream &link_os = *m_link_telemetry->stream();
+    for (int i = 0; i < m_networklinks.size(); i++) {
+        unsigned int util = m_networklinks[i]->getLinkUtilization();
+        // Link counters may have been reset with the stats
+        if (util < m_telemetry_link_util[i])
+            m_telemetry_link_util[i] = 0;
+
+        ccprintf(link_os, "%d,%d,%s,%.4f\n", curCycle(),
+                 m_networklinks[i]->get_id(),
+                 link_type_names[m_networklinks[i]->getType()],
+                 double(util - m_telemetry_link_util[i]) /
+                 m_telemetry_interval);
+        m_telemetry_link_util[i] = util;
+    }
+
+    ostream &vc_os = *m_vc_telemetry->stream();
+    for (auto router : m_routers) {
+        vector<InputUnit *> &input_unit = router->get_inputUnit_ref();
+        for (int inport = 0; inport < input_unit.size(); inport++) {
+            for (int vc = 0; vc < router->get_num_vcs(); vc++) {
+                int flits = input_unit[inport]->get_vc_occupancy(vc);
+                if (flits > 0) {
+                    ccprintf(vc_os, "%d,%d,%d,%d,%d\n", curCycle(),
+                             router->get_id(), inport, vc, flits);
+                }
+            }
+        }
+    }
+
+    schedule(m_telemetry_event, clockEdge(m_telemetry_interval));
+}
+
 GarnetNetwork::~GarnetNetwork()
 {
     deletePointers(m_routers);
@@ -177,6 +291,7 @@ GarnetNetwork::makeExtInLink(NodeID src, SwitchID dest, BasicLink* link,
     PortDirection dst_inport_dirn = "Local";
     m_routers[dest]->addInPort(dst_inport_dirn, net_link, credit_link);
     m_nis[src]->addOutPort(net_link, credit_link, dest);
+    m_ni_inject_latency[src] = net_link->getLatency();
 }
 
 /*
@@ -208,6 +323,7 @@ GarnetNetwork::makeExtOutLink(SwitchID src, NodeID dest, BasicLink* link,
                                routing_table_entry,
                                link->m_weight, credit_link);
     m_nis[dest]->addInPort(net_link, credit_link);
+    m_ni_eject_latency[dest] = net_link->getLatency();
 }
 
 /*
@@ -235,6 +351,112 @@ GarnetNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
     m_routers[src]->addOutPort(src_outport_dirn, net_link,
                                routing_table_entry,
                                link->m_weight, credit_link);
+
+    // A flit entering the src router reaches the dest router after the
+    // router pipeline and the link traversal
+    Cycles hop_latency = m_routers[src]->get_pipe_stages() +
+        net_link->getLatency();
+    if (hop_latency < m_zero_load_latency[src][dest]) {
+        m_zero_load_latency[src][dest] = hop_latency;
+        m_hop_count[src][dest] = 1;
+    }
+}
+
+/*
+ * All-pairs shortest latencies between routers (Floyd-Warshall).
+ * Used by the analytical mode as the zero-load latency of a route.
+*/
+
+void
+GarnetNetwork::computeZeroLoadLatencies()
+{
+    int num_routers = m_routers.size();
+
+    for (int i = 0; i < num_routers; i++) {
+        m_zero_load_latency[i][i] = Cycles(0);
+        m_hop_count[i][i] = 0;
+    }
+
+    for (int k = 0; k < num_routers; k++) {
+        for (int i = 0; i < num_routers; i++) {
+            for (int j = 0; j < num_routers; j++) {
+                Cycles through_k = m_zero_load_latency[i][k] +
+                    m_zero_load_latency[k][j];
+                if (through_k < m_zero_load_latency[i][j]) {
+                    m_zero_load_latency[i][j] = through_k;
+                    m_hop_count[i][j] = m_hop_count[i][k] + m_hop_count[k][j];
+                }
+            }
+        }
+    }
+}
+
+void
+GarnetNetwork::setAnalyticalMode(bool analytical)
+{
+    // Flits already in the network drain through the detailed model,
+    // messages already in flight in the analytical model are still
+    // delivered by their destination NI.
+    m_analytical_mode = analytical;
+    m_analytical_window_start = curCycle();
+    m_analytical_link_cycles = 0;
+}
+
+/*
+ * Fraction of cycles each link would have been busy, averaged over all
+ * links, for the traffic injected in analytical mode. The load of the last
+ * complete window is used so that the estimate does not depend on where
+ * in the window a message is injected.
+*/
+
+double
+GarnetNetwork::analyticalLinkLoad()
+{
+    Cycles elapsed = curCycle() - m_analytical_window_start;
+    if (elapsed >= analyticalWindow) {
+        m_analytical_load = double(m_analytical_link_cycles) /
+            (double(elapsed) * m_networklinks.size());
+        m_analytical_load = min(m_analytical_load, analyticalMaxLoad);
+        m_analytical_window_start = curCycle();
+        m_analytical_link_cycles = 0;
+    }
+
+    return m_analytical_load;
+}
+
+void
+GarnetNetwork::injectAnalytical(MsgPtr msg_ptr, int vnet, int src_ni,
+                                int dest_ni, int num_flits,
+                                Cycles src_delay)
+{
+    int src_router = get_router_id(src_ni);
+    int dest_router = get_router_id(dest_ni);
+    int hops = m_hop_count[src_router][dest_router];
+
+    // Same timing as the detailed model: one cycle in the NI, the
+    // inject link, every router pipeline and link on the route, the
+    // eject link, and the body flits following the head one per cycle.
+    Cycles zero_load_latency = Cycles(1) + m_ni_inject_latency[src_ni] +
+        m_zero_load_latency[src_router][dest_router] +
+        m_routers[dest_router]->get_pipe_stages() +
+        m_ni_eject_latency[dest_ni] + Cycles(num_flits - 1);
+
+    // M/D/1 waiting time at each router, the service time being the
+    // number of cycles the packet occupies the output link
+    double load = analyticalLinkLoad();
+    double wait = load * num_flits / (2 * (1 - load));
+    Cycles queueing_latency((uint64_t)(wait * (hops + 1) + 0.5));
+
+    // The packet occupies the inject link, every internal link of the
+    // route and the eject link
+    m_analytical_link_cycles += num_flits * (hops + 2);
+
+    increment_injected_packets(vnet);
+    for (int i = 0; i < num_flits; i++)
+        increment_injected_flits(vnet);
+
+    m_nis[dest_ni]->enqueueAnalytical(msg_ptr, vnet,
+        zero_load_latency + queueing_latency, src_delay, hops, num_flits);
 }
 
 // Total routers in the network
@@ -378,6 +600,12 @@ GarnetNetwork::regStats()
     m_avg_hops.name(name() + ".average_hops");
     m_avg_hops = m_total_hops / sum(m_flits_received);
 
+    m_packet_latency_hist
+        .init(16)
+        .name(name() + ".packet_latency_hist")
+        .flags(Stats::nozero | Stats::pdf | Stats::oneline)
+        ;
+
     // Links
     m_total_ext_in_link_utilization
         .name(name() + ".ext_in_link_utilization");
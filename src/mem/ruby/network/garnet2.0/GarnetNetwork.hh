@@ -37,9 +37,11 @@
 #include <iostream>
 #include <vector>
 
+#include "base/output.hh"
 #include "mem/ruby/network/Network.hh"
 #include "mem/ruby/network/fault_model/FaultModel.hh"
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
 #include "params/GarnetNetwork.hh"
 
 class FaultModel;
@@ -57,6 +59,7 @@ class GarnetNetwork : public Network
 
     ~GarnetNetwork();
     void init();
+    void startup();
 
     // Configuration (set externally)
 
@@ -97,6 +100,18 @@ class GarnetNetwork : public Network
                           PortDirection src_outport_dirn,
                           PortDirection dest_inport_dirn);
 
+    /**
+     * In analytical mode, messages bypass the routers and links. The
+     * latency of each message is the zero-load latency of its route
+     * plus an M/D/1 queueing delay per router derived from the load
+     * offered to the network. Used to warm up caches quickly before
+     * switching back to the detailed model.
+     */
+    bool isAnalyticalMode() const { return m_analytical_mode; }
+    void setAnalyticalMode(bool analytical);
+    void injectAnalytical(MsgPtr msg_ptr, int vnet, int src_ni, int dest_ni,
+                          int num_flits, Cycles src_delay);
+
     //! Function for performing a functional write. The return value
     //! indicates the number of messages that were written.
     uint32_t functionalWrite(Packet *pkt);
@@ -143,6 +158,12 @@ class GarnetNetwork : public Network
         m_total_hops += hops;
     }
 
+    void
+    sample_packet_latency(Cycles latency)
+    {
+        m_packet_latency_hist.sample(latency);
+    }
+
   protected:
     // Configuration
     int m_num_rows;
@@ -153,6 +174,7 @@ class GarnetNetwork : public Network
     uint32_t m_buffers_per_data_vc;
     int m_routing_algorithm;
     bool m_enable_fault_model;
+    bool m_analytical_mode;
 
     // Statistical variables
     Stats::Vector m_packets_received;
@@ -186,15 +208,41 @@ class GarnetNetwork : public Network
     Stats::Scalar  m_total_hops;
     Stats::Formula m_avg_hops;
 
+    // Network plus queueing latency of every packet, for tail latency
+    Stats::Histogram m_packet_latency_hist;
+
   private:
     GarnetNetwork(const GarnetNetwork& obj);
     GarnetNetwork& operator=(const GarnetNetwork& obj);
 
+    void computeZeroLoadLatencies();
+    void sampleTelemetry();
+    double analyticalLinkLoad();
+
     std::vector<VNET_type > m_vnet_type;
     std::vector<Router *> m_routers;   // All Routers in Network
     std::vector<NetworkLink *> m_networklinks; // All flit links in the network
     std::vector<CreditLink *> m_creditlinks; // All credit links in the network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
+
+    // Zero-load latency and hop count between the input ports of any two
+    // routers, and latency of the links attaching each NI
+    std::vector<std::vector<Cycles> > m_zero_load_latency;
+    std::vector<std::vector<int> > m_hop_count;
+    std::vector<Cycles> m_ni_inject_latency;
+    std::vector<Cycles> m_ni_eject_latency;
+
+    // Link load offered in analytical mode, measured over windows
+    Cycles m_analytical_window_start;
+    uint64_t m_analytical_link_cycles;
+    double m_analytical_load;
+
+    // Periodic link utilization and VC occupancy samples
+    Cycles m_telemetry_interval;
+    EventFunctionWrapper m_telemetry_event;
+    OutputStream *m_link_telemetry;
+    OutputStream *m_vc_telemetry;
+    std::vector<unsigned int> m_telemetry_link_util;
 };
 
 inline std::ostream&
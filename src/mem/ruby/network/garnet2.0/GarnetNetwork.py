@@ -30,6 +30,7 @@
 
 from m5.params import *
 from m5.proxy import *
+from m5.SimObject import *
 from Network import RubyNetwork
 from BasicRouter import BasicRouter
 from ClockedObject import ClockedObject
@@ -37,17 +38,28 @@ from ClockedObject import ClockedObject
 class GarnetNetwork(RubyNetwork):
     type = 'GarnetNetwork'
     cxx_header = "mem/ruby/network/garnet2.0/GarnetNetwork.hh"
+
+    cxx_exports = [
+        PyBindMethod("setAnalyticalMode"),
+    ]
+
     num_rows = Param.Int(0, "number of rows if 2D (mesh/torus/..) topology");
     ni_flit_size = Param.UInt32(16, "network interface flit size in bytes")
     vcs_per_vnet = Param.UInt32(4, "virtual channels per virtual network");
     buffers_per_data_vc = Param.UInt32(4, "buffers per data virtual channel");
     buffers_per_ctrl_vc = Param.UInt32(1, "buffers per ctrl virtual channel");
     routing_algorithm = Param.Int(0,
-        "0: Weight-based Table, 1: XY, 2: Custom");
+        "0: Weight-based Table, 1: XY, 2: Custom, "
+        "3: West-first adaptive, 4: Odd-even adaptive");
     enable_fault_model = Param.Bool(False, "enable network fault model");
     fault_model = Param.FaultModel(NULL, "network fault model");
     garnet_deadlock_threshold = Param.UInt32(50000,
                               "network-level deadlock threshold")
+    telemetry_interval = Param.Cycles(0, "cycles between samples of link "
+        "utilization and VC occupancy written to the output directory "
+        "(0: disabled)")
+    analytical_mode = Param.Bool(False, "bypass routers and links with an "
+                                 "analytical latency model (for warmup)")
 
 class GarnetNetworkInterface(ClockedObject):
     type = 'GarnetNetworkInterface'
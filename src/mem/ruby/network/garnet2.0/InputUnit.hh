@@ -118,6 +118,12 @@ class InputUnit : public Consumer
         return m_vcs[vc]->need_stage(stage, time);
     }
 
+    inline int
+    get_vc_occupancy(int vc)
+    {
+        return m_vcs[vc]->get_occupancy();
+    }
+
     inline bool
     isReady(int invc, Cycles curTime)
     {
@@ -72,6 +72,7 @@ NetworkInterface::NetworkInterface(const Params *p)
     }
 
     m_stall_count.resize(m_virtual_networks);
+    m_analytical_queue.resize(m_virtual_networks);
 }
 
 void
@@ -159,6 +160,7 @@ NetworkInterface::incrementStats(flit *t_flit)
         m_net_ptr->increment_received_packets(vnet);
         m_net_ptr->increment_packet_network_latency(network_delay, vnet);
         m_net_ptr->increment_packet_queueing_latency(queueing_delay, vnet);
+        m_net_ptr->sample_packet_latency(network_delay + queueing_delay);
     }
 
     // Hops
@@ -194,7 +196,10 @@ NetworkInterface::wakeup()
 
         if (b->isReady(curTime)) { // Is there a message waiting
             msg_ptr = b->peekMsgPtr();
-            if (flitisizeMessage(msg_ptr, vnet)) {
+            if (m_net_ptr->isAnalyticalMode()) {
+                routeAnalytical(msg_ptr, vnet);
+                b->dequeue(curTime);
+            } else if (flitisizeMessage(msg_ptr, vnet)) {
                 b->dequeue(curTime);
             }
         }
@@ -202,6 +207,7 @@ NetworkInterface::wakeup()
 
     scheduleOutputLink();
     checkReschedule();
+    checkAnalyticalQueue();
 
     // Check if there are flits stalling a virtual channel. Track if a
     // message is enqueued to restrict ejection to one message per cycle.
@@ -351,18 +357,8 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
 
         Message *new_net_msg_ptr = new_msg_ptr.get();
         if (dest_nodes.size() > 1) {
-            NetDest personal_dest;
-            for (int m = 0; m < (int) MachineType_NUM; m++) {
-                if ((destID >= MachineType_base_number((MachineType) m)) &&
-                    destID < MachineType_base_number((MachineType) (m+1))) {
-                    // calculating the NetDest associated with this destID
-                    personal_dest.clear();
-                    personal_dest.add((MachineID) {(MachineType) m, (destID -
-                        MachineType_base_number((MachineType) m))});
-                    new_net_msg_ptr->getDestination() = personal_dest;
-                    break;
-                }
-            }
+            NetDest personal_dest = getPersonalDest(destID);
+            new_net_msg_ptr->getDestination() = personal_dest;
             net_msg_dest.removeNetDest(personal_dest);
             // removing the destination from the original message to reflect
             // that a message with this particular destination has been
@@ -401,6 +397,113 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
     return true ;
 }
 
+// Calculate the NetDest associated with a single destination node
+NetDest
+NetworkInterface::getPersonalDest(NodeID destID)
+{
+    NetDest personal_dest;
+    for (int m = 0; m < (int) MachineType_NUM; m++) {
+        if ((destID >= MachineType_base_number((MachineType) m)) &&
+            destID < MachineType_base_number((MachineType) (m+1))) {
+            personal_dest.add((MachineID) {(MachineType) m, (destID -
+                MachineType_base_number((MachineType) m))});
+            break;
+        }
+    }
+    return personal_dest;
+}
+
+/*
+ * Analytical mode: the message is split into unicast messages like in
+ * flitisizeMessage(), but instead of being injected into the network each
+ * of them is handed to the destination NI with the latency estimated by
+ * GarnetNetwork. No output VC is needed so the message is never stalled.
+ */
+
+void
+NetworkInterface::routeAnalytical(MsgPtr msg_ptr, int vnet)
+{
+    Message *net_msg_ptr = msg_ptr.get();
+    vector<NodeID> dest_nodes = net_msg_ptr->getDestination().getAllDest();
+
+    int num_flits = (int) ceil((double) m_net_ptr->MessageSizeType_to_int(
+        net_msg_ptr->getMessageSize())/m_net_ptr->getNiFlitSize());
+    Cycles src_delay = curCycle() - ticksToCycles(msg_ptr->getTime());
+
+    for (int ctr = 0; ctr < dest_nodes.size(); ctr++) {
+        MsgPtr new_msg_ptr = msg_ptr->clone();
+        NodeID destID = dest_nodes[ctr];
+
+        if (dest_nodes.size() > 1) {
+            new_msg_ptr->getDestination() = getPersonalDest(destID);
+        }
+
+        m_net_ptr->injectAnalytical(new_msg_ptr, vnet, m_id, destID,
+                                    num_flits, src_delay);
+    }
+}
+
+void
+NetworkInterface::enqueueAnalytical(MsgPtr msg_ptr, int vnet, Cycles latency,
+                                    Cycles src_delay, int hops, int num_flits)
+{
+    // Keep the protocol buffers in order: a message never overtakes an
+    // earlier one of the same vnet to this NI
+    Cycles arrival_time = curCycle() + latency;
+    if (!m_analytical_queue[vnet].empty() &&
+        m_analytical_queue[vnet].back().arrival_time > arrival_time) {
+        arrival_time = m_analytical_queue[vnet].back().arrival_time;
+    }
+
+    m_analytical_queue[vnet].push_back({msg_ptr, arrival_time, latency,
+                                        src_delay, hops, num_flits});
+    scheduleEventAbsolute(clockEdge(arrival_time - curCycle()));
+}
+
+// Eject at most one analytically routed message per vnet and cycle into
+// the protocol buffers, retrying next cycle if a buffer is full
+void
+NetworkInterface::checkAnalyticalQueue()
+{
+    Tick curTime = clockEdge();
+
+    for (int vnet = 0; vnet < m_analytical_queue.size(); vnet++) {
+        auto &queue = m_analytical_queue[vnet];
+        if (queue.empty() || queue.front().arrival_time > curCycle())
+            continue;
+
+        if (!outNode_ptr[vnet]->areNSlotsAvailable(1, curTime)) {
+            scheduleEvent(Cycles(1));
+            continue;
+        }
+
+        AnalyticalMessage &am = queue.front();
+        outNode_ptr[vnet]->enqueue(am.msg_ptr, curTime,
+                                   cyclesToTicks(Cycles(1)));
+
+        Cycles queueing_delay =
+            am.src_delay + (curCycle() - am.arrival_time);
+        m_net_ptr->increment_received_packets(vnet);
+        m_net_ptr->increment_packet_network_latency(am.network_delay, vnet);
+        m_net_ptr->increment_packet_queueing_latency(queueing_delay, vnet);
+        m_net_ptr->sample_packet_latency(am.network_delay + queueing_delay);
+        for (int i = 0; i < am.num_flits; i++) {
+            m_net_ptr->increment_received_flits(vnet);
+            m_net_ptr->increment_flit_network_latency(am.network_delay,
+                                                      vnet);
+            m_net_ptr->increment_flit_queueing_latency(queueing_delay, vnet);
+            m_net_ptr->increment_total_hops(am.hops);
+        }
+
+        queue.pop_front();
+        if (!queue.empty()) {
+            Cycles next = max(queue.front().arrival_time,
+                              curCycle() + Cycles(1));
+            scheduleEventAbsolute(clockEdge(next - curCycle()));
+        }
+    }
+}
+
 // Looking for a free output vc
 int
 NetworkInterface::calculateVC(int vnet)
@@ -539,6 +642,14 @@ NetworkInterface::functionalWrite(Packet *pkt)
     }
 
     num_functional_writes += outFlitQueue->functionalWrite(pkt);
+
+    for (auto &queue : m_analytical_queue) {
+        for (auto &am : queue) {
+            if (am.msg_ptr->functionalWrite(pkt))
+                num_functional_writes++;
+        }
+    }
+
     return num_functional_writes;
 }
 
@@ -72,6 +72,10 @@ class NetworkInterface : public ClockedObject, public Consumer
     int get_router_id() { return m_router_id; }
     void init_net_ptr(GarnetNetwork *net_ptr) { m_net_ptr = net_ptr; }
 
+    // Receive a message routed by the analytical model of the network
+    void enqueueAnalytical(MsgPtr msg_ptr, int vnet, Cycles latency,
+                           Cycles src_delay, int hops, int num_flits);
+
     uint32_t functionalWrite(Packet *);
 
   private:
@@ -107,8 +111,23 @@ class NetworkInterface : public ClockedObject, public Consumer
     // When a vc stays busy for a long time, it indicates a deadlock
     std::vector<int> vc_busy_counter;
 
+    // Messages delivered by the analytical model, per vnet in arrival order
+    struct AnalyticalMessage
+    {
+        MsgPtr msg_ptr;
+        Cycles arrival_time;
+        Cycles network_delay;
+        Cycles src_delay;
+        int hops;
+        int num_flits;
+    };
+    std::vector<std::deque<AnalyticalMessage> > m_analytical_queue;
+
     bool checkStallQueue();
     bool flitisizeMessage(MsgPtr msg_ptr, int vnet);
+    void routeAnalytical(MsgPtr msg_ptr, int vnet);
+    void checkAnalyticalQueue();
+    NetDest getPersonalDest(NodeID destID);
     int calculateVC(int vnet);
 
     void scheduleOutputLink();
@@ -33,6 +33,8 @@
 
 #include "mem/ruby/network/garnet2.0/NetworkLink.hh"
 
+#include <cassert>
+
 #include "mem/ruby/network/garnet2.0/CreditLink.hh"
 
 NetworkLink::NetworkLink(const Params *p)
@@ -40,7 +42,7 @@ NetworkLink::NetworkLink(const Params *p)
       m_type(NUM_LINK_TYPES_),
       m_latency(p->link_latency),
       linkBuffer(new flitBuffer()), link_consumer(nullptr),
-      link_srcQueue(nullptr), m_link_utilized(0),
+      link_srcQueue(nullptr), m_crosses_eventq(false), m_link_utilized(0),
       m_vc_load(p->vcs_per_vnet * p->virt_nets)
 {
 }
@@ -54,6 +56,7 @@ void
 NetworkLink::setLinkConsumer(Consumer *consumer)
 {
     link_consumer = consumer;
+    m_crosses_eventq = (consumer->consumerEventQueue() != eventQueue());
 }
 
 void
@@ -68,13 +71,47 @@ NetworkLink::wakeup()
     if (link_srcQueue->isReady(curCycle())) {
         flit *t_flit = link_srcQueue->getTopFlit();
         t_flit->set_time(curCycle() + m_latency);
-        linkBuffer->insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
+
+        if (m_crosses_eventq) {
+            // The link buffer belongs to the consumer's thread, so the
+            // flit travels inside an event scheduled on the consumer's
+            // queue. The event runs ahead of any default priority
+            // wakeup in the same tick so the consumer sees the flit
+            // exactly when it would in a single queue simulation.
+            {
+                std::lock_guard<std::mutex> lock(m_in_transit_lock);
+                m_in_transit.push_back(t_flit);
+            }
+
+            auto *evt = new EventFunctionWrapper(
+                [this, t_flit]{ deliver(t_flit); },
+                name() + ".deliver", true, Event::Default_Pri - 1);
+            link_consumer->consumerEventQueue()->schedule(
+                evt, clockEdge(m_latency));
+        } else {
+            linkBuffer->insert(t_flit);
+            link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        }
     }
 }
 
+void
+NetworkLink::deliver(flit *t_flit)
+{
+    assert(curEventQueue() == link_consumer->consumerEventQueue());
+
+    {
+        std::lock_guard<std::mutex> lock(m_in_transit_lock);
+        assert(m_in_transit.front() == t_flit);
+        m_in_transit.pop_front();
+    }
+
+    linkBuffer->insert(t_flit);
+    link_consumer->scheduleEventAbsolute(curTick());
+}
+
 void
 NetworkLink::resetStats()
 {
@@ -100,5 +137,13 @@ CreditLinkParams::create()
 uint32_t
 NetworkLink::functionalWrite(Packet *pkt)
 {
-    return linkBuffer->functionalWrite(pkt);
+    uint32_t num_functional_writes = linkBuffer->functionalWrite(pkt);
+
+    std::lock_guard<std::mutex> lock(m_in_transit_lock);
+    for (auto t_flit : m_in_transit) {
+        if (t_flit->functionalWrite(pkt))
+            num_functional_writes++;
+    }
+
+    return num_functional_writes;
 }
@@ -34,7 +34,9 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_NETWORK_LINK_HH__
 #define __MEM_RUBY_NETWORK_GARNET_NETWORK_LINK_HH__
 
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 #include "mem/ruby/common/Consumer.hh"
@@ -58,8 +60,18 @@ class NetworkLink : public ClockedObject, public Consumer
     link_type getType() { return m_type; }
     void print(std::ostream& out) const {}
     int get_id() const { return m_id; }
+    Cycles getLatency() const { return m_latency; }
     void wakeup();
 
+    /**
+     * True if the consumer of this link is serviced by a different
+     * event queue than the link itself. Flits crossing such a link are
+     * handed over by an event on the consumer's queue instead of being
+     * written into the link buffer directly, and the link latency is
+     * the lookahead available to the parallel simulation.
+     */
+    bool crossesEventQueue() const { return m_crosses_eventq; }
+
     unsigned int getLinkUtilization() const { return m_link_utilized; }
     const std::vector<unsigned int> & getVcLoad() const { return m_vc_load; }
 
@@ -73,6 +85,8 @@ class NetworkLink : public ClockedObject, public Consumer
     void resetStats();
 
   private:
+    void deliver(flit *t_flit);
+
     const int m_id;
     link_type m_type;
     const Cycles m_latency;
@@ -80,6 +94,12 @@ class NetworkLink : public ClockedObject, public Consumer
     flitBuffer *linkBuffer;
     Consumer *link_consumer;
     flitBuffer *link_srcQueue;
+    bool m_crosses_eventq;
+
+    // Flits handed to the consumer's event queue but not yet delivered
+    // into the link buffer. Only used by links crossing event queues.
+    std::deque<flit *> m_in_transit;
+    std::mutex m_in_transit_lock;
 
     // Statistical variables
     unsigned int m_link_utilized;
@@ -106,6 +106,20 @@ OutputUnit::has_free_vc(int vnet)
     return false;
 }
 
+// Number of free buffer slots at the downstream router across all VCs of
+// this vnet. Used as congestion estimate by adaptive routing.
+int
+OutputUnit::get_free_credits(int vnet)
+{
+    int free_credits = 0;
+    int vc_base = vnet*m_vc_per_vnet;
+    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
+        free_credits += m_outvc_state[vc]->get_credit_count();
+    }
+
+    return free_credits;
+}
+
 // Assign a free output VC to the winner of Switch Allocation
 int
 OutputUnit::select_free_vc(int vnet)
@@ -60,6 +60,7 @@ class OutputUnit : public Consumer
     bool has_credit(int out_vc);
     bool has_free_vc(int vnet);
     int select_free_vc(int vnet);
+    int get_free_credits(int vnet);
 
     inline PortDirection get_direction() { return m_direction; }
 
@@ -35,6 +35,7 @@
 
 #include "base/cast.hh"
 #include "mem/ruby/network/garnet2.0/InputUnit.hh"
+#include "mem/ruby/network/garnet2.0/OutputUnit.hh"
 #include "mem/ruby/network/garnet2.0/Router.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
@@ -160,6 +161,10 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
             lookupRoutingTable(route.vnet, route.net_dest); break;
         case XY_:     outport =
             outportComputeXY(route, inport, inport_dirn); break;
+        case WEST_FIRST_: outport =
+            outportComputeWestFirst(route, inport, inport_dirn); break;
+        case ODD_EVEN_: outport =
+            outportComputeOddEven(route, inport, inport_dirn); break;
         // any custom algorithm
         case CUSTOM_: outport =
             outportComputeCustom(route, inport, inport_dirn); break;
@@ -230,6 +235,129 @@ RoutingUnit::outportComputeXY(RouteInfo route,
     return m_outports_dirn2idx[outport_dirn];
 }
 
+// Credit-based selection among admissible output ports:
+// pick the port whose downstream router has the most free buffers
+// in this vnet. Ties go to the first candidate.
+int
+RoutingUnit::selectLeastCongested(const std::vector<PortDirection> &candidates,
+                                  int vnet)
+{
+    assert(!candidates.empty());
+
+    std::vector<OutputUnit *> &output_unit = m_router->get_outputUnit_ref();
+    int best_outport = -1;
+    int best_credits = -1;
+
+    for (auto &dirn : candidates) {
+        int outport = m_outports_dirn2idx[dirn];
+        int credits = output_unit[outport]->get_free_credits(vnet);
+        if (credits > best_credits) {
+            best_credits = credits;
+            best_outport = outport;
+        }
+    }
+
+    return best_outport;
+}
+
+// West-first routing (Glass and Ni) for a Mesh.
+// Packets going west are routed west first and deterministically.
+// All other packets may adaptively use any productive direction.
+// Ordered vnets use XY routing so that packets cannot overtake each other.
+int
+RoutingUnit::outportComputeWestFirst(RouteInfo route,
+                                     int inport,
+                                     PortDirection inport_dirn)
+{
+    if (m_router->get_net_ptr()->isVNetOrdered(route.vnet))
+        return outportComputeXY(route, inport, inport_dirn);
+
+    int M5_VAR_USED num_rows = m_router->get_net_ptr()->getNumRows();
+    int num_cols = m_router->get_net_ptr()->getNumCols();
+    assert(num_rows > 0 && num_cols > 0);
+
+    int my_id = m_router->get_id();
+    int my_x = my_id % num_cols;
+    int my_y = my_id / num_cols;
+
+    int dest_id = route.dest_router;
+    int dest_x = dest_id % num_cols;
+    int dest_y = dest_id / num_cols;
+
+    // already checked that in outportCompute() function
+    assert(!(dest_x == my_x && dest_y == my_y));
+
+    if (dest_x < my_x) {
+        assert(inport_dirn == "Local" || inport_dirn == "East");
+        return m_outports_dirn2idx["West"];
+    }
+
+    std::vector<PortDirection> candidates;
+    if (dest_x > my_x)
+        candidates.push_back("East");
+    if (dest_y > my_y)
+        candidates.push_back("North");
+    else if (dest_y < my_y)
+        candidates.push_back("South");
+
+    return selectLeastCongested(candidates, route.vnet);
+}
+
+// Odd-even turn model routing (Chiu) for a Mesh.
+// East-to-north/south turns are forbidden in even columns and
+// north/south-to-west turns in odd columns, which leaves more adaptivity
+// than west-first while remaining deadlock free.
+// Ordered vnets use XY routing so that packets cannot overtake each other.
+int
+RoutingUnit::outportComputeOddEven(RouteInfo route,
+                                   int inport,
+                                   PortDirection inport_dirn)
+{
+    if (m_router->get_net_ptr()->isVNetOrdered(route.vnet))
+        return outportComputeXY(route, inport, inport_dirn);
+
+    int M5_VAR_USED num_rows = m_router->get_net_ptr()->getNumRows();
+    int num_cols = m_router->get_net_ptr()->getNumCols();
+    assert(num_rows > 0 && num_cols > 0);
+
+    int my_id = m_router->get_id();
+    int my_x = my_id % num_cols;
+    int my_y = my_id / num_cols;
+
+    int src_x = route.src_router % num_cols;
+
+    int dest_id = route.dest_router;
+    int dest_x = dest_id % num_cols;
+    int dest_y = dest_id / num_cols;
+
+    // already checked that in outportCompute() function
+    assert(!(dest_x == my_x && dest_y == my_y));
+
+    PortDirection y_dirn = (dest_y > my_y) ? "North" : "South";
+    std::vector<PortDirection> candidates;
+
+    if (dest_x == my_x) {
+        candidates.push_back(y_dirn);
+    } else if (dest_x > my_x) {
+        // Eastbound
+        if (dest_y == my_y) {
+            candidates.push_back("East");
+        } else {
+            if (my_x % 2 == 1 || my_x == src_x)
+                candidates.push_back(y_dirn);
+            if (dest_x % 2 == 1 || dest_x - my_x != 1)
+                candidates.push_back("East");
+        }
+    } else {
+        // Westbound
+        candidates.push_back("West");
+        if (dest_y != my_y && my_x % 2 == 0)
+            candidates.push_back(y_dirn);
+    }
+
+    return selectLeastCongested(candidates, route.vnet);
+}
+
 // Template for implementing custom routing algorithm
 // using port directions. (Example adaptive)
 int
@@ -67,12 +67,24 @@ class RoutingUnit
                          int inport,
                          PortDirection inport_dirn);
 
+    // Minimal adaptive routing for Mesh
+    // Both select the least congested of the admissible output ports
+    int outportComputeWestFirst(RouteInfo route,
+                                int inport,
+                                PortDirection inport_dirn);
+    int outportComputeOddEven(RouteInfo route,
+                              int inport,
+                              PortDirection inport_dirn);
+
     // Custom Routing Algorithm using Port Directions
     int outportComputeCustom(RouteInfo route,
                              int inport,
                              PortDirection inport_dirn);
 
   private:
+    int selectLeastCongested(const std::vector<PortDirection> &candidates,
+                             int vnet);
+
     Router *m_router;
 
     // Routing Table
@@ -351,7 +351,13 @@ SwitchAllocator::vc_allocate(int outport, int inport, int invc)
 }
 
 // Wakeup the router next cycle to perform SA again
-// if there are flits ready.
+// if there are flits ready that can make progress.
+// A flit that is not allowed to be sent (no free outvc, no credit, or
+// held back by an older flit in an ordered vnet) can only become
+// eligible once a credit arrives or another flit of this router wins
+// the switch. Credit arrival wakes the router through the credit link
+// and switch grants happen within this wakeup, so the router can sleep
+// through the intervening cycles without changing any arbitration state.
 void
 SwitchAllocator::check_for_wakeup()
 {
@@ -359,7 +365,9 @@ SwitchAllocator::check_for_wakeup()
 
     for (int i = 0; i < m_num_inports; i++) {
         for (int j = 0; j < m_num_vcs; j++) {
-            if (m_input_unit[i]->need_stage(j, SA_, nextCycle)) {
+            if (m_input_unit[i]->need_stage(j, SA_, nextCycle) &&
+                send_allowed(i, j, m_input_unit[i]->get_outport(j),
+                             m_input_unit[i]->get_outvc(j))) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
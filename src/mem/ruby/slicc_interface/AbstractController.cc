@@ -40,6 +40,10 @@
 
 #include "mem/ruby/slicc_interface/AbstractController.hh"
 
+#include <algorithm>
+#include <limits>
+
+#include "base/intmath.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/protocol/MemoryMsg.hh"
 #include "mem/ruby/network/Network.hh"
@@ -52,6 +56,7 @@ AbstractController::AbstractController(const Params *p)
     : MemObject(p), Consumer(this), m_version(p->version),
       m_clusterID(p->cluster_id),
       m_masterId(p->system->getMasterId(name())), m_is_blocking(false),
+      m_line_filter(NULL),
       m_number_of_TBEs(p->number_of_TBEs),
       m_transitions_per_cycle(p->transitions_per_cycle),
       m_buffer_size(p->buffer_size), m_recycle_latency(p->recycle_latency),
@@ -77,6 +82,17 @@ AbstractController::init()
     }
 }
 
+void
+AbstractController::initLineFilter(uint64_t num_lines)
+{
+    // A few counters per line keep the false positive rate low. The
+    // counters must never saturate, or a line could go missing.
+    uint64_t size = std::max(ceilPow2((num_lines + m_number_of_TBEs) * 4),
+                             uint64_t(64));
+    m_line_filter = new LSB_CountingBloomFilter(size,
+        std::numeric_limits<int>::max());
+}
+
 void
 AbstractController::resetStats()
 {
@@ -56,10 +56,12 @@
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/Histogram.hh"
 #include "mem/ruby/common/MachineID.hh"
+#include "mem/ruby/filters/LSB_CountingBloomFilter.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "params/RubyController.hh"
 
+class CacheSnapshot;
 class Network;
 class GPUCoalescer;
 
@@ -99,6 +101,16 @@ class AbstractController : public MemObject, public Consumer
     virtual void regStats();
 
     virtual void recordCacheTrace(int cntrl, CacheRecorder* tr) = 0;
+
+    //! Save the state of the caches and directory of this controller, so
+    //! that it can be installed again without replaying the cache trace.
+    //! Returns false if the protocol state of this controller cannot be
+    //! captured this way, e.g. because a transaction is in flight.
+    virtual bool recordCacheSnapshot(CacheSnapshot &snapshot) = 0;
+    virtual void installCacheSnapshot(CacheSnapshot &snapshot) = 0;
+    //! Identifies the protocol entry layouts and cache geometries; a
+    //! snapshot can only be installed into a matching controller.
+    virtual std::string cacheSnapshotSignature() const = 0;
     virtual Sequencer* getCPUSequencer() const = 0;
     virtual GPUCoalescer* getGPUCoalescer() const = 0;
 
@@ -112,6 +124,15 @@ class AbstractController : public MemObject, public Consumer
     virtual int functionalWrite(const Addr &addr, PacketPtr) = 0;
     int functionalMemoryWrite(PacketPtr);
 
+    //! Returns false if this controller is known not to hold the line, so
+    //! that functional accesses can skip it. Controllers without a line
+    //! filter may hold any line.
+    bool
+    mayHoldLine(Addr line_addr)
+    {
+        return m_line_filter == NULL || m_line_filter->getCount(line_addr);
+    }
+
     //! Function for enqueuing a prefetch request
     virtual void enqueuePrefetch(const Addr &, const RubyRequestType&)
     { fatal("Prefetches not implemented!");}
@@ -166,6 +187,10 @@ class AbstractController : public MemObject, public Consumer
     //! Profiles the delay associated with messages.
     void profileMsgDelay(uint32_t virtualNetwork, Cycles delay);
 
+    //! Create the line filter for a controller whose caches and TBEs hold
+    //! at most num_lines lines; they count their lines in it.
+    void initLineFilter(uint64_t num_lines);
+
     void stallBuffer(MessageBuffer* buf, Addr addr);
     void wakeUpBuffers(Addr addr);
     void wakeUpAllBuffers(Addr addr);
@@ -181,6 +206,7 @@ class AbstractController : public MemObject, public Consumer
 
     Network *m_net_ptr;
     bool m_is_blocking;
+    LSB_CountingBloomFilter *m_line_filter;
     std::map<Addr, MessageBuffer*> m_block_map;
 
     typedef std::vector<MessageBuffer*> MsgVecType;
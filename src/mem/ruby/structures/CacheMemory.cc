@@ -29,6 +29,9 @@
 
 #include "mem/ruby/structures/CacheMemory.hh"
 
+#include <algorithm>
+#include <tuple>
+
 #include "base/intmath.hh"
 #include "debug/RubyCache.hh"
 #include "debug/RubyCacheTrace.hh"
@@ -277,6 +280,8 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry, bool touch)
                     address);
             set[i]->m_locked = -1;
             m_tag_index[address] = i;
+            for (auto filter : m_line_filters)
+                filter->increment(address);
             entry->setSetIndex(cacheSet);
             entry->setWayIndex(i);
 
@@ -302,6 +307,8 @@ CacheMemory::deallocate(Addr address)
         delete m_cache[cacheSet][loc];
         m_cache[cacheSet][loc] = NULL;
         m_tag_index.erase(address);
+        for (auto filter : m_line_filters)
+            filter->decrement(address);
     }
 }
 
@@ -427,6 +434,91 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
             totalBlocks, (float(warmedUpBlocks) / float(totalBlocks)) * 100.0);
 }
 
+void
+CacheMemory::recordSnapshot(CacheSnapshot &snapshot,
+                            const function<void(CacheSnapshot &,
+                                const AbstractCacheEntry *)> &record_entry)
+    const
+{
+    // Entries that are NotPresent are free as far as allocate() is
+    // concerned, so they are left out
+    auto present = [](const AbstractCacheEntry *entry) {
+        return entry != NULL &&
+            entry->m_Permission != AccessPermission_NotPresent;
+    };
+
+    uint64_t num_entries = 0;
+    for (int i = 0; i < m_cache_num_sets; i++) {
+        for (int j = 0; j < m_cache_assoc; j++) {
+            if (present(m_cache[i][j]))
+                num_entries++;
+        }
+    }
+    snapshot.put(num_entries);
+
+    for (int i = 0; i < m_cache_num_sets; i++) {
+        for (int j = 0; j < m_cache_assoc; j++) {
+            const AbstractCacheEntry *entry = m_cache[i][j];
+            if (!present(entry))
+                continue;
+
+            snapshot.put(entry->m_Address);
+            snapshot.put(entry->m_Permission);
+            snapshot.put(m_replacementPolicy_ptr->getLastAccess(i, j));
+            record_entry(snapshot, entry);
+        }
+    }
+
+    DPRINTF(RubyCacheTrace, "%s: %lli entries recorded in snapshot\n",
+            name(), num_entries);
+}
+
+void
+CacheMemory::installSnapshot(CacheSnapshot &snapshot,
+                             const function<AbstractCacheEntry *(
+                                 CacheSnapshot &)> &make_entry)
+{
+    uint64_t num_entries;
+    snapshot.get(num_entries);
+
+    // Replay the accesses in their original order, so that replacement
+    // policies that ignore the time stamp end up in the same state too.
+    vector<tuple<Tick, int64_t, int>> accesses;
+    accesses.reserve(num_entries);
+
+    for (uint64_t i = 0; i < num_entries; i++) {
+        Addr address;
+        AccessPermission perm;
+        Tick last_access;
+        snapshot.get(address);
+        snapshot.get(perm);
+        snapshot.get(last_access);
+
+        AbstractCacheEntry *entry = make_entry(snapshot);
+        allocate(address, entry, false);
+        entry->m_Permission = perm;
+
+        accesses.emplace_back(last_access, entry->getSetIndex(),
+                              entry->getWayIndex());
+    }
+
+    stable_sort(accesses.begin(), accesses.end());
+    for (auto &access : accesses) {
+        m_replacementPolicy_ptr->touch(get<1>(access), get<2>(access),
+                                       get<0>(access));
+    }
+
+    DPRINTF(RubyCacheTrace, "%s: %lli entries installed from snapshot\n",
+            name(), num_entries);
+}
+
+string
+CacheMemory::snapshotSignature() const
+{
+    return csprintf("%d:%d:%d:%d", m_cache_num_sets, m_cache_assoc,
+                    m_block_size, m_start_index_bit);
+}
+
 void
 CacheMemory::print(ostream& out) const
 {
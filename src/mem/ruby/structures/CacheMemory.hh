@@ -30,6 +30,7 @@
 #ifndef __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -39,11 +40,13 @@
 #include "mem/protocol/CacheResourceType.hh"
 #include "mem/protocol/RubyRequest.hh"
 #include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/filters/AbstractBloomFilter.hh"
 #include "mem/ruby/slicc_interface/AbstractCacheEntry.hh"
 #include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
 #include "mem/ruby/structures/AbstractReplacementPolicy.hh"
 #include "mem/ruby/structures/BankedArray.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
+#include "mem/ruby/system/CacheSnapshot.hh"
 #include "params/RubyCache.hh"
 #include "sim/sim_object.hh"
 
@@ -104,6 +107,17 @@ class CacheMemory : public SimObject
     // Hook for checkpointing the contents of the cache
     void recordCacheContents(int cntrl, CacheRecorder* tr) const;
 
+    // Hooks for saving the cache state and installing it again without
+    // going through the protocol. The protocol specific fields of the
+    // entries are handled by the controller through the given functions.
+    void recordSnapshot(CacheSnapshot &snapshot,
+                        const std::function<void(CacheSnapshot &,
+                            const AbstractCacheEntry *)> &record_entry) const;
+    void installSnapshot(CacheSnapshot &snapshot,
+                         const std::function<AbstractCacheEntry *(
+                             CacheSnapshot &)> &make_entry);
+    std::string snapshotSignature() const;
+
     // Set this address to most recently used
     void setMRU(Addr address);
     void setMRU(Addr addr, int occupancy);
@@ -149,6 +163,11 @@ class CacheMemory : public SimObject
     int getCacheSize() const { return m_cache_size; }
     int getCacheAssoc() const { return m_cache_assoc; }
     int getNumBlocks() const { return m_cache_num_sets * m_cache_assoc; }
+
+    // Count the allocated lines in a filter of a controller using this
+    // cache, see AbstractController::mayHoldLine()
+    void addLineFilter(AbstractBloomFilter *filter)
+    { m_line_filters.push_back(filter); }
     Addr getAddressAtIdx(int idx) const;
 
   private:
@@ -172,6 +191,7 @@ class CacheMemory : public SimObject
     // The second index is the the amount associativity.
     std::unordered_map<Addr, int> m_tag_index;
     std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    std::vector<AbstractBloomFilter *> m_line_filters;
 
     AbstractReplacementPolicy *m_replacementPolicy_ptr;
 
@@ -135,6 +135,60 @@ DirectoryMemory::allocate(Addr address, AbstractEntry *entry)
     return entry;
 }
 
+void
+DirectoryMemory::recordSnapshot(CacheSnapshot &snapshot,
+                                const function<void(CacheSnapshot &,
+                                    const AbstractEntry *)> &record_entry)
+    const
+{
+    uint64_t num_entries = 0;
+    for (uint64_t i = 0; i < m_num_entries; i++) {
+        if (m_entries[i] != NULL)
+            num_entries++;
+    }
+    snapshot.put(num_entries);
+
+    for (uint64_t i = 0; i < m_num_entries; i++) {
+        if (m_entries[i] == NULL)
+            continue;
+
+        snapshot.put(i);
+        snapshot.put(m_entries[i]->m_Permission);
+        record_entry(snapshot, m_entries[i]);
+    }
+}
+
+void
+DirectoryMemory::installSnapshot(CacheSnapshot &snapshot,
+                                 const function<AbstractEntry *(
+                                     CacheSnapshot &)> &make_entry)
+{
+    uint64_t num_entries;
+    snapshot.get(num_entries);
+
+    for (uint64_t i = 0; i < num_entries; i++) {
+        uint64_t idx;
+        AccessPermission perm;
+        snapshot.get(idx);
+        snapshot.get(perm);
+        assert(idx < m_num_entries);
+
+        AbstractEntry *entry = make_entry(snapshot);
+        entry->m_Permission = perm;
+        delete m_entries[idx];
+        m_entries[idx] = entry;
+    }
+}
+
+string
+DirectoryMemory::snapshotSignature() const
+{
+    string signature = csprintf("%d", m_num_entries);
+    for (const auto &r : addrRanges)
+        signature += ":" + r.to_string();
+    return signature;
+}
+
 void
 DirectoryMemory::print(ostream& out) const
 {
@@ -41,6 +41,7 @@
 #ifndef __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -48,6 +49,7 @@
 #include "mem/protocol/DirectoryRequestType.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/slicc_interface/AbstractEntry.hh"
+#include "mem/ruby/system/CacheSnapshot.hh"
 #include "params/RubyDirectoryMemory.hh"
 #include "sim/sim_object.hh"
 
@@ -79,6 +81,16 @@ class DirectoryMemory : public SimObject
     AbstractEntry *lookup(Addr address);
     AbstractEntry *allocate(Addr address, AbstractEntry* new_entry);
 
+    // Hooks for saving the directory state and installing it again, see
+    // CacheMemory::recordSnapshot()
+    void recordSnapshot(CacheSnapshot &snapshot,
+                        const std::function<void(CacheSnapshot &,
+                            const AbstractEntry *)> &record_entry) const;
+    void installSnapshot(CacheSnapshot &snapshot,
+                         const std::function<AbstractEntry *(
+                             CacheSnapshot &)> &make_entry);
+    std::string snapshotSignature() const;
+
     void print(std::ostream& out) const;
     void recordRequestType(DirectoryRequestType requestType);
 
@@ -33,16 +33,20 @@
 #include <unordered_map>
 
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/filters/AbstractBloomFilter.hh"
 
 template<class ENTRY>
 class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_number_of_TBEs(number_of_TBEs), m_line_filter(NULL)
     {
     }
 
+    // Count the allocated entries in a filter of the owning controller
+    void setLineFilter(AbstractBloomFilter *filter) { m_line_filter = filter; }
+
     bool isPresent(Addr address) const;
     void allocate(Addr address);
     void deallocate(Addr address);
@@ -51,6 +55,7 @@ class TBETable
     {
         return (m_number_of_TBEs - m_map.size()) >= n;
     }
+    bool isEmpty() const { return m_map.empty(); }
 
     ENTRY *lookup(Addr address);
 
@@ -67,6 +72,7 @@ class TBETable
 
   private:
     int m_number_of_TBEs;
+    AbstractBloomFilter *m_line_filter;
 };
 
 template<class ENTRY>
@@ -94,6 +100,8 @@ TBETable<ENTRY>::allocate(Addr address)
     assert(!isPresent(address));
     assert(m_map.size() < m_number_of_TBEs);
     m_map[address] = ENTRY();
+    if (m_line_filter)
+        m_line_filter->increment(address);
 }
 
 template<class ENTRY>
@@ -103,6 +111,8 @@ TBETable<ENTRY>::deallocate(Addr address)
     assert(isPresent(address));
     assert(m_map.size() > 0);
     m_map.erase(address);
+    if (m_line_filter)
+        m_line_filter->decrement(address);
 }
 
 // looks an address up in the cache
@@ -29,12 +29,21 @@
 
 #include "mem/ruby/system/CacheRecorder.hh"
 
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstring>
+
 #include "debug/RubyCacheTrace.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
 
 using namespace std;
 
+const char CacheTraceHeader::Magic[8] = { 'R', 'U', 'B', 'Y', 'T', 'R',
+                                          'C', '\0' };
+
 void
 TraceRecord::print(ostream& out) const
 {
@@ -46,19 +55,54 @@ TraceRecord::print(ostream& out) const
 CacheRecorder::CacheRecorder()
     : m_uncompressed_trace(NULL),
       m_uncompressed_trace_size(0),
+      m_trace_mapped(false), m_compact_trace(false),
+      m_trace_records_end(0), m_trace_snapshot(NULL),
+      m_trace_snapshot_size(0),
+      m_bytes_read(0), m_records_read(0), m_records_flushed(0),
       m_block_size_bytes(RubySystem::getBlockSizeBytes())
 {
 }
 
 CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
                              uint64_t uncompressed_trace_size,
+                             bool trace_mapped,
                              std::vector<Sequencer*>& seq_map,
                              uint64_t block_size_bytes)
     : m_uncompressed_trace(uncompressed_trace),
       m_uncompressed_trace_size(uncompressed_trace_size),
+      m_trace_mapped(trace_mapped), m_compact_trace(false),
+      m_trace_records_end(uncompressed_trace_size), m_trace_snapshot(NULL),
+      m_trace_snapshot_size(0),
       m_seq_map(seq_map),  m_bytes_read(0), m_records_read(0),
       m_records_flushed(0), m_block_size_bytes(block_size_bytes)
 {
+    if (m_uncompressed_trace != NULL &&
+        m_uncompressed_trace_size >= sizeof(CacheTraceHeader) &&
+        memcmp(m_uncompressed_trace, CacheTraceHeader::Magic,
+               sizeof(CacheTraceHeader::Magic)) == 0) {
+        const CacheTraceHeader *header =
+            reinterpret_cast<const CacheTraceHeader *>(m_uncompressed_trace);
+        if (header->version != CacheTraceHeader::Version) {
+            fatal("Unsupported version %d of the ruby cache trace\n",
+                  header->version);
+        }
+        if (sizeof(CacheTraceHeader) + header->records_bytes +
+            header->snapshot_bytes > m_uncompressed_trace_size) {
+            fatal("Ruby cache trace is truncated\n");
+        }
+
+        m_compact_trace = true;
+        m_block_size_bytes = header->block_size_bytes;
+        m_bytes_read = sizeof(CacheTraceHeader);
+        m_trace_records_end = m_bytes_read + header->records_bytes;
+        if (header->snapshot_bytes > 0) {
+            m_trace_snapshot = m_uncompressed_trace + m_trace_records_end;
+            m_trace_snapshot_size = header->snapshot_bytes;
+        }
+        m_zero_block.assign(m_block_size_bytes, 0);
+        m_scratch_block.assign(m_block_size_bytes, 0);
+    }
+
     if (m_uncompressed_trace != NULL) {
         if (m_block_size_bytes < RubySystem::getBlockSizeBytes()) {
             // Block sizes larger than when the trace was recorded are not
@@ -73,7 +117,10 @@ CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
 CacheRecorder::~CacheRecorder()
 {
     if (m_uncompressed_trace != NULL) {
-        delete [] m_uncompressed_trace;
+        if (m_trace_mapped)
+            munmap(m_uncompressed_trace, m_uncompressed_trace_size);
+        else
+            delete [] m_uncompressed_trace;
         m_uncompressed_trace = NULL;
     }
     m_seq_map.clear();
@@ -83,117 +130,243 @@ void
 CacheRecorder::enqueueNextFlushRequest()
 {
     if (m_records_flushed < m_records.size()) {
-        TraceRecord* rec = m_records[m_records_flushed];
+        const Record &rec = m_records[m_records_flushed];
         m_records_flushed++;
-        Request* req = new Request(rec->m_data_address,
+        Request* req = new Request(rec.m_data_address,
                                    m_block_size_bytes, 0,
                                    Request::funcMasterId);
         MemCmd::Command requestType = MemCmd::FlushReq;
         Packet *pkt = new Packet(req, requestType);
 
-        Sequencer* m_sequencer_ptr = m_seq_map[rec->m_cntrl_id];
+        Sequencer* m_sequencer_ptr = m_seq_map[rec.m_cntrl_id];
         assert(m_sequencer_ptr != NULL);
         m_sequencer_ptr->makeRequest(pkt);
 
-        DPRINTF(RubyCacheTrace, "Flushing %s\n", *rec);
+        DPRINTF(RubyCacheTrace, "Flushing node %d, %#x\n", rec.m_cntrl_id,
+                rec.m_data_address);
     } else {
         DPRINTF(RubyCacheTrace, "Flushed all %d records\n", m_records_flushed);
     }
 }
 
+void
+CacheRecorder::issueFetchRequest(int cntrl, Addr data_addr,
+                                 RubyRequestType type, uint8_t *data)
+{
+    for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+            rec_bytes_read += RubySystem::getBlockSizeBytes()) {
+        Request* req = nullptr;
+        MemCmd::Command requestType;
+
+        if (type == RubyRequestType_LD) {
+            requestType = MemCmd::ReadReq;
+            req = new Request(data_addr + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0, Request::funcMasterId);
+        }   else if (type == RubyRequestType_IFETCH) {
+            requestType = MemCmd::ReadReq;
+            req = new Request(data_addr + rec_bytes_read,
+                    RubySystem::getBlockSizeBytes(),
+                    Request::INST_FETCH, Request::funcMasterId);
+        }   else {
+            requestType = MemCmd::WriteReq;
+            req = new Request(data_addr + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0, Request::funcMasterId);
+        }
+
+        Packet *pkt = new Packet(req, requestType);
+        pkt->dataStatic(data + rec_bytes_read);
+
+        Sequencer* m_sequencer_ptr = m_seq_map[cntrl];
+        assert(m_sequencer_ptr != NULL);
+        m_sequencer_ptr->makeRequest(pkt);
+    }
+}
+
 void
 CacheRecorder::enqueueNextFetchRequest()
 {
-    if (m_bytes_read < m_uncompressed_trace_size) {
+    if (m_bytes_read >= m_trace_records_end) {
+        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+        return;
+    }
+
+    if (!m_compact_trace) {
         TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
                                                                 m_bytes_read);
 
         DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
 
-        for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
-                rec_bytes_read += RubySystem::getBlockSizeBytes()) {
-            Request* req = nullptr;
-            MemCmd::Command requestType;
-
-            if (traceRecord->m_type == RubyRequestType_LD) {
-                requestType = MemCmd::ReadReq;
-                req = new Request(traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0, Request::funcMasterId);
-            }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
-                requestType = MemCmd::ReadReq;
-                req = new Request(traceRecord->m_data_address + rec_bytes_read,
-                        RubySystem::getBlockSizeBytes(),
-                        Request::INST_FETCH, Request::funcMasterId);
-            }   else {
-                requestType = MemCmd::WriteReq;
-                req = new Request(traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0, Request::funcMasterId);
-            }
-
-            Packet *pkt = new Packet(req, requestType);
-            pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
-
-            Sequencer* m_sequencer_ptr = m_seq_map[traceRecord->m_cntrl_id];
-            assert(m_sequencer_ptr != NULL);
-            m_sequencer_ptr->makeRequest(pkt);
-        }
+        issueFetchRequest(traceRecord->m_cntrl_id,
+                          traceRecord->m_data_address, traceRecord->m_type,
+                          traceRecord->m_data);
 
         m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
         m_records_read++;
+        return;
+    }
+
+    CompactTraceRecord *rec = reinterpret_cast<CompactTraceRecord *>(
+        m_uncompressed_trace + m_bytes_read);
+    m_bytes_read += sizeof(CompactTraceRecord);
+
+    RubyRequestType type = RubyRequestType(rec->m_type);
+    uint8_t *data;
+    if (!(rec->m_flags & CompactTraceRecord::ZeroBlock)) {
+        data = m_uncompressed_trace + m_bytes_read;
+        m_bytes_read += m_block_size_bytes;
+    } else if (type == RubyRequestType_LD || type == RubyRequestType_IFETCH) {
+        data = m_scratch_block.data();
     } else {
-        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+        data = m_zero_block.data();
     }
+
+    DPRINTF(RubyCacheTrace, "Issuing node %d, %#x, %s\n", rec->m_cntrl_id,
+            rec->m_data_address, type);
+
+    issueFetchRequest(rec->m_cntrl_id, rec->m_data_address, type, data);
+    m_records_read++;
 }
 
 void
 CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                          RubyRequestType type, Tick time, DataBlock& data)
 {
-    TraceRecord* rec = (TraceRecord*)malloc(sizeof(TraceRecord) +
-                                            m_block_size_bytes);
-    rec->m_cntrl_id     = cntrl;
-    rec->m_time         = time;
-    rec->m_data_address = data_addr;
-    rec->m_pc_address   = pc_addr;
-    rec->m_type         = type;
-    memcpy(rec->m_data, data.getData(0, m_block_size_bytes),
-           m_block_size_bytes);
+    Record rec;
+    rec.m_cntrl_id     = cntrl;
+    rec.m_time         = time;
+    rec.m_data_address = data_addr;
+    rec.m_type         = type;
+
+    const uint8_t *block = data.getData(0, m_block_size_bytes);
+    if (all_of(block, block + m_block_size_bytes,
+               [](uint8_t b) { return b == 0; })) {
+        rec.m_data_offset = -1;
+    } else {
+        rec.m_data_offset = m_record_data.size();
+        m_record_data.insert(m_record_data.end(), block,
+                             block + m_block_size_bytes);
+    }
 
     m_records.push_back(rec);
 }
 
-uint64_t
-CacheRecorder::aggregateRecords(uint8_t **buf, uint64_t total_size)
+void
+CacheRecorder::recordSnapshot(const vector<AbstractController *> &cntrls)
 {
-    std::sort(m_records.begin(), m_records.end(), compareTraceRecords);
-
-    int size = m_records.size();
-    uint64_t current_size = 0;
-    int record_size = sizeof(TraceRecord) + m_block_size_bytes;
-
-    for (int i = 0; i < size; ++i) {
-        // Determine if we need to expand the buffer size
-        if (current_size + record_size > total_size) {
-            uint8_t* new_buf = new (nothrow) uint8_t[total_size * 2];
-            if (new_buf == NULL) {
-                fatal("Unable to allocate buffer of size %s\n",
-                      total_size * 2);
-            }
-            total_size = total_size * 2;
-            uint8_t* old_buf = *buf;
-            memcpy(new_buf, old_buf, current_size);
-            *buf = new_buf;
-            delete [] old_buf;
+    m_snapshot.reset(new CacheSnapshot);
+    m_snapshot->put<uint32_t>(cntrls.size());
+
+    for (auto cntrl : cntrls) {
+        m_snapshot->put(cntrl->cacheSnapshotSignature());
+        uint64_t section = m_snapshot->reserve();
+        if (!cntrl->recordCacheSnapshot(*m_snapshot)) {
+            DPRINTF(RubyCacheTrace, "No snapshot of %s, only the cache "
+                    "trace is recorded\n", cntrl->name());
+            m_snapshot.reset();
+            return;
+        }
+        m_snapshot->patch(section);
+    }
+
+    DPRINTF(RubyCacheTrace, "Recorded snapshot of %d bytes\n",
+            m_snapshot->size());
+}
+
+bool
+CacheRecorder::installSnapshot(const vector<AbstractController *> &cntrls)
+{
+    if (m_trace_snapshot == NULL ||
+        m_block_size_bytes != RubySystem::getBlockSizeBytes()) {
+        return false;
+    }
+
+    // Check all controllers before installing anything, so that a
+    // mismatching snapshot leaves the caches untouched.
+    CacheSnapshot snapshot(m_trace_snapshot, m_trace_snapshot_size);
+    uint32_t num_cntrls;
+    snapshot.get(num_cntrls);
+    if (num_cntrls != cntrls.size())
+        return false;
+
+    for (auto cntrl : cntrls) {
+        string signature;
+        snapshot.get(signature);
+        if (signature != cntrl->cacheSnapshotSignature()) {
+            DPRINTF(RubyCacheTrace, "Snapshot does not match %s\n",
+                    cntrl->name());
+            return false;
         }
+        snapshot.skipSection();
+    }
 
-        // Copy the current record into the buffer
-        memcpy(&((*buf)[current_size]), m_records[i], record_size);
-        current_size += record_size;
+    snapshot.seek(0);
+    snapshot.get(num_cntrls);
+    for (auto cntrl : cntrls) {
+        string signature;
+        uint64_t section_bytes;
+        snapshot.get(signature);
+        snapshot.get(section_bytes);
 
-        free(m_records[i]);
-        m_records[i] = NULL;
+        uint64_t section_end = snapshot.position() + section_bytes;
+        cntrl->installCacheSnapshot(snapshot);
+        panic_if(snapshot.position() != section_end,
+                 "Snapshot of %s is corrupt\n", cntrl->name());
     }
 
+    return true;
+}
+
+void
+CacheRecorder::aggregateRecords(vector<uint8_t> &trace)
+{
+    stable_sort(m_records.begin(), m_records.end(),
+                [](const Record &r1, const Record &r2) {
+                    return r1.m_time > r2.m_time;
+                });
+
+    CacheTraceHeader header;
+    memcpy(header.magic, CacheTraceHeader::Magic, sizeof(header.magic));
+    header.version = CacheTraceHeader::Version;
+    header.block_size_bytes = m_block_size_bytes;
+    header.num_records = m_records.size();
+    header.records_bytes = m_records.size() * sizeof(CompactTraceRecord) +
+        m_record_data.size();
+    header.snapshot_bytes = m_snapshot ? m_snapshot->size() : 0;
+
+    trace.clear();
+    trace.reserve(sizeof(header) + header.records_bytes +
+                  header.snapshot_bytes);
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(&header);
+    trace.insert(trace.end(), p, p + sizeof(header));
+
+    for (const auto &rec : m_records) {
+        CompactTraceRecord crec;
+        memset(&crec, 0, sizeof(crec));
+        crec.m_data_address = rec.m_data_address;
+        crec.m_cntrl_id = rec.m_cntrl_id;
+        crec.m_type = rec.m_type;
+        crec.m_flags = rec.m_data_offset < 0 ? CompactTraceRecord::ZeroBlock
+                                             : 0;
+
+        p = reinterpret_cast<const uint8_t *>(&crec);
+        trace.insert(trace.end(), p, p + sizeof(crec));
+        if (rec.m_data_offset >= 0) {
+            auto data = m_record_data.begin() + rec.m_data_offset;
+            trace.insert(trace.end(), data, data + m_block_size_bytes);
+        }
+    }
+
+    if (m_snapshot) {
+        trace.insert(trace.end(), m_snapshot->data(),
+                     m_snapshot->data() + m_snapshot->size());
+    }
+
+    DPRINTF(RubyCacheTrace, "Aggregated %d records, %d of them zero "
+            "blocks, into a trace of %d bytes\n", m_records.size(),
+            m_records.size() - m_record_data.size() / m_block_size_bytes,
+            trace.size());
+
     m_records.clear();
-    return current_size;
+    m_record_data.clear();
+    m_snapshot.reset();
 }
@@ -35,6 +35,7 @@
 #ifndef __MEM_RUBY_RECORDER_CACHERECORDER_HH__
 #define __MEM_RUBY_RECORDER_CACHERECORDER_HH__
 
+#include <memory>
 #include <vector>
 
 #include "base/types.hh"
@@ -42,7 +43,9 @@
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/TypeDefines.hh"
+#include "mem/ruby/system/CacheSnapshot.hh"
 
+class AbstractController;
 class Sequencer;
 
 /*!
@@ -50,6 +53,9 @@ class Sequencer;
  * class is an array of length zero. It is used for creating variable
  * length object, so that while writing the data to a file one does not
  * need to copy the meta data and the actual data separately.
+ *
+ * This is the record format of traces written before CacheTraceHeader
+ * was introduced; it is only used to restore old checkpoints.
  */
 class TraceRecord {
   public:
@@ -63,20 +69,78 @@ class TraceRecord {
     void print(std::ostream& out) const;
 };
 
+/*!
+ * Header of a cache trace. It is followed by num_records records, each a
+ * CompactTraceRecord and the data of the block, and by a snapshot of the
+ * cache state (see CacheSnapshot) if one could be taken. All parts are
+ * 8-byte aligned, so that an uncompressed trace can be used in place
+ * after mapping it into memory.
+ */
+struct CacheTraceHeader
+{
+    static const char Magic[8];
+    static const uint32_t Version = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t block_size_bytes;
+    uint64_t num_records;
+    uint64_t records_bytes;
+    uint64_t snapshot_bytes;
+};
+
+struct CompactTraceRecord
+{
+    //! The block only holds zeros and its data is left out of the trace
+    static const uint8_t ZeroBlock = 0x1;
+
+    Addr m_data_address;
+    uint32_t m_cntrl_id;
+    uint8_t m_type;
+    uint8_t m_flags;
+    uint16_t m_reserved;
+};
+
 class CacheRecorder
 {
   public:
     CacheRecorder();
     ~CacheRecorder();
 
+    /*!
+     * Create a recorder that replays a trace read from a checkpoint. The
+     * recorder takes ownership of the trace, which was either allocated
+     * with new[] or, if trace_mapped is set, mapped with mmap().
+     */
     CacheRecorder(uint8_t* uncompressed_trace,
                   uint64_t uncompressed_trace_size,
+                  bool trace_mapped,
                   std::vector<Sequencer*>& SequencerMap,
                   uint64_t block_size_bytes);
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
-    uint64_t aggregateRecords(uint8_t **data, uint64_t size);
+    /*!
+     * Write the trace, i.e. the header, the records and the snapshot, to
+     * the given buffer. The records are discarded afterwards.
+     */
+    void aggregateRecords(std::vector<uint8_t> &trace);
+
+    /*!
+     * Take a snapshot of the state of the caches and directories of all
+     * controllers. If any controller does not support snapshots, only
+     * the trace is recorded.
+     */
+    void recordSnapshot(const std::vector<AbstractController *> &cntrls);
+
+    /*!
+     * Install the recorded snapshot directly into the caches and
+     * directories of the controllers. Returns false, without changing any
+     * state, if the trace has no snapshot or it was recorded for a
+     * different protocol or cache configuration. The trace then has to be
+     * replayed with enqueueNextFetchRequest() instead.
+     */
+    bool installSnapshot(const std::vector<AbstractController *> &cntrls);
 
     /*!
      * Function for flushing the memory contents of the caches to the
@@ -102,9 +166,38 @@ class CacheRecorder
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
-    std::vector<TraceRecord*> m_records;
+    struct Record
+    {
+        int m_cntrl_id;
+        Tick m_time;
+        Addr m_data_address;
+        RubyRequestType m_type;
+        //! Offset of the block data in m_record_data, or -1 for a block
+        //! of zeros
+        int64_t m_data_offset;
+    };
+
+    void issueFetchRequest(int cntrl, Addr data_addr, RubyRequestType type,
+                           uint8_t *data);
+
+    // Records of the caches being checkpointed, and the data of the blocks
+    std::vector<Record> m_records;
+    std::vector<uint8_t> m_record_data;
+    std::unique_ptr<CacheSnapshot> m_snapshot;
+
     uint8_t* m_uncompressed_trace;
     uint64_t m_uncompressed_trace_size;
+    bool m_trace_mapped;
+    //! Set if the trace has a CacheTraceHeader
+    bool m_compact_trace;
+    uint64_t m_trace_records_end;
+    const uint8_t *m_trace_snapshot;
+    uint64_t m_trace_snapshot_size;
+    //! Sources for the data of zero blocks in a compact trace. Reads
+    //! overwrite their buffer, so stores need a separate one.
+    std::vector<uint8_t> m_zero_block;
+    std::vector<uint8_t> m_scratch_block;
+
     std::vector<Sequencer*> m_seq_map;
     uint64_t m_bytes_read;
     uint64_t m_records_read;
@@ -112,12 +205,6 @@ class CacheRecorder
     uint64_t m_block_size_bytes;
 };
 
-inline bool
-compareTraceRecords(const TraceRecord* n1, const TraceRecord* n2)
-{
-    return n1->m_time > n2->m_time;
-}
-
 inline std::ostream&
 operator<<(std::ostream& out, const TraceRecord& obj)
 {
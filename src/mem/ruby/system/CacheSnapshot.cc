@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/system/CacheSnapshot.hh"
+
+#include "mem/ruby/system/RubySystem.hh"
+
+using namespace std;
+
+CacheSnapshot::CacheSnapshot()
+    : m_data(NULL), m_size(0), m_pos(0)
+{
+}
+
+CacheSnapshot::CacheSnapshot(const uint8_t *data, uint64_t size)
+    : m_data(data), m_size(size), m_pos(0)
+{
+}
+
+const uint8_t *
+CacheSnapshot::consume(uint64_t bytes)
+{
+    if (m_pos + bytes > size())
+        fatal("Ruby cache snapshot is truncated\n");
+
+    const uint8_t *p = data() + m_pos;
+    m_pos += bytes;
+    return p;
+}
+
+void
+CacheSnapshot::put(const string &value)
+{
+    put<uint32_t>(value.size());
+    m_buffer.insert(m_buffer.end(), value.begin(), value.end());
+}
+
+void
+CacheSnapshot::get(string &value)
+{
+    uint32_t len;
+    get(len);
+    const char *p = reinterpret_cast<const char *>(consume(len));
+    value.assign(p, len);
+}
+
+void
+CacheSnapshot::put(const DataBlock &value)
+{
+    const uint8_t *p = value.getData(0, RubySystem::getBlockSizeBytes());
+    m_buffer.insert(m_buffer.end(), p, p + RubySystem::getBlockSizeBytes());
+}
+
+void
+CacheSnapshot::get(DataBlock &value)
+{
+    value.setData(consume(RubySystem::getBlockSizeBytes()), 0,
+                  RubySystem::getBlockSizeBytes());
+}
+
+void
+CacheSnapshot::put(const Set &value)
+{
+    put<int32_t>(value.getSize());
+    for (NodeID i = 0; i < value.getSize(); i++) {
+        if (value.isElement(i))
+            put<NodeID>(i);
+    }
+    put<NodeID>(~NodeID(0));
+}
+
+void
+CacheSnapshot::get(Set &value)
+{
+    int32_t size;
+    get(size);
+    value.setSize(size);
+
+    NodeID i;
+    for (get(i); i != ~NodeID(0); get(i))
+        value.add(i);
+}
+
+void
+CacheSnapshot::put(const NetDest &value)
+{
+    put<uint32_t>(value.count());
+    for (int type = MachineType_FIRST; type < MachineType_NUM; type++) {
+        for (NodeID num = 0; num < MachineType_base_count(MachineType(type));
+             num++) {
+            MachineID mach(MachineType(type), num);
+            if (value.isElement(mach))
+                put(mach);
+        }
+    }
+}
+
+void
+CacheSnapshot::get(NetDest &value)
+{
+    uint32_t count;
+    get(count);
+
+    value.clear();
+    for (uint32_t i = 0; i < count; i++) {
+        MachineID mach;
+        get(mach);
+        value.add(mach);
+    }
+}
+
+uint64_t
+CacheSnapshot::reserve()
+{
+    uint64_t offset = m_buffer.size();
+    put<uint64_t>(0);
+    return offset;
+}
+
+void
+CacheSnapshot::patch(uint64_t offset)
+{
+    uint64_t bytes = m_buffer.size() - offset - sizeof(uint64_t);
+    memcpy(&m_buffer[offset], &bytes, sizeof(bytes));
+}
+
+void
+CacheSnapshot::skipSection()
+{
+    uint64_t bytes;
+    get(bytes);
+    consume(bytes);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Snapshot of the stable state of the Ruby caches and directories. A
+ * snapshot is recorded next to the cache trace when a checkpoint is taken
+ * and lets the caches be restored by installing their entries directly,
+ * instead of replaying the trace through the protocol.
+ */
+
+#ifndef __MEM_RUBY_SYSTEM_CACHESNAPSHOT_HH__
+#define __MEM_RUBY_SYSTEM_CACHESNAPSHOT_HH__
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "base/misc.hh"
+#include "base/types.hh"
+#include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/common/MachineID.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/common/Set.hh"
+
+class CacheSnapshot
+{
+  public:
+    /** Create an empty snapshot to record into. */
+    CacheSnapshot();
+
+    /** Read a recorded snapshot. The data is not copied. */
+    CacheSnapshot(const uint8_t *data, uint64_t size);
+
+    /** Plain values: integers, enums, Addr, Tick, Cycles, MachineID */
+    template <class T>
+    void
+    put(const T &value)
+    {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(&value);
+        m_buffer.insert(m_buffer.end(), p, p + sizeof(T));
+    }
+
+    void put(const std::string &value);
+    void put(const DataBlock &value);
+    void put(const Set &value);
+    void put(const NetDest &value);
+
+    template <class T>
+    void
+    get(T &value)
+    {
+        memcpy(&value, consume(sizeof(T)), sizeof(T));
+    }
+
+    void get(std::string &value);
+    void get(DataBlock &value);
+    void get(Set &value);
+    void get(NetDest &value);
+
+    /** Reserve room for a size that is only known later, see patch(). */
+    uint64_t reserve();
+    /** Fill in a reserved size with the bytes written since reserve(). */
+    void patch(uint64_t offset);
+
+    /** Skip over a section written between reserve() and patch(). */
+    void skipSection();
+
+    uint64_t position() const { return m_pos; }
+    void seek(uint64_t pos) { m_pos = pos; }
+    bool atEnd() const { return m_pos == size(); }
+
+    const uint8_t *data() const
+    { return m_data ? m_data : m_buffer.data(); }
+    uint64_t size() const { return m_data ? m_size : m_buffer.size(); }
+
+  private:
+    const uint8_t *consume(uint64_t bytes);
+
+    // Recorded snapshot
+    std::vector<uint8_t> m_buffer;
+
+    // Snapshot being read
+    const uint8_t *m_data;
+    uint64_t m_size;
+    uint64_t m_pos;
+};
+
+#endif // __MEM_RUBY_SYSTEM_CACHESNAPSHOT_HH__
@@ -29,6 +29,8 @@
 #include "mem/ruby/system/RubySystem.hh"
 
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <zlib.h>
 
 #include <cstdio>
@@ -58,6 +60,8 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params *p)
     : ClockedObject(p), m_access_backing_store(p->access_backing_store),
+      m_compress_cache_trace(p->compress_cache_trace),
+      m_direct_install_warmup(p->direct_install_warmup),
       m_cache_recorder(NULL)
 {
     m_randomization = p->randomization;
@@ -101,6 +105,7 @@ RubySystem::~RubySystem()
 void
 RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
                               uint64_t cache_trace_size,
+                              bool trace_mapped,
                               uint64_t block_size_bytes)
 {
     vector<Sequencer*> sequencer_map;
@@ -128,7 +133,8 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
 
     // Create the CacheRecorder and record the cache trace
     m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
-                                         sequencer_map, block_size_bytes);
+                                         trace_mapped, sequencer_map,
+                                         block_size_bytes);
 }
 
 void
@@ -138,10 +144,13 @@ RubySystem::memWriteback()
 
     // Make the trace so we know what to write back.
     DPRINTF(RubyCacheTrace, "Recording Cache Trace\n");
-    makeCacheRecorder(NULL, 0, getBlockSizeBytes());
+    makeCacheRecorder(NULL, 0, false, getBlockSizeBytes());
     for (int cntrl = 0; cntrl < m_abs_cntrl_vec.size(); cntrl++) {
         m_abs_cntrl_vec[cntrl]->recordCacheTrace(cntrl, m_cache_recorder);
     }
+    // The flush below changes the cache state, so the snapshot needs to
+    // be taken first
+    m_cache_recorder->recordSnapshot(m_abs_cntrl_vec);
     DPRINTF(RubyCacheTrace, "Cache Trace Complete\n");
 
     // save the current tick value
@@ -204,7 +213,7 @@ RubySystem::memWriteback()
 }
 
 void
-RubySystem::writeCompressedTrace(uint8_t *raw_data, string filename,
+RubySystem::writeCompressedTrace(const uint8_t *raw_data, string filename,
                                  uint64_t uncompressed_trace_size)
 {
     // Create the checkpoint file for the memory
@@ -229,7 +238,33 @@ RubySystem::writeCompressedTrace(uint8_t *raw_data, string filename,
     if (gzclose(compressedMemory)) {
         fatal("Close failed on memory trace file '%s'\n", filename);
     }
-    delete[] raw_data;
+}
+
+void
+RubySystem::writeTrace(const uint8_t *raw_data, string filename,
+                       uint64_t trace_size)
+{
+    string thefile = CheckpointIn::dir() + "/" + filename.c_str();
+
+    int fd = creat(thefile.c_str(), 0664);
+    if (fd < 0) {
+        perror("creat");
+        fatal("Can't open memory trace file '%s'\n", filename);
+    }
+
+    uint64_t written = 0;
+    while (written < trace_size) {
+        ssize_t ret = write(fd, raw_data + written, trace_size - written);
+        if (ret < 0) {
+            perror("write");
+            fatal("Write failed on memory trace file '%s'\n", filename);
+        }
+        written += ret;
+    }
+
+    if (close(fd)) {
+        fatal("Close failed on memory trace file '%s'\n", filename);
+    }
 }
 
 void
@@ -249,11 +284,19 @@ RubySystem::serialize(CheckpointOut &cp) const
     }
 
     // Aggregate the trace entries together into a single array
-    uint8_t *raw_data = new uint8_t[4096];
-    uint64_t cache_trace_size = m_cache_recorder->aggregateRecords(&raw_data,
-                                                                 4096);
-    string cache_trace_file = name() + ".cache.gz";
-    writeCompressedTrace(raw_data, cache_trace_file, cache_trace_size);
+    vector<uint8_t> raw_data;
+    m_cache_recorder->aggregateRecords(raw_data);
+    uint64_t cache_trace_size = raw_data.size();
+
+    string cache_trace_file;
+    if (m_compress_cache_trace) {
+        cache_trace_file = name() + ".cache.gz";
+        writeCompressedTrace(raw_data.data(), cache_trace_file,
+                             cache_trace_size);
+    } else {
+        cache_trace_file = name() + ".cache";
+        writeTrace(raw_data.data(), cache_trace_file, cache_trace_size);
+    }
 
     SERIALIZE_SCALAR(cache_trace_file);
     SERIALIZE_SCALAR(cache_trace_size);
@@ -301,6 +344,29 @@ RubySystem::readCompressedTrace(string filename, uint8_t *&raw_data,
     }
 }
 
+void
+RubySystem::mapTrace(string filename, uint8_t *&raw_data,
+                     uint64_t trace_size)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        fatal("Unable to open trace file %s", filename);
+    }
+
+    // The trace is mapped privately and writable, as replaying it reads
+    // the cache contents back into the records
+    void *addr = mmap(NULL, trace_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        perror("mmap");
+        fatal("Unable to map trace file %s", filename);
+    }
+    raw_data = static_cast<uint8_t *>(addr);
+
+    close(fd);
+}
+
 void
 RubySystem::unserialize(CheckpointIn &cp)
 {
@@ -319,13 +385,21 @@ RubySystem::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(cache_trace_size);
     cache_trace_file = cp.cptDir + "/" + cache_trace_file;
 
-    readCompressedTrace(cache_trace_file, uncompressed_trace,
-                        cache_trace_size);
+    // Uncompressed traces are used in place
+    bool trace_mapped = cache_trace_file.size() < 3 ||
+        cache_trace_file.compare(cache_trace_file.size() - 3, 3, ".gz") != 0;
+    if (trace_mapped) {
+        mapTrace(cache_trace_file, uncompressed_trace, cache_trace_size);
+    } else {
+        readCompressedTrace(cache_trace_file, uncompressed_trace,
+                            cache_trace_size);
+    }
     m_warmup_enabled = true;
     m_systems_to_warmup++;
 
     // Create the cache recorder that will hang around until startup.
-    makeCacheRecorder(uncompressed_trace, cache_trace_size, block_size_bytes);
+    makeCacheRecorder(uncompressed_trace, cache_trace_size, trace_mapped,
+                      block_size_bytes);
 }
 
 void
@@ -348,7 +422,17 @@ RubySystem::startup()
     // Ruby finishes restoring the state is less than the time when the
     // state was checkpointed.
 
-    if (m_warmup_enabled) {
+    if (m_warmup_enabled && m_direct_install_warmup &&
+        m_cache_recorder->installSnapshot(m_abs_cntrl_vec)) {
+        DPRINTF(RubyCacheTrace, "Installed ruby cache state from snapshot\n");
+
+        delete m_cache_recorder;
+        m_cache_recorder = NULL;
+        m_systems_to_warmup--;
+        if (m_systems_to_warmup == 0) {
+            m_warmup_enabled = false;
+        }
+    } else if (m_warmup_enabled) {
         DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
         // save the current tick value
         Tick curtick_original = curTick();
@@ -411,26 +495,40 @@ RubySystem::functionalRead(PacketPtr pkt)
     unsigned int num_busy = 0;
     unsigned int num_backing_store = 0;
     unsigned int num_invalid = 0;
+    AbstractController *readable_cntrl = NULL;
+    AbstractController *backing_store_cntrl = NULL;
 
     // In this loop we count the number of controllers that have the given
-    // address in read only, read write and busy states.
+    // address in read only, read write and busy states. Controllers whose
+    // line filter rules the address out need not be asked.
     for (unsigned int i = 0; i < num_controllers; ++i) {
+        if (!m_abs_cntrl_vec[i]->mayHoldLine(line_address)) {
+            num_invalid++;
+            continue;
+        }
+
         access_perm = m_abs_cntrl_vec[i]-> getAccessPermission(line_address);
-        if (access_perm == AccessPermission_Read_Only)
-            num_ro++;
-        else if (access_perm == AccessPermission_Read_Write)
-            num_rw++;
-        else if (access_perm == AccessPermission_Busy)
+        if (access_perm == AccessPermission_Read_Only ||
+            access_perm == AccessPermission_Read_Write) {
+            if (!readable_cntrl)
+                readable_cntrl = m_abs_cntrl_vec[i];
+            if (access_perm == AccessPermission_Read_Only)
+                num_ro++;
+            else
+                num_rw++;
+        } else if (access_perm == AccessPermission_Busy) {
             num_busy++;
-        else if (access_perm == AccessPermission_Backing_Store)
+        } else if (access_perm == AccessPermission_Backing_Store) {
             // See RubySlicc_Exports.sm for details, but Backing_Store is meant
             // to represent blocks in memory *for Broadcast/Snooping protocols*,
             // where memory has no idea whether it has an exclusive copy of data
             // or not.
             num_backing_store++;
-        else if (access_perm == AccessPermission_Invalid ||
-                 access_perm == AccessPermission_NotPresent)
+            backing_store_cntrl = m_abs_cntrl_vec[i];
+        } else if (access_perm == AccessPermission_Invalid ||
+                   access_perm == AccessPermission_NotPresent) {
             num_invalid++;
+        }
     }
     assert(num_rw <= 1);
 
@@ -444,13 +542,8 @@ RubySystem::functionalRead(PacketPtr pkt)
     // it only if it's not in the cache hierarchy at all.
     if (num_invalid == (num_controllers - 1) && num_backing_store == 1) {
         DPRINTF(RubySystem, "only copy in Backing_Store memory, read from it\n");
-        for (unsigned int i = 0; i < num_controllers; ++i) {
-            access_perm = m_abs_cntrl_vec[i]->getAccessPermission(line_address);
-            if (access_perm == AccessPermission_Backing_Store) {
-                m_abs_cntrl_vec[i]->functionalRead(line_address, pkt);
-                return true;
-            }
-        }
+        backing_store_cntrl->functionalRead(line_address, pkt);
+        return true;
     } else if (num_ro > 0 || num_rw == 1) {
         // In Broadcast/Snoop protocols, this covers if you know the block
         // exists somewhere in the caching hierarchy, then you want to read any
@@ -458,17 +551,10 @@ RubySystem::functionalRead(PacketPtr pkt)
         // to read any valid readable copy of the block.
         DPRINTF(RubySystem, "num_busy = %d, num_ro = %d, num_rw = %d\n",
                 num_busy, num_ro, num_rw);
-        // In this loop, we try to figure which controller has a read only or
-        // a read write copy of the given address. Any valid copy would suffice
-        // for a functional read.
-        for (unsigned int i = 0;i < num_controllers;++i) {
-            access_perm = m_abs_cntrl_vec[i]->getAccessPermission(line_address);
-            if (access_perm == AccessPermission_Read_Only ||
-                access_perm == AccessPermission_Read_Write) {
-                m_abs_cntrl_vec[i]->functionalRead(line_address, pkt);
-                return true;
-            }
-        }
+        // Any valid read only or read write copy of the given address would
+        // suffice for a functional read, so read the first one found.
+        readable_cntrl->functionalRead(line_address, pkt);
+        return true;
     }
 
     return false;
@@ -494,6 +580,9 @@ RubySystem::functionalWrite(PacketPtr pkt)
         num_functional_writes +=
             m_abs_cntrl_vec[i]->functionalWriteBuffers(pkt);
 
+        if (!m_abs_cntrl_vec[i]->mayHoldLine(line_addr))
+            continue;
+
         access_perm = m_abs_cntrl_vec[i]->getAccessPermission(line_addr);
         if (access_perm != AccessPermission_Invalid &&
             access_perm != AccessPermission_NotPresent) {
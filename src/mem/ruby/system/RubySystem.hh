@@ -108,13 +108,19 @@ class RubySystem : public ClockedObject
 
     void makeCacheRecorder(uint8_t *uncompressed_trace,
                            uint64_t cache_trace_size,
+                           bool trace_mapped,
                            uint64_t block_size_bytes);
 
     static void readCompressedTrace(std::string filename,
                                     uint8_t *&raw_data,
                                     uint64_t &uncompressed_trace_size);
-    static void writeCompressedTrace(uint8_t *raw_data, std::string file,
+    static void writeCompressedTrace(const uint8_t *raw_data,
+                                     std::string file,
                                      uint64_t uncompressed_trace_size);
+    static void mapTrace(std::string filename, uint8_t *&raw_data,
+                         uint64_t trace_size);
+    static void writeTrace(const uint8_t *raw_data, std::string file,
+                           uint64_t trace_size);
 
     void processRubyEvent();
   private:
@@ -129,6 +135,8 @@ class RubySystem : public ClockedObject
     static bool m_cooldown_enabled;
     SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const bool m_compress_cache_trace;
+    const bool m_direct_install_warmup;
 
     Network* m_network;
     std::vector<AbstractController *> m_abs_cntrl_vec;
@@ -46,6 +46,14 @@ class RubySystem(ClockedObject):
     access_backing_store = Param.Bool(False, "Use phys_mem as the functional \
         store and only use ruby for timing.")
 
+    compress_cache_trace = Param.Bool(True, "Compress the cache trace \
+        stored in checkpoints. An uncompressed trace is mapped into memory \
+        instead of being read when the checkpoint is restored.")
+    direct_install_warmup = Param.Bool(True, "On checkpoint restore, install \
+        the saved cache state directly into the caches instead of replaying \
+        the cache trace through the protocol, if the checkpoint has it and \
+        the configuration matches.")
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
@@ -53,6 +53,20 @@ python_class_map = {
                     "Cycles":"Cycles",
                    }
 
+# Configuration parameters that do not hold protocol state once the
+# system is drained, or whose state is covered by a cache snapshot.
+snapshot_param_types = set([ "int", "NodeID", "uint32_t", "std::string",
+                             "bool", "Cycles", "CacheMemory",
+                             "DirectoryMemory", "MessageBuffer",
+                             "WireBuffer", "Sequencer", "DMASequencer",
+                             "Prefetcher" ])
+
+# Entry fields that a cache snapshot knows how to save
+snapshot_field_types = set([ "bool", "int", "uint32_t", "uint64_t",
+                             "NodeID", "Addr", "Tick", "Cycles",
+                             "MachineID", "MachineType", "DataBlock",
+                             "Set", "NetDest" ])
+
 class StateMachine(Symbol):
     def __init__(self, symtab, ident, location, pairs, config_parameters):
         super(StateMachine, self).__init__(symtab, ident, location, pairs)
@@ -92,6 +106,8 @@ class StateMachine(Symbol):
         self.objects = []
         self.TBEType   = None
         self.EntryType = None
+        self.cache_entry_types = []
+        self.dir_entry_types = []
         self.debug_flags = set()
         self.debug_flags.add('RubyGenerated')
         self.debug_flags.add('RubySlicc')
@@ -155,7 +171,11 @@ class StateMachine(Symbol):
                            "single machine.");
             self.TBEType = type
 
+        elif "interface" in type and "AbstractEntry" == type["interface"]:
+            self.dir_entry_types.append(type)
+
         elif "interface" in type and "AbstractCacheEntry" == type["interface"]:
+            self.cache_entry_types.append(type)
             if "main" in type and "false" == type["main"].lower():
                 pass # this isn't the EntryType
             else:
@@ -164,6 +184,65 @@ class StateMachine(Symbol):
                                "single machine.");
                 self.EntryType = type
 
+    # True if the protocol state of this machine is only held in its
+    # caches, its directory and its TBEs
+    def stateInCachesAndTBEs(self):
+        for param in self.config_parameters:
+            if param.type_ast.type.c_ident not in snapshot_param_types:
+                return False
+
+        for var in self.objects:
+            if not (var.type.isPrimitive or var.type.isBuffer or
+                    var.type.ident == "TBETable"):
+                return False
+
+        return True
+
+    # Returns the caches whose contents, together with the TBEs, determine
+    # which lines this machine holds, or None if that cannot be tracked
+    # with a line filter (see AbstractController::mayHoldLine()).
+    def lineFilterCaches(self):
+        if not self.stateInCachesAndTBEs():
+            return None
+
+        caches = [ param for param in self.config_parameters
+                   if param.type_ast.type.ident == "CacheMemory" ]
+        if not caches or any(param.type_ast.type.ident == "DirectoryMemory"
+                             for param in self.config_parameters):
+            return None
+
+        return caches
+
+    # Returns the entry types of the caches and of the directory of this
+    # machine if all of its stable state can be saved in a cache snapshot,
+    # or None otherwise.
+    def snapshotEntryTypes(self):
+        if not self.stateInCachesAndTBEs():
+            return None
+
+        cache_entry = None
+        dir_entry = None
+        if any(param.type_ast.type.ident == "CacheMemory"
+               for param in self.config_parameters):
+            if len(self.cache_entry_types) != 1:
+                return None
+            cache_entry = self.cache_entry_types[0]
+        if any(param.type_ast.type.ident == "DirectoryMemory"
+               for param in self.config_parameters):
+            if len(self.dir_entry_types) != 1:
+                return None
+            dir_entry = self.dir_entry_types[0]
+
+        for entry in (cache_entry, dir_entry):
+            if entry is None:
+                continue
+            for dm in entry.data_members.values():
+                if not (dm.type.isEnumeration or
+                        dm.type.c_ident in snapshot_field_types):
+                    return None
+
+        return (cache_entry, dir_entry)
+
     # Needs to be called before accessing the table
     def buildTable(self):
         assert self.table is None
@@ -309,6 +388,9 @@ class $c_ident : public AbstractController
     void collateStats();
 
     void recordCacheTrace(int cntrl, CacheRecorder* tr);
+    bool recordCacheSnapshot(CacheSnapshot &snapshot);
+    void installCacheSnapshot(CacheSnapshot &snapshot);
+    std::string cacheSnapshotSignature() const;
     Sequencer* getCPUSequencer() const;
     GPUCoalescer* getGPUCoalescer() const;
 
@@ -635,6 +717,19 @@ $c_ident::init()
                         comment = "Type %s default" % vtype.ident
                         code('*$vid = ${{vtype["default"]}}; // $comment')
 
+        # Track the lines held by the caches and TBEs
+        caches = self.lineFilterCaches()
+        if caches is not None:
+            num_lines = " + ".join("m_%s_ptr->getNumBlocks()" % param.ident
+                                   for param in caches)
+            code()
+            code('initLineFilter($num_lines);')
+            for param in caches:
+                code('m_${{param.ident}}_ptr->addLineFilter(m_line_filter);')
+            for var in self.objects:
+                if var.type.ident == "TBETable":
+                    code('m_${{var.ident}}_ptr->setLineFilter(m_line_filter);')
+
         # Set the prefetchers
         code()
         for prefetcher in self.prefetchers:
@@ -933,6 +1028,11 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
         code.dedent()
         code('''
 }
+''')
+
+        self.printCacheSnapshot(code)
+
+        code('''
 
 // Actions
 ''')
@@ -1156,6 +1256,131 @@ ${ident}_Controller::wakeup()
 
         code.write(path, "%s_Wakeup.cc" % self.ident)
 
+    def printCacheSnapshot(self, code):
+        c_ident = "%s_Controller" % self.ident
+        entry_types = self.snapshotEntryTypes()
+
+        if entry_types is None:
+            code('''
+bool
+$c_ident::recordCacheSnapshot(CacheSnapshot &snapshot)
+{
+    // The protocol state of this controller is not only held in its
+    // caches and directory
+    return false;
+}
+
+void
+$c_ident::installCacheSnapshot(CacheSnapshot &snapshot)
+{
+    panic("$c_ident does not support cache snapshots");
+}
+
+std::string
+$c_ident::cacheSnapshotSignature() const
+{
+    return "$c_ident";
+}
+''')
+            return
+
+        cache_entry, dir_entry = entry_types
+        params = [ (param, cache_entry) for param in self.config_parameters
+                   if param.type_ast.type.ident == "CacheMemory" ]
+        params += [ (param, dir_entry) for param in self.config_parameters
+                    if param.type_ast.type.ident == "DirectoryMemory" ]
+
+        # The layout of the entries, so that a snapshot is never installed
+        # into a controller generated from a different protocol
+        layout = []
+        for entry in (cache_entry, dir_entry):
+            if entry is None:
+                continue
+            fields = []
+            for dm in entry.data_members.values():
+                field = "%s %s" % (dm.type.c_ident, dm.ident)
+                if dm.type.isEnumeration:
+                    field += "[%d]" % len(dm.type.enums)
+                fields.append(field)
+            layout.append("%s{%s}" % (entry.c_ident, ",".join(fields)))
+        layout = ";".join(layout)
+
+        code('''
+bool
+$c_ident::recordCacheSnapshot(CacheSnapshot &snapshot)
+{
+''')
+        code.indent()
+        for var in self.objects:
+            if var.type.ident == "TBETable":
+                code('''
+if (!m_${{var.ident}}_ptr->isEmpty())
+    return false;
+''')
+
+        for param, entry in params:
+            base = "AbstractCacheEntry"
+            if param.type_ast.type.ident == "DirectoryMemory":
+                base = "AbstractEntry"
+            code('''
+m_${{param.ident}}_ptr->recordSnapshot(snapshot,
+    [](CacheSnapshot &snapshot, const $base *abstract_entry) {
+        const ${{entry.c_ident}} *entry =
+            static_cast<const ${{entry.c_ident}} *>(abstract_entry);
+''')
+            code.indent()
+            code.indent()
+            for dm in entry.data_members.values():
+                code('snapshot.put(entry->m_${{dm.ident}});')
+            code.dedent()
+            code.dedent()
+            code('    });')
+
+        code('''
+return true;
+''')
+        code.dedent()
+        code('''
+}
+
+void
+$c_ident::installCacheSnapshot(CacheSnapshot &snapshot)
+{
+''')
+        code.indent()
+        for param, entry in params:
+            base = "AbstractCacheEntry"
+            if param.type_ast.type.ident == "DirectoryMemory":
+                base = "AbstractEntry"
+            code('''
+m_${{param.ident}}_ptr->installSnapshot(snapshot,
+    [](CacheSnapshot &snapshot) -> $base * {
+        ${{entry.c_ident}} *entry = new ${{entry.c_ident}};
+''')
+            code.indent()
+            code.indent()
+            for dm in entry.data_members.values():
+                code('snapshot.get(entry->m_${{dm.ident}});')
+            code('return entry;')
+            code.dedent()
+            code.dedent()
+            code('    });')
+        code.dedent()
+        code('''
+}
+
+std::string
+$c_ident::cacheSnapshotSignature() const
+{
+    std::string signature = "$c_ident:$layout";
+''')
+        code.indent()
+        for param, entry in params:
+            code('signature += ":" + m_${{param.ident}}_ptr->snapshotSignature();')
+        code('return signature;')
+        code.dedent()
+        code('}')
+
     def printCSwitch(self, path):
         '''Output switch statement for transition table'''
 
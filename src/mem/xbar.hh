@@ -446,11 +446,12 @@ class BaseXBar : public MemObject
      * size are two-dimensional vectors that are indexed by the
      * slave port and master port id (thus the neighbouring master and
      * neighbouring slave), summing up both directions (request and
-     * response).
+     * response). They are sharded as threads of other event queues
+     * update them when accessing the crossbar atomically.
      */
-    Stats::Vector transDist;
-    Stats::Vector2d pktCount;
-    Stats::Vector2d pktSize;
+    Stats::ShardedVector transDist;
+    Stats::ShardedVector2d pktCount;
+    Stats::ShardedVector2d pktSize;
 
   public:
 
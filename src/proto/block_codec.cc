@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "proto/block_codec.hh"
+
+#include <zlib.h>
+
+#include <cassert>
+#include <cstring>
+
+#include "base/misc.hh"
+#include "config/have_zstd.hh"
+
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace std;
+
+static void
+putLE(string &out, uint64_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; ++i)
+        out.push_back(char(value >> (8 * i)));
+}
+
+static uint64_t
+getLE(const char *in, unsigned bytes)
+{
+    uint64_t value = 0;
+    for (unsigned i = 0; i < bytes; ++i)
+        value |= uint64_t(uint8_t(in[i])) << (8 * i);
+    return value;
+}
+
+/**
+ * Each block is a gzip member, and a gzip file may hold several. The
+ * skippable frames are empty members that carry their data in an extra
+ * field of the header.
+ */
+class GzipCodec : public BlockCodec
+{
+  protected:
+    /** Header up to the extra field, and the extra subfield ID */
+    static const size_t headerSize = 12;
+    static const size_t subfieldHeaderSize = 4;
+    /** An empty deflate stream, with the CRC and size of no data */
+    static const size_t trailerSize = 10;
+
+  public:
+    const char *name() const override { return "gzip"; }
+
+    void
+    compress(const string &block, string &frame) const override
+    {
+        z_stream zs;
+        memset(&zs, 0, sizeof(zs));
+        if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16,
+                         8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            panic("Failed to initialise gzip compression\n");
+        }
+
+        frame.resize(deflateBound(&zs, block.size()));
+        zs.next_in = (Bytef *)block.data();
+        zs.avail_in = block.size();
+        zs.next_out = (Bytef *)&frame[0];
+        zs.avail_out = frame.size();
+        if (deflate(&zs, Z_FINISH) != Z_STREAM_END)
+            panic("Failed to gzip a block of a proto stream\n");
+
+        frame.resize(zs.total_out);
+        deflateEnd(&zs);
+    }
+
+    bool
+    decompress(const char *frame, size_t frame_size, size_t size,
+               string &block) const override
+    {
+        z_stream zs;
+        memset(&zs, 0, sizeof(zs));
+        if (inflateInit2(&zs, 15 + 16) != Z_OK)
+            return false;
+
+        block.resize(size);
+        zs.next_in = (Bytef *)frame;
+        zs.avail_in = frame_size;
+        zs.next_out = (Bytef *)&block[0];
+        zs.avail_out = size;
+        bool ok = inflate(&zs, Z_FINISH) == Z_STREAM_END &&
+            zs.total_out == size;
+        inflateEnd(&zs);
+        return ok;
+    }
+
+    void
+    wrapSkippable(const string &data, string &frame) const override
+    {
+        assert(data.size() <= maxSkippable());
+
+        frame.clear();
+        // Magic, deflate, FEXTRA flag, no time, no XFL, unknown OS
+        frame += string("\x1f\x8b\x08\x04\0\0\0\0\0\xff", 10);
+        putLE(frame, data.size() + subfieldHeaderSize, 2);
+        frame += "g5";
+        putLE(frame, data.size(), 2);
+        frame += data;
+        frame += string("\x03\0\0\0\0\0\0\0\0\0", trailerSize);
+    }
+
+    size_t
+    unwrapSkippable(const char *frame, size_t avail,
+                    string &data) const override
+    {
+        if (avail < skippableOverhead() ||
+            memcmp(frame, "\x1f\x8b\x08\x04", 4) != 0 ||
+            memcmp(frame + headerSize, "g5", 2) != 0) {
+            return 0;
+        }
+
+        size_t size = getLE(frame + headerSize + 2, 2);
+        size_t frame_size = size + skippableOverhead();
+        if (getLE(frame + 10, 2) != size + subfieldHeaderSize ||
+            avail < frame_size) {
+            return 0;
+        }
+
+        data.assign(frame + headerSize + subfieldHeaderSize, size);
+        return frame_size;
+    }
+
+    size_t
+    skippableOverhead() const override
+    {
+        return headerSize + subfieldHeaderSize + trailerSize;
+    }
+
+    size_t
+    maxSkippable() const override
+    {
+        return 0xffff - subfieldHeaderSize;
+    }
+};
+
+#if HAVE_ZSTD
+/**
+ * Each block is a zstd frame, and the index goes in skippable frames
+ * that the format provides for metadata.
+ */
+class ZstdCodec : public BlockCodec
+{
+  protected:
+    static const uint32_t skippableMagic = 0x184d2a5e;
+    static const size_t headerSize = 8;
+
+  public:
+    const char *name() const override { return "zstd"; }
+
+    void
+    compress(const string &block, string &frame) const override
+    {
+        frame.resize(ZSTD_compressBound(block.size()));
+        size_t size = ZSTD_compress(&frame[0], frame.size(), block.data(),
+                                    block.size(), 3);
+        if (ZSTD_isError(size)) {
+            panic("Failed to compress a block of a proto stream: %s\n",
+                  ZSTD_getErrorName(size));
+        }
+        frame.resize(size);
+    }
+
+    bool
+    decompress(const char *frame, size_t frame_size, size_t size,
+               string &block) const override
+    {
+        block.resize(size);
+        size_t got = ZSTD_decompress(&block[0], size, frame, frame_size);
+        return !ZSTD_isError(got) && got == size;
+    }
+
+    void
+    wrapSkippable(const string &data, string &frame) const override
+    {
+        frame.clear();
+        putLE(frame, skippableMagic, 4);
+        putLE(frame, data.size(), 4);
+        frame += data;
+    }
+
+    size_t
+    unwrapSkippable(const char *frame, size_t avail,
+                    string &data) const override
+    {
+        if (avail < headerSize || getLE(frame, 4) != skippableMagic)
+            return 0;
+
+        size_t size = getLE(frame + 4, 4);
+        if (avail - headerSize < size)
+            return 0;
+
+        data.assign(frame + headerSize, size);
+        return headerSize + size;
+    }
+
+    size_t skippableOverhead() const override { return headerSize; }
+
+    size_t maxSkippable() const override { return 0xffffffff; }
+};
+#endif
+
+static bool
+hasExtension(const string &filename, const string &ext)
+{
+    return filename.size() > ext.size() &&
+        filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+const vector<const BlockCodec *> &
+BlockCodec::all()
+{
+    static const vector<const BlockCodec *> codecs = {
+        new GzipCodec,
+#if HAVE_ZSTD
+        new ZstdCodec,
+#endif
+    };
+
+    return codecs;
+}
+
+const BlockCodec *
+BlockCodec::forFile(const string &filename)
+{
+    if (hasExtension(filename, ".gz"))
+        return all()[0];
+
+    if (hasExtension(filename, ".zst")) {
+#if HAVE_ZSTD
+        return all()[1];
+#else
+        fatal("Can't write %s, gem5 was built without zstd support\n",
+              filename);
+#endif
+    }
+
+    return NULL;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Compression of the blocks of an indexed proto stream.
+ */
+
+#ifndef __PROTO_BLOCK_CODEC_HH__
+#define __PROTO_BLOCK_CODEC_HH__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * A BlockCodec compresses each block of an indexed proto stream into a
+ * self-contained frame of its format, so that the frames of a stream
+ * concatenate into a valid file of that format. It also wraps the index
+ * of the stream in frames that regular decompressors skip, which keeps
+ * the traces readable by gunzip, zstd and the Python decoders.
+ */
+class BlockCodec
+{
+  public:
+    virtual ~BlockCodec() {}
+
+    /**
+     * Get the codec to use for a file name, based on its extension.
+     *
+     * @return The codec, or NULL if the file is not block compressed
+     */
+    static const BlockCodec *forFile(const std::string &filename);
+
+    /** All the codecs, to recognise the one of an existing file */
+    static const std::vector<const BlockCodec *> &all();
+
+    virtual const char *name() const = 0;
+
+    /** Compress a block into a frame. */
+    virtual void compress(const std::string &block,
+                          std::string &frame) const = 0;
+
+    /**
+     * Decompress a frame.
+     *
+     * @param size Size of the block, as recorded in the index
+     * @return False if the frame is corrupt
+     */
+    virtual bool decompress(const char *frame, size_t frame_size,
+                            size_t size, std::string &block) const = 0;
+
+    /** Wrap data in a frame that decompressors skip. */
+    virtual void wrapSkippable(const std::string &data,
+                               std::string &frame) const = 0;
+
+    /**
+     * Get the data of a frame created by wrapSkippable().
+     *
+     * @param avail Bytes available from the start of the frame
+     * @return The size of the frame, or 0 if there is no such frame
+     */
+    virtual size_t unwrapSkippable(const char *frame, size_t avail,
+                                   std::string &data) const = 0;
+
+    /** Bytes wrapSkippable() adds around the data */
+    virtual size_t skippableOverhead() const = 0;
+
+    /** Largest amount of data that fits in a skippable frame */
+    virtual size_t maxSkippable() const = 0;
+};
+
+#endif //__PROTO_BLOCK_CODEC_HH__
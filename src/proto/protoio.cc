@@ -39,33 +39,134 @@
 
 #include "proto/protoio.hh"
 
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+
 #include "base/misc.hh"
+#include "proto/block_codec.hh"
 
 using namespace std;
 using namespace google::protobuf;
 
+/// Tags of the frames holding the index and the trailer pointing to it
+static const char indexTag[4] = { 'g', '5', 'i', 'x' };
+static const char trailerTag[4] = { 'g', '5', 't', 'r' };
+static const uint32_t indexVersion = 1;
+
+/// Encoded size of an index entry and of the trailer
+static const size_t indexEntrySize = 8 + 4 + 4 + 4 + 4 * 8;
+static const size_t trailerSize = 4 + 4 + 8 + 8;
+
+static void
+putLE(string &out, uint64_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; ++i)
+        out.push_back(char(value >> (8 * i)));
+}
+
+static uint64_t
+getLE(const char *in, unsigned bytes)
+{
+    uint64_t value = 0;
+    for (unsigned i = 0; i < bytes; ++i)
+        value |= uint64_t(uint8_t(in[i])) << (8 * i);
+    return value;
+}
+
+void
+ProtoStream::BlockInfo::clearKeys()
+{
+    minTick = noKey;
+    maxTick = 0;
+    minInst = noKey;
+    maxInst = 0;
+}
+
+void
+ProtoStream::BlockInfo::addKeys(uint64_t tick, uint64_t inst)
+{
+    minTick = min(minTick, tick);
+    maxTick = max(maxTick, tick);
+    if (inst != noKey) {
+        minInst = min(minInst, inst);
+        maxInst = max(maxInst, inst);
+    }
+}
+
+/**
+ * Worker threads that compress and write the blocks of all the output
+ * streams. They are never stopped, as streams may be closed as late as
+ * the destruction of static objects.
+ */
+class ProtoWorkers
+{
+  public:
+    static ProtoWorkers &
+    get()
+    {
+        static ProtoWorkers *workers = new ProtoWorkers;
+        return *workers;
+    }
+
+    void
+    run(const function<void()> &job)
+    {
+        {
+            lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(job);
+        }
+        work.notify_one();
+    }
+
+    unsigned size() const { return threads.size(); }
+
+  private:
+    ProtoWorkers()
+    {
+        unsigned num_threads =
+            min(max(thread::hardware_concurrency(), 1u), 4u);
+        for (unsigned i = 0; i < num_threads; ++i)
+            threads.emplace_back(&ProtoWorkers::loop, this);
+    }
+
+    void
+    loop()
+    {
+        unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            work.wait(lock, [this]{ return !jobs.empty(); });
+            function<void()> job = move(jobs.front());
+            jobs.pop_front();
+
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex;
+    condition_variable work;
+    deque<function<void()>> jobs;
+    vector<thread> threads;
+};
+
 ProtoOutputStream::ProtoOutputStream(const string& filename) :
     fileStream(filename.c_str(), ios::out | ios::binary | ios::trunc),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    fileName(filename), codec(BlockCodec::forFile(filename)),
+    submittedBlocks(0), writtenBlocks(0), fileOffset(0)
 {
     if (!fileStream.good())
         panic("Could not open %s for writing\n", filename);
 
-    // Wrap the output file in a zero copy stream, that in turn is
-    // wrapped in a gzip stream if the filename ends with .gz. The
-    // latter stream is in turn wrapped in a coded stream
-    wrappedFileStream = new io::OstreamOutputStream(&fileStream);
-    if (filename.find_last_of('.') != string::npos &&
-        filename.substr(filename.find_last_of('.') + 1) == "gz") {
-        gzipStream = new io::GzipOutputStream(wrappedFileStream);
-        zeroCopyStream = gzipStream;
-    } else {
-        zeroCopyStream = wrappedFileStream;
-    }
+    blockInfo.messages = 0;
+    blockInfo.clearKeys();
 
     // Write the magic number to the file
-    io::CodedOutputStream codedStream(zeroCopyStream);
-    codedStream.WriteLittleEndian32(magicNumber);
+    block.reserve(blockSize);
+    putLE(block, magicNumber, 4);
 
     // Note that each type of stream (packet, instruction etc) should
     // add its own header and perform the appropriate checks
@@ -73,40 +174,175 @@ ProtoOutputStream::ProtoOutputStream(const string& filename) :
 
 ProtoOutputStream::~ProtoOutputStream()
 {
-    // As the compression is optional, see if the stream exists
-    if (gzipStream != NULL)
-        delete gzipStream;
-    delete wrappedFileStream;
+    if (!block.empty())
+        submitBlock();
+
+    {
+        unique_lock<std::mutex> lock(mutex);
+        written.wait(lock, [this]{
+            return writtenBlocks == submittedBlocks;
+        });
+    }
+
+    if (codec)
+        writeIndex();
+
     fileStream.close();
+    if (fileStream.fail())
+        warn("Failed to write %s\n", fileName);
 }
 
 void
 ProtoOutputStream::write(const Message& msg)
 {
-    // Due to the byte limit of the coded stream we create it for
-    // every single mesage (based on forum discussions around the size
-    // limitation)
-    io::CodedOutputStream codedStream(zeroCopyStream);
+    // Write the size of the message followed by the message itself to
+    // the block. Messages never cross blocks, which is what lets the
+    // blocks be read independently
+    uint32_t size = msg.ByteSize();
+    size_t pos = block.size();
+    block.resize(pos + io::CodedOutputStream::VarintSize32(size) + size);
+
+    uint8 *p = reinterpret_cast<uint8 *>(&block[pos]);
+    p = io::CodedOutputStream::WriteVarint32ToArray(size, p);
+    msg.SerializeWithCachedSizesToArray(p);
+    ++blockInfo.messages;
+
+    if (block.size() >= blockSize)
+        submitBlock();
+}
+
+void
+ProtoOutputStream::write(const Message& msg, uint64_t tick, uint64_t inst)
+{
+    // Note the keys first, as writing may hand the block over
+    blockInfo.addKeys(tick, inst);
+    write(msg);
+}
+
+void
+ProtoOutputStream::submitBlock()
+{
+    // Bound the memory used by the blocks of a stream that produces
+    // them faster than they are compressed
+    const uint64_t max_pending = 2 * ProtoWorkers::get().size() + 1;
+
+    uint64_t seq;
+    {
+        unique_lock<std::mutex> lock(mutex);
+        written.wait(lock, [this, max_pending]{
+            return submittedBlocks - writtenBlocks < max_pending;
+        });
+        seq = submittedBlocks++;
+    }
+
+    shared_ptr<string> data(new string);
+    data->swap(block);
+    block.reserve(blockSize);
+    BlockInfo info = blockInfo;
+    blockInfo.messages = 0;
+    blockInfo.clearKeys();
+
+    ProtoWorkers::get().run([this, seq, data, info]{
+        compressBlock(seq, *data, info);
+    });
+}
+
+void
+ProtoOutputStream::compressBlock(uint64_t seq, string &data,
+                                 const BlockInfo &info)
+{
+    Frame frame;
+    frame.info = info;
+    frame.info.size = data.size();
+    if (codec)
+        codec->compress(data, frame.data);
+    else
+        frame.data.swap(data);
+
+    lock_guard<std::mutex> lock(mutex);
+    ready[seq] = move(frame);
+    writeFrames();
+}
+
+void
+ProtoOutputStream::writeFrames()
+{
+    bool wrote = false;
+
+    for (auto it = ready.begin();
+         it != ready.end() && it->first == writtenBlocks;
+         it = ready.erase(it)) {
+        Frame &frame = it->second;
+        fileStream.write(frame.data.data(), frame.data.size());
+
+        frame.info.offset = fileOffset;
+        frame.info.frameSize = frame.data.size();
+        index.push_back(frame.info);
+
+        fileOffset += frame.data.size();
+        ++writtenBlocks;
+        wrote = true;
+    }
+
+    if (wrote)
+        written.notify_all();
+}
+
+void
+ProtoOutputStream::writeIndex()
+{
+    const uint64_t index_offset = fileOffset;
+    const size_t per_frame =
+        (codec->maxSkippable() - sizeof(indexTag)) / indexEntrySize;
+
+    string frame;
+    for (size_t first = 0; first < index.size(); first += per_frame) {
+        size_t last = min(index.size(), first + per_frame);
 
-    // Write the size of the message to the stream
-    codedStream.WriteVarint32(msg.ByteSize());
+        string data(indexTag, sizeof(indexTag));
+        for (size_t i = first; i < last; ++i) {
+            putLE(data, index[i].offset, 8);
+            putLE(data, index[i].frameSize, 4);
+            putLE(data, index[i].size, 4);
+            putLE(data, index[i].messages, 4);
+            putLE(data, index[i].minTick, 8);
+            putLE(data, index[i].maxTick, 8);
+            putLE(data, index[i].minInst, 8);
+            putLE(data, index[i].maxInst, 8);
+        }
+
+        codec->wrapSkippable(data, frame);
+        fileStream.write(frame.data(), frame.size());
+        fileOffset += frame.size();
+    }
 
-    // Write the message itself to the stream
-    msg.SerializeWithCachedSizes(&codedStream);
+    string trailer(trailerTag, sizeof(trailerTag));
+    putLE(trailer, indexVersion, 4);
+    putLE(trailer, index_offset, 8);
+    putLE(trailer, index.size(), 8);
+    codec->wrapSkippable(trailer, frame);
+    fileStream.write(frame.data(), frame.size());
 }
 
 ProtoInputStream::ProtoInputStream(const string& filename) :
     fileStream(filename.c_str(), ios::in | ios::binary), fileName(filename),
     useGzip(false),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL),
+    codec(NULL), nextBlock(0), blockStream(NULL), prefetchBlock(0)
 {
     if (!fileStream.good())
         panic("Could not open %s for reading\n", filename);
 
-    // check the magic number to see if this is a gzip stream
-    unsigned char bytes[2];
-    fileStream.read((char*) bytes, 2);
-    useGzip = fileStream.good() && bytes[0] == 0x1f && bytes[1] == 0x8b;
+    // Prefer reading the blocks of an indexed stream directly, which
+    // lets us seek to any of them
+    if (!readIndex()) {
+        // check the magic number to see if this is a gzip stream
+        unsigned char bytes[2];
+        fileStream.clear();
+        fileStream.seekg(0, ifstream::beg);
+        fileStream.read((char*) bytes, 2);
+        useGzip = fileStream.good() && bytes[0] == 0x1f && bytes[1] == 0x8b;
+    }
 
     // seek to the start of the input file and clear any flags
     fileStream.clear();
@@ -120,16 +356,19 @@ ProtoInputStream::createStreams()
 {
     // All streams should be NULL at this point
     assert(wrappedFileStream == NULL && gzipStream == NULL &&
-           zeroCopyStream == NULL);
+           zeroCopyStream == NULL && blockStream == NULL);
 
     // Wrap the input file in a zero copy stream, that in turn is
     // wrapped in a gzip stream if the filename ends with .gz. The
     // latter stream is in turn wrapped in a coded stream
-    wrappedFileStream = new io::IstreamInputStream(&fileStream);
-    if (useGzip) {
+    if (codec) {
+        loadBlock(0);
+    } else if (useGzip) {
+        wrappedFileStream = new io::IstreamInputStream(&fileStream);
         gzipStream = new io::GzipInputStream(wrappedFileStream);
         zeroCopyStream = gzipStream;
     } else {
+        wrappedFileStream = new io::IstreamInputStream(&fileStream);
         zeroCopyStream = wrappedFileStream;
     }
 
@@ -151,15 +390,231 @@ ProtoInputStream::destroyStreams()
     }
     delete wrappedFileStream;
     wrappedFileStream = NULL;
+    delete blockStream;
+    blockStream = NULL;
+    cancelPrefetch();
 
     zeroCopyStream = NULL;
 }
 
+bool
+ProtoInputStream::readIndex()
+{
+    fileStream.seekg(0, ifstream::end);
+    const uint64_t file_size = fileStream.tellg();
+
+    for (auto candidate : BlockCodec::all()) {
+        // Look for the trailer at the end of the file
+        const size_t frame_size =
+            candidate->skippableOverhead() + trailerSize;
+        if (file_size < frame_size)
+            continue;
+
+        string frame(frame_size, '\0');
+        string trailer;
+        fileStream.clear();
+        fileStream.seekg(file_size - frame_size, ifstream::beg);
+        if (!fileStream.read(&frame[0], frame_size) ||
+            candidate->unwrapSkippable(frame.data(), frame_size,
+                                       trailer) != frame_size ||
+            trailer.size() != trailerSize ||
+            trailer.compare(0, sizeof(trailerTag), trailerTag,
+                            sizeof(trailerTag)) != 0) {
+            continue;
+        }
+
+        // Fall back to reading the file as a whole if it was written
+        // by another version
+        const uint32_t version = getLE(&trailer[4], 4);
+        if (version != indexVersion) {
+            warn("Ignoring the index of %s, which has unsupported "
+                 "version %d\n", fileName, version);
+            return false;
+        }
+
+        const uint64_t index_offset = getLE(&trailer[8], 8);
+        const uint64_t num_blocks = getLE(&trailer[16], 8);
+        if (index_offset > file_size - frame_size)
+            panic("Corrupt index in %s\n", fileName);
+
+        // Read the frames holding the index entries
+        string index(file_size - frame_size - index_offset, '\0');
+        fileStream.seekg(index_offset, ifstream::beg);
+        if (!fileStream.read(&index[0], index.size()))
+            panic("Could not read the index of %s\n", fileName);
+
+        string data;
+        for (size_t pos = 0; pos < index.size(); ) {
+            size_t size = candidate->unwrapSkippable(&index[pos],
+                                                     index.size() - pos,
+                                                     data);
+            if (!size || data.size() < sizeof(indexTag) ||
+                data.compare(0, sizeof(indexTag), indexTag,
+                             sizeof(indexTag)) != 0 ||
+                (data.size() - sizeof(indexTag)) % indexEntrySize) {
+                panic("Corrupt index in %s\n", fileName);
+            }
+            pos += size;
+
+            for (size_t i = sizeof(indexTag); i < data.size();
+                 i += indexEntrySize) {
+                BlockInfo info;
+                info.offset = getLE(&data[i], 8);
+                info.frameSize = getLE(&data[i + 8], 4);
+                info.size = getLE(&data[i + 12], 4);
+                info.messages = getLE(&data[i + 16], 4);
+                info.minTick = getLE(&data[i + 20], 8);
+                info.maxTick = getLE(&data[i + 28], 8);
+                info.minInst = getLE(&data[i + 36], 8);
+                info.maxInst = getLE(&data[i + 44], 8);
+                blocks.push_back(info);
+            }
+        }
+
+        if (blocks.size() != num_blocks || blocks.empty())
+            panic("Corrupt index in %s\n", fileName);
+
+        codec = candidate;
+        prefetchStream.open(fileName.c_str(), ios::in | ios::binary);
+        if (!prefetchStream.good())
+            panic("Could not open %s for reading\n", fileName);
+        return true;
+    }
+
+    return false;
+}
+
+bool
+ProtoInputStream::loadBlock(size_t block)
+{
+    if (block >= blocks.size())
+        return false;
+
+    if (prefetch.valid() && prefetchBlock == block) {
+        blockData = prefetch.get();
+    } else {
+        cancelPrefetch();
+        fetchBlock(fileStream, block, blockData);
+    }
+
+    delete blockStream;
+    blockStream = new io::ArrayInputStream(blockData.data(),
+                                           blockData.size());
+    zeroCopyStream = blockStream;
+    nextBlock = block + 1;
+
+    // Get the next block ready while this one is read
+    if (nextBlock < blocks.size()) {
+        const size_t next = nextBlock;
+        prefetchBlock = next;
+        prefetch = async(launch::async, [this, next]{
+            string data;
+            fetchBlock(prefetchStream, next, data);
+            return data;
+        });
+    }
+
+    return true;
+}
+
+void
+ProtoInputStream::fetchBlock(ifstream &stream, size_t block,
+                             string &data) const
+{
+    const BlockInfo &info = blocks[block];
+    string frame(info.frameSize, '\0');
+    stream.clear();
+    stream.seekg(info.offset, ifstream::beg);
+    if (!stream.read(&frame[0], frame.size()) ||
+        !codec->decompress(frame.data(), frame.size(), info.size, data)) {
+        panic("Could not read block %d of %s\n", block, fileName);
+    }
+}
+
+void
+ProtoInputStream::cancelPrefetch()
+{
+    if (prefetch.valid())
+        prefetch.wait();
+    prefetch = future<string>();
+}
+
+void
+ProtoInputStream::seekBlock(size_t block)
+{
+    if (block >= blocks.size())
+        panic("Can't seek to block %d of %s\n", block, fileName);
+
+    // The first block starts with the magic number
+    if (block == 0)
+        reset();
+    else
+        loadBlock(block);
+}
+
+bool
+ProtoInputStream::skipTo(uint64_t BlockInfo::*min_key,
+                         uint64_t BlockInfo::*max_key, uint64_t key,
+                         uint64_t *block_start)
+{
+    // Blocks without keys, e.g. a block with only a header, have an
+    // empty range and are passed over
+    size_t target = blocks.size();
+    bool has_keys = false;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].*min_key > blocks[i].*max_key)
+            continue;
+        has_keys = true;
+        if (blocks[i].*max_key >= key) {
+            target = i;
+            break;
+        }
+    }
+
+    if (!has_keys)
+        return false;
+
+    if (block_start)
+        *block_start = target == blocks.size() ? key :
+            min(key, blocks[target].*min_key);
+
+    // Nothing is left to read if all the keys are before the one we
+    // look for
+    const size_t current = nextBlock - 1;
+    if (target == blocks.size()) {
+        cancelPrefetch();
+        blockData.clear();
+        delete blockStream;
+        blockStream = new io::ArrayInputStream(blockData.data(), 0);
+        zeroCopyStream = blockStream;
+        nextBlock = blocks.size();
+    } else if (target > current) {
+        loadBlock(target);
+    }
+
+    return true;
+}
+
+bool
+ProtoInputStream::skipToTick(uint64_t tick, uint64_t *block_start)
+{
+    return codec &&
+        skipTo(&BlockInfo::minTick, &BlockInfo::maxTick, tick, block_start);
+}
+
+bool
+ProtoInputStream::skipToInst(uint64_t inst, uint64_t *block_start)
+{
+    return codec &&
+        skipTo(&BlockInfo::minInst, &BlockInfo::maxInst, inst, block_start);
+}
+
 
 ProtoInputStream::~ProtoInputStream()
 {
     destroyStreams();
     fileStream.close();
+    prefetchStream.close();
 }
 
 
@@ -180,22 +635,26 @@ ProtoInputStream::read(Message& msg)
     // a limit when parsing the message, then popping the limit again
     uint32_t size;
 
-    // Due to the byte limit of the coded stream we create it for
-    // every single mesage (based on forum discussions around the size
-    // limitation)
-    io::CodedInputStream codedStream(zeroCopyStream);
-    if (codedStream.ReadVarint32(&size)) {
-        io::CodedInputStream::Limit limit = codedStream.PushLimit(size);
-        if (msg.ParseFromCodedStream(&codedStream)) {
-            codedStream.PopLimit(limit);
-            // All went well, the message is parsed and the limit is
-            // popped again
-            return true;
-        } else {
-            panic("Unable to read message from coded stream %s\n",
-                  fileName);
+    do {
+        // Due to the byte limit of the coded stream we create it for
+        // every single mesage (based on forum discussions around the size
+        // limitation)
+        io::CodedInputStream codedStream(zeroCopyStream);
+        if (codedStream.ReadVarint32(&size)) {
+            io::CodedInputStream::Limit limit = codedStream.PushLimit(size);
+            if (msg.ParseFromCodedStream(&codedStream)) {
+                codedStream.PopLimit(limit);
+                // All went well, the message is parsed and the limit is
+                // popped again
+                return true;
+            } else {
+                panic("Unable to read message from coded stream %s\n",
+                      fileName);
+            }
         }
-    }
+        // The blocks of an indexed stream end with a whole message, so
+        // carry on with the next one
+    } while (codec && loadBlock(nextBlock));
 
     return false;
 }
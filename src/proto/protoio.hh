@@ -51,7 +51,16 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class BlockCodec;
 
 /**
  * A ProtoStream provides the shared functionality of the input and
@@ -60,11 +69,44 @@
 class ProtoStream
 {
 
+  public:
+
+    /// Key of a message that is not associated with a tick or instruction
+    static const uint64_t noKey = UINT64_MAX;
+
   protected:
 
     /// Use the ASCII characters gem5 as our magic number
     static const uint32_t magicNumber = 0x356d6567;
 
+    /// Size of the blocks of an indexed stream before compression
+    static const size_t blockSize = 1 << 20;
+
+    /// Where to find a block of an indexed stream
+    struct BlockInfo
+    {
+        /// Offset of the compressed block in the file
+        uint64_t offset;
+        /// Size of the compressed block
+        uint32_t frameSize;
+        /// Size of the block
+        uint32_t size;
+        /// Number of messages in the block
+        uint32_t messages;
+        /// Range of the ticks of the messages, empty if there are none
+        uint64_t minTick;
+        uint64_t maxTick;
+        /// Range of the instructions of the messages, likewise
+        uint64_t minInst;
+        uint64_t maxInst;
+
+        /// Start with no keys, i.e. empty ranges
+        void clearKeys();
+
+        /// Extend the ranges with the keys of a message
+        void addKeys(uint64_t tick, uint64_t inst);
+    };
+
     /**
      * Create a ProtoStream.
      */
@@ -82,12 +124,23 @@ class ProtoStream
 };
 
 /**
- * A ProtoOutputStream wraps a coded stream, potentially with
+ * A ProtoOutputStream writes messages to a file, potentially with
  * compression, based on looking at the file name. Writing to the
  * stream is done to enable interaction with the file on a per-message
  * basis to avoid having to deal with huge data structures. The latter
  * is made possible by encoding the length of each message in the
  * stream.
+ *
+ * Messages are serialised into blocks that are compressed and written
+ * by a pool of worker threads shared by all the streams, so that the
+ * caller only pays for the serialisation. Each block is compressed on
+ * its own, and an index of the blocks is appended to the file in frames
+ * that decompressors skip. The file thus remains a valid gzip or zstd
+ * file of the whole stream, while a ProtoInputStream can seek to any
+ * block and decompress blocks independently. Messages written with a
+ * tick, and optionally an instruction number, extend the ranges kept
+ * for their block in the index, which lets readers start from the
+ * block holding a point of interest.
  */
 class ProtoOutputStream : public ProtoStream
 {
@@ -96,7 +149,8 @@ class ProtoOutputStream : public ProtoStream
 
     /**
      * Create an output stream for a given file name. If the filename
-     * ends with .gz then the file will be compressed accordinly.
+     * ends with .gz or .zst then the file will be compressed with gzip
+     * or zstd accordingly.
      *
      * @param filename Path to the file to create or truncate
      */
@@ -116,19 +170,74 @@ class ProtoOutputStream : public ProtoStream
      */
     void write(const google::protobuf::Message& msg);
 
+    /**
+     * Write a message to the stream and note when it happened in the
+     * index, so that readers can seek to it.
+     *
+     * @param msg Message to write to the stream
+     * @param tick Tick the message refers to
+     * @param inst Instruction number the message refers to, if any
+     */
+    void write(const google::protobuf::Message& msg, uint64_t tick,
+               uint64_t inst = noKey);
+
   private:
 
+    /// A compressed block waiting for the blocks before it
+    struct Frame
+    {
+        std::string data;
+        BlockInfo info;
+    };
+
+    /**
+     * Hand the block being filled to the workers, waiting for earlier
+     * blocks to be written if too many are pending.
+     */
+    void submitBlock();
+
+    /**
+     * Compress a block on a worker thread and write out the blocks
+     * that are ready in order.
+     */
+    void compressBlock(uint64_t seq, std::string &data,
+                       const BlockInfo &info);
+
+    /// Write the blocks that are next in order, with the lock held
+    void writeFrames();
+
+    /// Write the index and the trailer pointing to it
+    void writeIndex();
+
     /// Underlying file output stream
     std::ofstream fileStream;
 
-    /// Zero Copy stream wrapping the STL output stream
-    google::protobuf::io::OstreamOutputStream* wrappedFileStream;
+    /// Hold on to the file name for error messages
+    const std::string fileName;
+
+    /// Compression of the blocks, NULL if uncompressed
+    const BlockCodec *codec;
 
-    /// Optional Gzip stream to wrap the Zero Copy stream
-    google::protobuf::io::GzipOutputStream* gzipStream;
+    /// Block being filled, and its number of messages and key ranges
+    std::string block;
+    BlockInfo blockInfo;
 
-    /// Top-level zero-copy stream, either with compression or not
-    google::protobuf::io::ZeroCopyOutputStream* zeroCopyStream;
+    /// Protects the state shared with the workers below
+    std::mutex mutex;
+
+    /// Signalled whenever a block is written
+    std::condition_variable written;
+
+    /// Number of blocks handed to the workers and written so far
+    uint64_t submittedBlocks;
+    uint64_t writtenBlocks;
+
+    /// Compressed blocks waiting to be written, by sequence number
+    std::map<uint64_t, Frame> ready;
+
+    /// Blocks written so far
+    std::vector<BlockInfo> index;
+    uint64_t fileOffset;
 
 };
 
@@ -138,6 +247,10 @@ class ProtoOutputStream : public ProtoStream
  * stream is done on a per-message basis to avoid having to deal with
  * huge data structures. The latter assumes the length of each message
  * is encoded in the stream when it is written.
+ *
+ * The blocks of an indexed stream are decompressed one at a time, and
+ * the block after the current one is read and decompressed on a helper
+ * thread in the meantime.
  */
 class ProtoInputStream : public ProtoStream
 {
@@ -145,8 +258,9 @@ class ProtoInputStream : public ProtoStream
   public:
 
     /**
-     * Create an input stream for a given file name. If the filename
-     * ends with .gz then the file will be decompressed accordingly.
+     * Create an input stream for a given file name. Gzip compressed
+     * and indexed files are recognised from their contents and
+     * decompressed accordingly.
      *
      * @param filename Path to the file to read from
      */
@@ -171,8 +285,81 @@ class ProtoInputStream : public ProtoStream
      */
     void reset();
 
+    /**
+     * Get the number of blocks in the stream.
+     *
+     * @return The number of blocks, or 0 if the stream is not indexed
+     */
+    size_t numBlocks() const { return blocks.size(); }
+
+    /**
+     * Continue reading with the first message of a block of an
+     * indexed stream.
+     *
+     * @param block Index of the block
+     */
+    void seekBlock(size_t block);
+
+    /**
+     * Skip ahead to the first block that may hold messages of a tick
+     * or later. Reading carries on from the current block if it is
+     * that block or a later one. The messages of the block that are
+     * older than the tick are left for the caller to skip.
+     *
+     * @param tick Tick to skip to
+     * @param block_start Set to the first tick of the block skipped to,
+     *                    or to the tick if all the ticks are before it
+     * @return False if the stream has no ticks to seek by
+     */
+    bool skipToTick(uint64_t tick, uint64_t *block_start = NULL);
+
+    /**
+     * Skip ahead to the first block that may hold messages of an
+     * instruction or a later one, like skipToTick().
+     *
+     * @param inst Instruction number to skip to
+     * @param block_start Set to the first instruction of the block
+     *                    skipped to, like for skipToTick()
+     * @return False if the stream has no instructions to seek by
+     */
+    bool skipToInst(uint64_t inst, uint64_t *block_start = NULL);
+
   private:
 
+    /**
+     * Skip ahead to the first block with a range of keys that ends at
+     * or after a key.
+     */
+    bool skipTo(uint64_t BlockInfo::*min_key, uint64_t BlockInfo::*max_key,
+                uint64_t key, uint64_t *block_start);
+
+    /**
+     * Look for the index at the end of the file.
+     *
+     * @return True if the stream is indexed
+     */
+    bool readIndex();
+
+    /**
+     * Decompress a block of an indexed stream and read from it.
+     *
+     * @return False if there is no such block
+     */
+    bool loadBlock(size_t block);
+
+    /**
+     * Read and decompress a block of an indexed stream.
+     *
+     * @param stream File stream to read the block with
+     * @param block Index of the block
+     * @param data Decompressed block
+     */
+    void fetchBlock(std::ifstream &stream, size_t block,
+                    std::string &data) const;
+
+    /// Wait for the block being prefetched, if any, and drop it
+    void cancelPrefetch();
+
     /**
      * Create the internal streams that are wrapping the input file.
      */
@@ -201,6 +388,25 @@ class ProtoInputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyInputStream* zeroCopyStream;
 
+    /// Compression of the blocks, NULL if the stream is not indexed
+    const BlockCodec *codec;
+
+    /// Index of an indexed stream
+    std::vector<BlockInfo> blocks;
+
+    /// Block that is read after the current one
+    size_t nextBlock;
+
+    /// Current block of an indexed stream and the stream reading it
+    std::string blockData;
+    google::protobuf::io::ArrayInputStream* blockStream;
+
+    /// Block being prefetched, its index, and the file stream used
+    /// by the helper thread to read it
+    std::future<std::string> prefetch;
+    size_t prefetchBlock;
+    std::ifstream prefetchStream;
+
 };
 
 #endif //__PROTO_PROTOIO_HH
@@ -103,6 +103,17 @@ def parse_options():
     group("Statistics Options")
     option("--stats-file", metavar="FILE", default="stats.txt",
         help="Sets the output file for statistics [Default: %default]")
+    option("--stats-columnar", metavar="FILE", default="",
+        help="Also write the statistics in a binary columnar format")
+    option("--stats-server", metavar="PORT|PATH", default="",
+        help="Stream statistics to clients of a localhost TCP port or of " \
+        "a Unix domain socket")
+    option("--stats-server-period", metavar="TIME", default="1ms",
+        help="Simulated time between streamed statistics " \
+        "[Default: %default]")
+    option("--stats-server-stats", metavar="REGEX[,REGEX]", action='append',
+        split=',', help="Only stream the statistics matching a regex " \
+        "[Default: all]")
 
     # Configuration Options
     group("Configuration Options")
@@ -131,6 +142,10 @@ def parse_options():
         help="End debug output at TICK")
     option("--debug-file", metavar="FILE", default="cout",
         help="Sets the output file for debug [Default: %default]")
+    option("--debug-binary", action="store_true", default=False,
+        help="Write the debug output in a compact binary format, to be " \
+             "decoded by util/debugtrace. It goes to debug.bin unless " \
+             "--debug-file names a file")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
@@ -341,6 +356,8 @@ def main(*args):
 
     # set stats options
     stats.addStatVisitor(options.stats_file)
+    if options.stats_columnar:
+        stats.addStatVisitor("columnar://" + options.stats_columnar)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
@@ -395,7 +412,10 @@ def main(*args):
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    debug_file = options.debug_file
+    if options.debug_binary and debug_file in ("cout", "cerr"):
+        debug_file = "debug.bin"
+    trace.output(debug_file, options.debug_binary)
 
     for ignore in options.debug_ignore:
         check_tracing()
@@ -149,6 +149,12 @@ def instantiate(ckpt_dir=None):
     # a checkpoint, If so, this call will shift them to be at a valid time.
     updateStatEvents()
 
+    if options.stats_server:
+        from m5.util import convert
+        period = convert.toLatency(options.stats_server_period)
+        stats.startServer(options.stats_server, ticks.fromSeconds(period),
+                          options.stats_server_stats)
+
 need_startup = True
 def simulate(*args, **kwargs):
     global need_startup
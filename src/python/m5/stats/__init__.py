@@ -102,24 +102,42 @@ def _url_factory(func):
     return wrapper
 
 @_url_factory
-def _textFactory(fn, desc=True):
+def _textFactory(fn, desc=True, changed=False):
     """Output stats in text format.
 
     Text stat files contain one stat per line with an optional
     description. The description is enabled by default, but can be
-    disabled by setting the desc parameter to False.
+    disabled by setting the desc parameter to False. Setting the
+    changed parameter to True only prints the stats that were updated
+    since the last dump.
 
     Example: text://stats.txt?desc=False
 
     """
 
-    return _m5.stats.initText(fn, desc)
+    return _m5.stats.initText(fn, desc, changed)
+
+@_url_factory
+def _columnarFactory(fn, rows=64, level=-1):
+    """Output stats in a binary columnar format.
+
+    Every dump is a row and every stat value a column. The rows are
+    compressed and written out in chunks of the given number of rows,
+    with the given zlib compression level. util/columnar_stats.py
+    prints selected stats as CSV.
+
+    Example: columnar://stats.col?rows=256
+
+    """
+
+    return _m5.stats.initColumnar(fn, rows, level)
 
 factories = {
     # Default to the text factory if we're given a naked path
     "" : _textFactory,
     "file" : _textFactory,
     "text" : _textFactory,
+    "columnar" : _columnarFactory,
 }
 
 def addStatVisitor(url):
@@ -181,6 +199,24 @@ def enable():
 
     _m5.stats.enable();
 
+def startServer(address, period, patterns=None):
+    '''Stream the stats whose names match one of the regular
+    expressions to the clients of a local socket every period ticks.
+    The address is a port on the loopback interface or the path of a
+    Unix domain socket. util/stats_client.py prints the samples.'''
+
+    import re
+
+    regexes = [ re.compile(p) for p in patterns or [ ".*" ] ]
+    selected = [ stat for stat in stats_list
+                 if stat.flags & flags.display and
+                 any(r.search(stat.name) for r in regexes) ]
+    if not selected:
+        fatal("No stats to stream match %s" %
+              ", ".join(r.pattern for r in regexes))
+
+    _m5.stats.startStatServer(address, period, selected)
+
 def prepare():
     '''Prepare all stats for data access.  This must be done before
     dumping and serialization.'''
@@ -202,14 +238,7 @@ def dump():
 
     _m5.stats.processDumpQueue()
 
-    prepare()
-
-    for output in outputList:
-        if output.valid():
-            output.begin()
-            for stat in stats_list:
-                stat.visit(output)
-            output.end()
+    _m5.stats.dumpOutputs(outputList)
 
 def reset():
     '''Reset all statistics to the base state'''
@@ -219,9 +248,8 @@ def reset():
     if root:
         for obj in root.descendants(): obj.resetStats()
 
-    # call any other registered stats reset callbacks
-    for stat in stats_list:
-        stat.reset()
+    # reset the stats that changed since they were last reset
+    _m5.stats.resetUpdated()
 
     _m5.stats.processResetQueue()
 
@@ -49,6 +49,7 @@
 #include <vector>
 
 #include "base/debug.hh"
+#include "base/misc.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
 #include "sim/debug.hh"
@@ -60,10 +61,19 @@ extern int allFlagsVersion;
 }
 
 static void
-output(const char *filename)
+output(const char *filename, bool binary)
 {
     OutputStream *file_stream = simout.find(filename);
 
+    if (binary) {
+        fatal_if(file_stream, "Can't write a binary debug trace to %s, "
+                 "--debug-file must name a file.\n", filename);
+        file_stream = simout.create(filename, true);
+        Trace::setDebugLogger(
+            new Trace::BinaryLogger(*file_stream->stream()));
+        return;
+    }
+
     if (!file_stream)
         file_stream = simout.create(filename);
 
@@ -111,7 +121,8 @@ pybind_init_debug(py::module &m_native)
 
     py::module m_trace = m_native.def_submodule("trace");
     m_trace
-        .def("output", &output)
+        .def("output", &output, py::arg("filename"),
+             py::arg("binary") = false)
         .def("ignore", &ignore)
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
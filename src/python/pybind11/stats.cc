@@ -45,9 +45,11 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
 #include "base/stats/text.hh"
 #include "sim/stat_control.hh"
 #include "sim/stat_register.hh"
+#include "sim/stat_server.hh"
 
 namespace py = pybind11;
 
@@ -77,6 +79,8 @@ pybind_init_stats(py::module &m_native)
     m
         .def("initSimStats", &Stats::initSimStats)
         .def("initText", &Stats::initText, py::return_value_policy::reference)
+        .def("initColumnar", &Stats::initColumnar,
+             py::return_value_policy::reference)
         .def("registerPythonStatsHandlers",
              &Stats::registerPythonStatsHandlers)
         .def("schedStatEvent", &Stats::schedStatEvent)
@@ -85,8 +89,11 @@ pybind_init_stats(py::module &m_native)
         .def("processResetQueue", &Stats::processResetQueue)
         .def("processDumpQueue", &Stats::processDumpQueue)
         .def("enable", &Stats::enable)
+        .def("dumpOutputs", &Stats::dumpOutputs)
+        .def("resetUpdated", &Stats::resetUpdated)
         .def("enabled", &Stats::enabled)
         .def("statsList", &Stats::statsList)
+        .def("startStatServer", &Stats::startStatServer)
         ;
 
     py::class_<Stats::Output>(m, "Output")
@@ -108,6 +115,7 @@ pybind_init_stats(py::module &m_native)
         .def("prepare", &Stats::Info::prepare)
         .def("reset", &Stats::Info::reset)
         .def("zero", &Stats::Info::zero)
+        .def("updated", &Stats::Info::updated)
         .def("visit", &Stats::Info::visit)
         ;
 }
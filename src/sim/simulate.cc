@@ -38,6 +38,7 @@
 
 #include "base/misc.hh"
 #include "base/pollevent.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "sim/async.hh"
 #include "sim/eventq_impl.hh"
@@ -66,6 +67,9 @@ Event *doSimLoop(EventQueue *);
 static void
 thread_loop(EventQueue *queue)
 {
+    // Keep the updates of sharded stats apart from the other threads
+    Stats::addThreadShard();
+
     while (true) {
         threadBarrier->wait();
         doSimLoop(queue);
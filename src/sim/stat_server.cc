@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/stat_server.hh"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+
+#include "base/misc.hh"
+#include "base/stats/info.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+
+using namespace std;
+
+namespace Stats {
+
+static const char magic[] = "gem5stsv";
+static const char schemaTag[] = "SCHM";
+static const char sampleTag[] = "SMPL";
+
+const uint32_t StatServer::version;
+
+template <class T>
+static void
+append(string &frame, const T &value)
+{
+    frame.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+StatServer::ListenEvent::ListenEvent(StatServer *s, int fd, int e)
+    : PollEvent(fd, e), server(s)
+{
+}
+
+void
+StatServer::ListenEvent::process(int revent)
+{
+    server->accept();
+}
+
+StatServer::SampleEvent::SampleEvent(StatServer *s)
+    : GlobalEvent(Stat_Event_Pri, 0), server(s)
+{
+}
+
+void
+StatServer::SampleEvent::process()
+{
+    server->sample();
+    schedule(curTick() + server->period);
+}
+
+StatServer::StatServer(const vector<Info *> &_stats, Tick _period)
+    : listenEvent(NULL), sampleEvent(this), stats(_stats), period(_period)
+{
+    // Name the columns now so that the clients can be told about them
+    // as soon as they connect. Vectors and distributions only know how
+    // many values they have once they are prepared.
+    for (auto info : stats)
+        info->prepare();
+
+    begin();
+    for (auto info : stats)
+        info->visit(*this);
+    end();
+}
+
+StatServer::~StatServer()
+{
+    if (listenEvent) {
+        pollQueue.remove(listenEvent);
+        delete listenEvent;
+    }
+
+    for (auto &client : clients)
+        ::close(client.fd);
+}
+
+bool
+StatServer::valid() const
+{
+    return true;
+}
+
+void
+StatServer::listen(const string &address)
+{
+    char *end;
+    long port = strtol(address.c_str(), &end, 10);
+    bool tcp = !address.empty() && *end == '\0';
+
+    if (tcp && (port <= 0 || port > 65535))
+        fatal("Invalid stats server port %s\n", address);
+
+    bool listening = tcp ? listener.listen(port, true, true) :
+        listener.listen(address);
+    if (!listening)
+        fatal("Can't listen for stats server clients on %s\n", address);
+
+    inform("Streaming stats to clients of %s%s\n",
+           tcp ? "localhost:" : "", address);
+
+    listenEvent = new ListenEvent(this, listener.getfd(), POLLIN);
+    pollQueue.schedule(listenEvent);
+
+    // As for the stat events, the first sample happens only after the
+    // next sync amongst the event queues
+    sampleEvent.schedule(curTick() + period + simQuantum);
+}
+
+void
+StatServer::accept()
+{
+    if (!listener.islistening())
+        panic("Stats server cannot accept a connection if not listening!");
+
+    int fd = listener.accept(true);
+    if (fd != -1)
+        addClient(fd);
+}
+
+void
+StatServer::addClient(int fd)
+{
+    Client client;
+    client.fd = fd;
+    client.pending.assign(magic, sizeof(magic) - 1);
+    append(client.pending, version);
+    append<uint64_t>(client.pending, SimClock::Frequency);
+    append<uint64_t>(client.pending, period);
+    client.pending.append(schemaTag, sizeof(schemaTag) - 1);
+    append<uint32_t>(client.pending, names.size());
+    for (const auto &name : names) {
+        append<uint32_t>(client.pending, name.size());
+        client.pending.append(name);
+    }
+
+    std::lock_guard<std::mutex> lock(clientLock);
+    if (send(client))
+        clients.push_back(std::move(client));
+    else
+        ::close(fd);
+}
+
+bool
+StatServer::send(Client &client)
+{
+    while (!client.pending.empty()) {
+        ssize_t ret = ::send(client.fd, client.pending.data(),
+                             client.pending.size(),
+                             MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        client.pending.erase(0, ret);
+    }
+
+    return true;
+}
+
+void
+StatServer::sample()
+{
+    std::lock_guard<std::mutex> lock(clientLock);
+    if (clients.empty())
+        return;
+
+    for (auto info : stats)
+        info->prepare();
+
+    begin();
+    for (auto info : stats)
+        info->visit(*this);
+    end();
+}
+
+void
+StatServer::end()
+{
+    if (!schemaWritten) {
+        // Unlike the columnar output, the names are kept for the
+        // clients to come
+        numColumns = names.size();
+        schemaWritten = true;
+        return;
+    }
+
+    if (row.size() != numColumns) {
+        fatal("Stats changed from %d to %d values since the server started\n",
+              numColumns, row.size());
+    }
+
+    string frame(sampleTag, sizeof(sampleTag) - 1);
+    append<uint32_t>(frame, row.size());
+    frame.append(reinterpret_cast<const char *>(row.data()),
+                 row.size() * sizeof(Result));
+
+    for (auto it = clients.begin(); it != clients.end(); ) {
+        // A client still busy with the previous sample misses this one
+        // rather than letting its backlog grow
+        bool ok = send(*it);
+        if (ok && it->pending.empty()) {
+            it->pending = frame;
+            ok = send(*it);
+        } else if (ok) {
+            warn_once("Stats server clients are missing samples\n");
+        }
+
+        if (ok) {
+            ++it;
+        } else {
+            ::close(it->fd);
+            it = clients.erase(it);
+        }
+    }
+}
+
+void
+startStatServer(const string &address, Tick period,
+                const vector<Info *> &stats)
+{
+    static StatServer *server = NULL;
+
+    if (server)
+        fatal("The stats server is already running\n");
+    if (period == 0)
+        fatal("The stats server needs a period\n");
+
+    server = new StatServer(stats, period);
+    server->listen(address);
+}
+
+} // namespace Stats
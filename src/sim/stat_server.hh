@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_STAT_SERVER_HH__
+#define __SIM_STAT_SERVER_HH__
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "base/pollevent.hh"
+#include "base/socket.hh"
+#include "base/stats/columnar.hh"
+#include "base/types.hh"
+#include "sim/global_event.hh"
+
+namespace Stats {
+
+class Info;
+
+/**
+ * Stream selected stats to the clients of a local socket while the
+ * simulation runs, so that they can be monitored without dumping them.
+ *
+ * The stats are sampled every period of simulated time, without being
+ * reset, and sent as the same columns as the columnar output. A client
+ * first gets a header, then a sample per period. All integers and
+ * doubles are in host byte order:
+ *   header: "gem5stsv" magic, uint32 version, uint64 ticks per second,
+ *           uint64 period in ticks, "SCHM", uint32 columns, per column
+ *           uint32 length and name
+ *   sample: "SMPL", uint32 columns, the doubles of the columns
+ *
+ * The first column is the tick of the sample. Sending never blocks the
+ * simulation: a client that has not taken the previous sample yet
+ * misses the next ones, and a client that disconnects is dropped.
+ */
+class StatServer : public Columnar
+{
+  public:
+    static const uint32_t version = 1;
+
+  protected:
+    class ListenEvent : public PollEvent
+    {
+      protected:
+        StatServer *server;
+
+      public:
+        ListenEvent(StatServer *s, int fd, int e);
+        void process(int revent);
+    };
+
+    class SampleEvent : public GlobalEvent
+    {
+      protected:
+        StatServer *server;
+
+      public:
+        SampleEvent(StatServer *s);
+        void process();
+        const char *description() const { return "GlobalStatServerEvent"; }
+    };
+
+    struct Client
+    {
+        int fd;
+        /** The part of the frames the socket did not take yet */
+        std::string pending;
+    };
+
+    ListenSocket listener;
+    ListenEvent *listenEvent;
+    SampleEvent sampleEvent;
+
+    /** The stats to stream and how often */
+    std::vector<Info *> stats;
+    Tick period;
+
+    /** Clients are accepted from the poll queue */
+    std::mutex clientLock;
+    std::list<Client> clients;
+
+    /** Send as much of the pending frames of a client as possible. */
+    bool send(Client &client);
+    void accept();
+    /** Send the header to a new client and stream it the samples. */
+    void addClient(int fd);
+
+  public:
+    StatServer(const std::vector<Info *> &stats, Tick period);
+    ~StatServer();
+
+    /**
+     * Listen for clients.
+     *
+     * @param address A port on the loopback interface, or the path of
+     * a Unix domain socket.
+     */
+    void listen(const std::string &address);
+
+    /** Sample the stats for the clients. */
+    void sample();
+
+    // Implement Output
+    virtual bool valid() const;
+    virtual void end();
+};
+
+/**
+ * Start streaming stats over a local socket.
+ *
+ * @param address A port on the loopback interface, or the path of a Unix
+ * domain socket.
+ * @param period The simulated time between samples.
+ * @param stats The stats to stream.
+ */
+void startStatServer(const std::string &address, Tick period,
+                     const std::vector<Info *> &stats);
+
+} // namespace Stats
+
+#endif // __SIM_STAT_SERVER_HH__
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/circular_queue.hh"
+#include "unittest/unittest.hh"
+
+int
+main(int argc, char *argv[])
+{
+    UnitTest::setCase("Push and pop");
+    {
+        CircularQueue<int> queue(3);
+        EXPECT_TRUE(queue.empty());
+        EXPECT_EQ(queue.capacity(), 4);
+
+        queue.push_back(1);
+        queue.push_back(2);
+        queue.push_back(3);
+        EXPECT_EQ(queue.size(), 3);
+        EXPECT_EQ(queue.front(), 1);
+        EXPECT_EQ(queue.back(), 3);
+
+        queue.pop_front();
+        queue.push_back(4);
+        EXPECT_EQ(queue.size(), 3);
+        EXPECT_EQ(queue.front(), 2);
+        EXPECT_EQ(queue.back(), 4);
+
+        queue.pop_back();
+        EXPECT_EQ(queue.size(), 2);
+        EXPECT_EQ(queue.back(), 3);
+
+        queue.clear();
+        EXPECT_TRUE(queue.empty());
+        EXPECT_TRUE(queue.begin() == queue.end());
+    }
+
+    UnitTest::setCase("Iterators across wrap around");
+    {
+        CircularQueue<int> queue(4);
+        for (int i = 0; i < 6; i++) {
+            queue.push_back(i);
+            if (queue.size() > 2)
+                queue.pop_front();
+        }
+
+        // Holds 4 and 5, stored in the last and first slots
+        CircularQueue<int>::iterator it = queue.begin();
+        EXPECT_EQ(*it, 4);
+        ++it;
+        EXPECT_EQ(*it, 5);
+        ++it;
+        EXPECT_TRUE(it == queue.end());
+        --it;
+        EXPECT_EQ(*it, 5);
+
+        int sum = 0;
+        for (it = queue.begin(); it != queue.end(); it++)
+            sum += *it;
+        EXPECT_EQ(sum, 9);
+    }
+
+    UnitTest::setCase("Iterator stability");
+    {
+        CircularQueue<int> queue(4);
+        CircularQueue<int>::iterator end = queue.end();
+        queue.push_back(1);
+        CircularQueue<int>::iterator first = queue.begin();
+        queue.push_back(2);
+        queue.push_back(3);
+        EXPECT_TRUE(end == queue.end());
+
+        CircularQueue<int>::iterator last = queue.end();
+        --last;
+        queue.pop_front();
+        queue.push_back(4);
+        queue.push_back(5);
+        EXPECT_EQ(*last, 3);
+        EXPECT_TRUE(first != queue.begin());
+
+        ++last;
+        EXPECT_EQ(*last, 4);
+    }
+
+    UnitTest::setCase("Growth");
+    {
+        CircularQueue<int> queue(2);
+        queue.push_back(0);
+        queue.push_back(1);
+        queue.pop_front();
+        queue.push_back(2);
+        CircularQueue<int>::iterator it = queue.begin();
+
+        // Both slots are in use and the oldest element is in the last one
+        queue.push_back(3);
+        queue.push_back(4);
+        EXPECT_EQ(queue.capacity(), 4);
+        EXPECT_EQ(queue.size(), 4);
+        EXPECT_EQ(*it, 1);
+
+        for (int i = 1; i <= 4; i++) {
+            EXPECT_EQ(queue.front(), i);
+            queue.pop_front();
+        }
+        EXPECT_TRUE(queue.empty());
+    }
+
+    return UnitTest::printResults();
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "cpu/o3/iq_matrix.hh"
+#include "unittest/unittest.hh"
+
+int
+main(int argc, char *argv[])
+{
+    UnitTest::setCase("Entry sets");
+    {
+        EntrySet set;
+        set.resize(130);
+        EXPECT_FALSE(set.any());
+        EXPECT_EQ(set.findNext(0), -1);
+
+        set.set(3);
+        set.set(64);
+        set.set(129);
+        EXPECT_TRUE(set.any());
+        EXPECT_TRUE(set.test(64));
+        EXPECT_FALSE(set.test(65));
+        EXPECT_EQ(set.findNext(0), 3);
+        EXPECT_EQ(set.findNext(4), 64);
+        EXPECT_EQ(set.findNext(65), 129);
+        EXPECT_EQ(set.findNext(130), -1);
+
+        EntrySet other;
+        other.resize(130);
+        other.set(64);
+        EXPECT_TRUE(set.intersects(other));
+
+        set.removeUnlessAll(other);
+        EXPECT_FALSE(set.test(64));
+        EXPECT_TRUE(set.test(3));
+
+        set.reset(3);
+        set.reset(129);
+        other.set(128);
+        set.set(128);
+        set.removeUnlessAll(other);
+        EXPECT_TRUE(set.test(128));
+
+        set.clear();
+        EXPECT_FALSE(set.any());
+    }
+
+    UnitTest::setCase("Oldest entry");
+    {
+        AgeMatrix ages;
+        EntrySet occupied, requests;
+        ages.resize(8);
+        occupied.resize(8);
+        requests.resize(8);
+
+        EXPECT_EQ(ages.oldest(requests), -1);
+
+        // Allocate out of slot order
+        const int order[] = { 5, 2, 7, 0 };
+        for (int slot : order) {
+            ages.allocate(slot, occupied);
+            occupied.set(slot);
+        }
+
+        EXPECT_EQ(ages.oldest(occupied), 5);
+        requests.set(7);
+        requests.set(0);
+        EXPECT_EQ(ages.oldest(requests), 7);
+        requests.set(2);
+        EXPECT_EQ(ages.oldest(requests), 2);
+    }
+
+    UnitTest::setCase("Oldest entry across renumbering");
+    {
+        const int num_entries = 70;
+        AgeMatrix ages;
+        EntrySet occupied;
+        ages.resize(num_entries);
+        occupied.resize(num_entries);
+
+        std::mt19937 rng(1);
+        std::map<int, uint64_t> seq;
+        uint64_t next_seq = 0;
+        bool all_ok = true;
+
+        for (int step = 0; step < 5000; ++step) {
+            int slot = rng() % num_entries;
+            if (occupied.test(slot)) {
+                occupied.reset(slot);
+                seq.erase(slot);
+            } else {
+                ages.allocate(slot, occupied);
+                occupied.set(slot);
+                seq[slot] = next_seq++;
+            }
+
+            EntrySet requests;
+            requests.resize(num_entries);
+            int expected = -1;
+            for (const auto &entry : seq) {
+                if (rng() % 2) {
+                    requests.set(entry.first);
+                    if (expected < 0 || entry.second < seq[expected])
+                        expected = entry.first;
+                }
+            }
+
+            all_ok = all_ok && ages.oldest(requests) == expected;
+        }
+
+        EXPECT_TRUE(all_ok);
+    }
+
+    return UnitTest::printResults();
+}
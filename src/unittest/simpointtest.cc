@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+
+#include "cpu/simple/probes/simpoint_cluster.hh"
+#include "unittest/unittest.hh"
+
+using namespace std;
+
+typedef SimPointClusterer::Vector Vector;
+
+/** Number of intervals and centre of each group of similar intervals */
+static const size_t groupSizes[] = { 10, 20, 30 };
+static const double groupCentres[][2] = { { 0, 0 }, { 10, 0 }, { 0, 10 } };
+
+/** Group of the intervals added by addGroups() */
+static size_t
+groupOf(size_t interval)
+{
+    size_t group = 0;
+    while (interval >= groupSizes[group])
+        interval -= groupSizes[group++];
+    return group;
+}
+
+static void
+addGroups(SimPointClusterer &clusterer)
+{
+    for (size_t g = 0; g < 3; ++g) {
+        for (size_t i = 0; i < groupSizes[g]; ++i) {
+            Vector vector(2);
+            vector[0] = groupCentres[g][0] + 0.3 * sin(i + 7 * g);
+            vector[1] = groupCentres[g][1] + 0.3 * cos(1.7 * i + g);
+            clusterer.add(vector);
+        }
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    UnitTest::setCase("Projection");
+    {
+        SimPointClusterer clusterer(4, 1);
+        SimPointClusterer same_seed(4, 1);
+        Vector a = clusterer.column();
+        Vector b = clusterer.column();
+        EXPECT_EQ(a.size(), 4);
+        EXPECT_TRUE(a == same_seed.column());
+        EXPECT_TRUE(a != b);
+        for (auto entry : a)
+            EXPECT_TRUE(entry >= -1 && entry < 1);
+
+        // A BBV is projected as the average of the columns of its basic
+        // blocks, weighted by the insts they ran
+        vector<pair<const Vector *, uint64_t>> bbv;
+        bbv.push_back(make_pair(&a, 5));
+        Vector projected = clusterer.project(bbv);
+        for (unsigned i = 0; i < 4; ++i)
+            EXPECT_TRUE(fabs(projected[i] - a[i]) < 1e-12);
+
+        bbv.push_back(make_pair(&b, 15));
+        projected = clusterer.project(bbv);
+        for (unsigned i = 0; i < 4; ++i)
+            EXPECT_TRUE(fabs(projected[i] - (a[i] + 3 * b[i]) / 4) < 1e-12);
+
+        // Intervals running the same code in the same proportions match
+        bbv[0].second = 50;
+        bbv[1].second = 150;
+        EXPECT_TRUE(SimPointClusterer::distance(projected,
+                                                clusterer.project(bbv)) <
+                    1e-20);
+    }
+
+    UnitTest::setCase("K-means");
+    {
+        SimPointClusterer clusterer(2, 1);
+        addGroups(clusterer);
+
+        Random rng(3);
+        SimPointClusterer::Clustering clustering;
+        clusterer.kmeans(3, rng, clustering);
+        EXPECT_EQ(clustering.centers.size(), 3);
+
+        // Each group of intervals makes a cluster of its own
+        set<unsigned> clusters;
+        for (size_t i = 0; i < 60; ++i) {
+            if (i > 0 && groupOf(i) == groupOf(i - 1))
+                EXPECT_EQ(clustering.assignment[i],
+                          clustering.assignment[i - 1]);
+            clusters.insert(clustering.assignment[i]);
+        }
+        EXPECT_EQ(clusters.size(), 3);
+        EXPECT_TRUE(clustering.distortion < 60 * 2 * 0.09);
+    }
+
+    UnitTest::setCase("BIC");
+    {
+        SimPointClusterer clusterer(2, 1);
+        addGroups(clusterer);
+
+        vector<double> scores;
+        for (unsigned k = 1; k <= 5; ++k) {
+            Random rng(5);
+            SimPointClusterer::Clustering clustering;
+            clusterer.kmeans(k, rng, clustering);
+            scores.push_back(clusterer.bic(clustering));
+        }
+        EXPECT_TRUE(scores[2] > scores[0]);
+        EXPECT_TRUE(scores[2] > scores[1]);
+    }
+
+    UnitTest::setCase("Pick");
+    {
+        SimPointClusterer clusterer(2, 1);
+        addGroups(clusterer);
+
+        auto picks = clusterer.pick(8, 5, 0.9);
+        EXPECT_EQ(picks.size(), 3);
+
+        set<size_t> groups;
+        double total = 0;
+        for (const auto &pick : picks) {
+            size_t group = groupOf(pick.interval);
+            groups.insert(group);
+            EXPECT_TRUE(fabs(pick.weight - groupSizes[group] / 60.0) <
+                        1e-12);
+            total += pick.weight;
+        }
+        EXPECT_EQ(groups.size(), 3);
+        EXPECT_TRUE(fabs(total - 1) < 1e-12);
+
+        // A single cluster when asked for, and nothing without intervals
+        EXPECT_EQ(clusterer.pick(1, 5, 0.9).size(), 1);
+        EXPECT_EQ(SimPointClusterer(2, 1).pick(8, 5, 0.9).size(), 0);
+    }
+
+    return UnitTest::printResults();
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/stats/info.hh"
+#include "base/stats/text.hh"
+#include "sim/eventq.hh"
+#include "unittest/unittest.hh"
+
+using namespace std;
+using namespace Stats;
+
+static const Info *
+findStat(const string &name)
+{
+    for (auto info : statsList()) {
+        if (info->name == name)
+            return info;
+    }
+    return NULL;
+}
+
+/** Dump the stats and return the text output, with only the changed stats
+ *  if asked to */
+static string
+dumpText(bool changed_only)
+{
+    ostringstream stream;
+    Text text(stream);
+    text.changedOnly = changed_only;
+    dumpOutputs(vector<Output *>(1, &text));
+    return stream.str();
+}
+
+static bool
+printed(const string &text, const string &name)
+{
+    return text.find(name + " ") != string::npos;
+}
+
+int
+main(int argc, char *argv[])
+{
+    curEventQueue(getEventQueue(0));
+
+    Scalar touched;
+    Scalar untouched;
+    Distribution dist;
+    Average avg;
+    Value value;
+    Formula formula;
+    int counter = 1;
+
+    touched.name("test.touched");
+    untouched.name("test.untouched");
+    dist.init(0, 9, 1).name("test.dist");
+    avg.name("test.avg");
+    value.scalar(counter).name("test.value");
+    formula.name("test.formula");
+    formula = value * 2;
+    Stats::enable();
+
+    touched = 1;
+    untouched = 1;
+    dist.sample(3);
+    dist.sample(5);
+    avg = 4;
+
+    const DistInfo *dist_info =
+        dynamic_cast<const DistInfo *>(findStat("test.dist"));
+    const FormulaInfo *formula_info =
+        dynamic_cast<const FormulaInfo *>(findStat("test.formula"));
+    if (!dist_info || !formula_info)
+        return 1;
+
+    UnitTest::setCase("Prepared data is kept");
+    {
+        dumpText(false);
+        EXPECT_EQ(dist_info->data.samples, 2);
+        EXPECT_EQ(dist_info->data.cvec[5], 1);
+
+        // The distribution is not prepared again, but still dumps what it
+        // was last prepared with
+        string text = dumpText(false);
+        EXPECT_EQ(dist_info->data.samples, 2);
+        EXPECT_EQ(dist_info->data.cvec[3], 1);
+        EXPECT_TRUE(printed(text, "test.dist::samples"));
+
+        dist.sample(7);
+        dumpText(false);
+        EXPECT_EQ(dist_info->data.samples, 3);
+        EXPECT_EQ(dist_info->data.cvec[7], 1);
+    }
+
+    UnitTest::setCase("Changed stats only");
+    {
+        touched++;
+        string text = dumpText(true);
+        EXPECT_TRUE(printed(text, "test.touched"));
+        EXPECT_FALSE(printed(text, "test.untouched"));
+        EXPECT_FALSE(printed(text, "test.dist::samples"));
+        // Values and averages over time always count as changed
+        EXPECT_TRUE(printed(text, "test.value"));
+        EXPECT_TRUE(printed(text, "test.avg"));
+
+        text = dumpText(false);
+        EXPECT_TRUE(printed(text, "test.untouched"));
+        EXPECT_TRUE(printed(text, "test.dist::samples"));
+    }
+
+    UnitTest::setCase("Formula over a value");
+    {
+        dumpText(false);
+        EXPECT_EQ(formula_info->total(), 2);
+
+        // The value changes without any update of a stat
+        counter = 5;
+        EXPECT_EQ(formula_info->total(), 10);
+        EXPECT_EQ(formula_info->result()[0], 10);
+
+        counter = 6;
+        string text = dumpText(true);
+        EXPECT_TRUE(printed(text, "test.formula"));
+        EXPECT_TRUE(text.find("12") != string::npos);
+    }
+
+    UnitTest::setCase("Reset");
+    {
+        // The average accumulates over time even though it is not set
+        curEventQueue()->setCurTick(10);
+        avg = 0;
+        dumpText(false);
+        EXPECT_FALSE(avg.zero());
+
+        resetUpdated();
+        EXPECT_TRUE(avg.zero());
+        EXPECT_EQ(dist_info->data.samples, 3);
+
+        // The distribution was updated since the last reset, so it is
+        // reset too
+        dumpText(false);
+        EXPECT_EQ(dist_info->data.samples, 0);
+        EXPECT_TRUE(untouched.zero());
+    }
+
+    return UnitTest::printResults();
+}
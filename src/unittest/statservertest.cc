@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/stats/info.hh"
+#include "sim/eventq.hh"
+#include "sim/stat_server.hh"
+#include "unittest/unittest.hh"
+
+using namespace std;
+using namespace Stats;
+
+class TestServer : public StatServer
+{
+  public:
+    TestServer(const vector<Info *> &stats)
+        : StatServer(stats, 1000)
+    {}
+
+    using StatServer::addClient;
+};
+
+static string
+readExactly(int fd, size_t size)
+{
+    string data;
+    char buf[4096];
+    while (data.size() < size) {
+        ssize_t ret = ::recv(fd, buf, min(sizeof(buf), size - data.size()),
+                             0);
+        if (ret <= 0)
+            break;
+        data.append(buf, ret);
+    }
+    return data;
+}
+
+template <class T>
+static T
+readValue(int fd)
+{
+    T value = 0;
+    string data = readExactly(fd, sizeof(T));
+    if (data.size() == sizeof(T))
+        memcpy(&value, data.data(), sizeof(T));
+    return value;
+}
+
+static Info *
+findStat(const string &name)
+{
+    for (auto info : statsList()) {
+        if (info->name == name)
+            return info;
+    }
+    return NULL;
+}
+
+static size_t
+column(const vector<string> &names, const string &name)
+{
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name)
+            return i;
+    }
+    return names.size();
+}
+
+static vector<double>
+readSample(int fd)
+{
+    vector<double> values;
+    if (readExactly(fd, 4) != "SMPL")
+        return values;
+    uint32_t columns = readValue<uint32_t>(fd);
+    for (uint32_t i = 0; i < columns; ++i)
+        values.push_back(readValue<double>(fd));
+    return values;
+}
+
+int
+main(int argc, char *argv[])
+{
+    curEventQueue(getEventQueue(0));
+
+    Vector2d pkts;
+    Histogram sizes;
+    pkts.init(2, 3).name("test.pkts");
+    sizes.init(4).name("test.sizes");
+    Stats::enable();
+
+    pkts[1][2] = 5;
+    sizes.sample(3);
+
+    vector<Info *> stats;
+    stats.push_back(findStat("test.pkts"));
+    stats.push_back(findStat("test.sizes"));
+
+    TestServer server(stats);
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+        return 1;
+    server.addClient(fds[0]);
+
+    UnitTest::setCase("Header");
+    vector<string> names;
+    {
+        EXPECT_EQ(readExactly(fds[1], 8), "gem5stsv");
+        EXPECT_EQ(readValue<uint32_t>(fds[1]), StatServer::version);
+        readValue<uint64_t>(fds[1]);
+        EXPECT_EQ(readValue<uint64_t>(fds[1]), 1000);
+        EXPECT_EQ(readExactly(fds[1], 4), "SCHM");
+
+        uint32_t columns = readValue<uint32_t>(fds[1]);
+        for (uint32_t i = 0; i < columns; ++i)
+            names.push_back(readExactly(fds[1], readValue<uint32_t>(fds[1])));
+
+        EXPECT_EQ(names.size(), columns);
+        EXPECT_EQ(names[0], "tick");
+        EXPECT_EQ(column(names, "test.pkts_0::0"), 1);
+        EXPECT_EQ(column(names, "test.pkts_1::2"), 6);
+        EXPECT_TRUE(column(names, "test.sizes::samples") < names.size());
+        EXPECT_TRUE(column(names, "test.sizes::total") < names.size());
+        EXPECT_TRUE(column(names, "test.sizes::bucket_3") < names.size());
+    }
+
+    UnitTest::setCase("Samples");
+    {
+        server.sample();
+        vector<double> values = readSample(fds[1]);
+        EXPECT_EQ(values.size(), names.size());
+        if (values.size() == names.size()) {
+            EXPECT_EQ(values[column(names, "test.pkts_1::2")], 5);
+            EXPECT_EQ(values[column(names, "test.pkts_0::1")], 0);
+            EXPECT_EQ(values[column(names, "test.sizes::samples")], 1);
+            EXPECT_EQ(values[column(names, "test.sizes::bucket_size")], 1);
+            EXPECT_EQ(values[column(names, "test.sizes::bucket_3")], 1);
+        }
+
+        pkts[0][1] += 2;
+        sizes.sample(1);
+        sizes.sample(2);
+        server.sample();
+        values = readSample(fds[1]);
+        EXPECT_EQ(values.size(), names.size());
+        if (values.size() == names.size()) {
+            EXPECT_EQ(values[column(names, "test.pkts_1::2")], 5);
+            EXPECT_EQ(values[column(names, "test.pkts_0::1")], 2);
+            EXPECT_EQ(values[column(names, "test.sizes::samples")], 3);
+        }
+
+        // The buckets of the histogram grow, and the rows say so under
+        // the same columns
+        sizes.sample(100);
+        server.sample();
+        values = readSample(fds[1]);
+        EXPECT_EQ(values.size(), names.size());
+        if (values.size() == names.size()) {
+            EXPECT_EQ(values[column(names, "test.sizes::min")], 0);
+            EXPECT_EQ(values[column(names, "test.sizes::bucket_size")], 32);
+            EXPECT_EQ(values[column(names, "test.sizes::bucket_0")], 3);
+            EXPECT_EQ(values[column(names, "test.sizes::bucket_3")], 1);
+        }
+    }
+
+    ::close(fds[1]);
+
+    return UnitTest::printResults();
+}
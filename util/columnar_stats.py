@@ -0,0 +1,135 @@
+#!/usr/bin/env python2
+
+# Copyright (c) 2026
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script reads the stats written by the columnar stats output, e.g.
+# with --stats-file=columnar://stats.col, and prints the selected stats
+# of every dump as CSV. Only the columns of the selected stats are
+# decompressed.
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+
+def read_exactly(f, size):
+    data = f.read(size)
+    if len(data) != size:
+        raise EOFError("Truncated stats file")
+    return data
+
+def read_uint32(f):
+    return struct.unpack("=I", read_exactly(f, 4))[0]
+
+def decode_column(data, rows):
+    """Undo the byte shuffling and the XOR with the previous row"""
+    data = bytearray(zlib.decompress(data))
+    values = []
+    prev = 0
+    for r in range(rows):
+        bits = 0
+        for b in range(8):
+            bits |= data[b * rows + r] << (b * 8)
+        prev ^= bits
+        values.append(struct.unpack("=d", struct.pack("=Q", prev))[0])
+    return values
+
+def read_stats(f, selected=None):
+    """Yield the names of the columns, then the selected rows"""
+    if read_exactly(f, 8) != b"gem5stcl":
+        raise ValueError("Not a columnar stats file")
+    version = read_uint32(f)
+    if version != 1:
+        raise ValueError("Unsupported version %d" % version)
+
+    columns = None
+    while True:
+        tag = f.read(4)
+        if not tag:
+            return
+        if tag == b"SCHM":
+            names = []
+            for i in range(read_uint32(f)):
+                names.append(read_exactly(f, read_uint32(f)).decode())
+            columns = [i for i, name in enumerate(names)
+                       if selected is None or selected(name)]
+            yield [names[i] for i in columns]
+        elif tag == b"CHNK":
+            rows = read_uint32(f)
+            num_columns = read_uint32(f)
+            sizes = struct.unpack("=%dI" % num_columns,
+                                  read_exactly(f, 4 * num_columns))
+            start = f.tell()
+            offsets = []
+            offset = start
+            for size in sizes:
+                offsets.append(offset)
+                offset += size
+            values = []
+            for i in columns:
+                f.seek(offsets[i])
+                values.append(decode_column(read_exactly(f, sizes[i]), rows))
+            f.seek(offset)
+            for r in range(rows):
+                yield [column[r] for column in values]
+        else:
+            raise ValueError("Unknown record %r" % tag)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Print columnar stats as CSV")
+    parser.add_argument("file", help="Columnar stats file")
+    parser.add_argument("-s", "--stat", action="append", default=[],
+                        help="Regular expression matching the stats to " \
+                        "print, all of them by default")
+    parser.add_argument("-l", "--list", action="store_true",
+                        help="List the stats in the file")
+    args = parser.parse_args()
+
+    selected = None
+    if args.stat:
+        patterns = [re.compile(p) for p in args.stat]
+        selected = lambda name: name == "tick" or \
+            any(p.search(name) for p in patterns)
+
+    with open(args.file, "rb") as f:
+        stats = read_stats(f, selected)
+        header = next(stats, None)
+        if header is None:
+            return
+        if args.list:
+            print("\n".join(header[1:]))
+            return
+
+        print(",".join(header))
+        for row in stats:
+            print(",".join("%d" % v if v.is_integer() else repr(v)
+                           for v in row))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Turn a debug trace recorded with --debug-binary into the text gem5
+ * writes without it. The trace is read from a file, or from the standard
+ * input if the file is "-", e.g. to decompress it on the fly:
+ *
+ *   decode_debug_trace m5out/trace.bin > trace.txt
+ *   zcat m5out/trace.bin.gz | decode_debug_trace - > trace.txt
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/binary_trace.hh"
+#include "base/cprintf.hh"
+
+using namespace BinaryTrace;
+
+static const uint64_t maxTick = std::numeric_limits<uint64_t>::max();
+
+static void
+error(const std::string &msg)
+{
+    std::cerr << "decode_debug_trace: " << msg << std::endl;
+    std::exit(1);
+}
+
+/** Reads the values of a chunk, checking that they are within it */
+class ChunkReader
+{
+  public:
+    ChunkReader(const std::vector<uint8_t> &data)
+        : p(data.data()), end(data.data() + data.size())
+    {}
+
+    bool atEnd() const { return p == end; }
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        memcpy(&value, consume(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string
+    getString()
+    {
+        uint32_t len = get<uint32_t>();
+        const char *s = reinterpret_cast<const char *>(consume(len));
+        return std::string(s, len);
+    }
+
+  private:
+    const uint8_t *
+    consume(size_t bytes)
+    {
+        if (size_t(end - p) < bytes)
+            error("truncated record");
+        const uint8_t *data = p;
+        p += bytes;
+        return data;
+    }
+
+    const uint8_t *p;
+    const uint8_t *end;
+};
+
+class Decoder
+{
+  public:
+    Decoder(std::istream &in, std::ostream &out) : in(in), out(out) {}
+
+    void
+    run()
+    {
+        char file_magic[sizeof(magic)];
+        if (!read(file_magic, sizeof(file_magic)) ||
+            memcmp(file_magic, magic, sizeof(magic)) != 0) {
+            error("not a binary debug trace");
+        }
+
+        uint32_t file_version;
+        if (!read(&file_version, sizeof(file_version)) ||
+            file_version != version) {
+            error("unsupported trace version");
+        }
+
+        uint8_t type;
+        while (read(&type, sizeof(type))) {
+            switch (type) {
+              case DefinitionBlock:
+                definition();
+                break;
+              case ChunkBlock:
+                chunk();
+                break;
+              default:
+                error("unknown block type");
+            }
+        }
+    }
+
+  private:
+    bool
+    read(void *data, size_t bytes)
+    {
+        in.read(static_cast<char *>(data), bytes);
+        if (in.gcount() == 0 && bytes)
+            return false;
+        if (size_t(in.gcount()) != bytes)
+            error("truncated trace");
+        return true;
+    }
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        if (!read(&value, sizeof(T)))
+            error("truncated trace");
+        return value;
+    }
+
+    void
+    definition()
+    {
+        uint8_t kind = get<uint8_t>();
+        uint32_t id = get<uint32_t>();
+        std::string s(get<uint32_t>(), '\0');
+        if (!s.empty() && !read(&s[0], s.size()))
+            error("truncated trace");
+
+        if (kind == FormatString)
+            formats[id] = s;
+        else if (kind == ObjectName)
+            names[id] = s;
+        else
+            error("unknown definition kind");
+    }
+
+    void
+    chunk()
+    {
+        get<uint32_t>();  // Thread that recorded the chunk
+        std::vector<uint8_t> data(get<uint32_t>());
+        if (!data.empty() && !read(data.data(), data.size()))
+            error("truncated trace");
+
+        ChunkReader chunk(data);
+        while (!chunk.atEnd()) {
+            uint8_t type = chunk.get<uint8_t>();
+            uint64_t when = chunk.get<uint64_t>();
+            const std::string &name = lookup(names, chunk.get<uint32_t>());
+
+            if (type == MessageRecord) {
+                const std::string &fmt =
+                    lookup(formats, chunk.get<uint32_t>());
+                std::ostringstream line;
+                format(line, fmt, chunk);
+                print(when, name, line.str());
+            } else if (type == TextRecord) {
+                print(when, name, chunk.getString());
+            } else {
+                error("unknown record type");
+            }
+        }
+    }
+
+    const std::string &
+    lookup(const std::unordered_map<uint32_t, std::string> &strings,
+           uint32_t id)
+    {
+        static const std::string empty;
+        if (id == 0)
+            return empty;
+
+        auto it = strings.find(id);
+        if (it == strings.end())
+            error("undefined string");
+        return it->second;
+    }
+
+    /** Format the arguments as their original types */
+    void
+    format(std::ostream &line, const std::string &fmt, ChunkReader &chunk)
+    {
+        cp::Print print(line, fmt);
+
+        for (uint8_t args = chunk.get<uint8_t>(); args; --args) {
+            switch (chunk.get<uint8_t>()) {
+              case BoolArg: print.add_arg(chunk.get<bool>()); break;
+              case CharArg: print.add_arg(chunk.get<char>()); break;
+              case SCharArg: print.add_arg(chunk.get<signed char>()); break;
+              case UCharArg: print.add_arg(chunk.get<unsigned char>()); break;
+              case ShortArg: print.add_arg(chunk.get<short>()); break;
+              case UShortArg:
+                print.add_arg(chunk.get<unsigned short>());
+                break;
+              case IntArg: print.add_arg(chunk.get<int>()); break;
+              case UIntArg: print.add_arg(chunk.get<unsigned int>()); break;
+              case LongArg: print.add_arg(chunk.get<long>()); break;
+              case ULongArg: print.add_arg(chunk.get<unsigned long>()); break;
+              case LongLongArg: print.add_arg(chunk.get<long long>()); break;
+              case ULongLongArg:
+                print.add_arg(chunk.get<unsigned long long>());
+                break;
+              case FloatArg: print.add_arg(chunk.get<float>()); break;
+              case DoubleArg: print.add_arg(chunk.get<double>()); break;
+              case StringArg: print.add_arg(chunk.getString()); break;
+              default:
+                error("unknown argument type");
+            }
+        }
+
+        print.end_args();
+    }
+
+    /** Same layout as Trace::OstreamLogger */
+    void
+    print(uint64_t when, const std::string &name, const std::string &msg)
+    {
+        if (when != maxTick)
+            ccprintf(out, "%7d: ", when);
+
+        if (!name.empty())
+            out << name << ": ";
+
+        out << msg;
+    }
+
+    std::istream &in;
+    std::ostream &out;
+
+    std::unordered_map<uint32_t, std::string> formats;
+    std::unordered_map<uint32_t, std::string> names;
+};
+
+int
+main(int argc, char *argv[])
+{
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <trace file | ->" << std::endl;
+        return 1;
+    }
+
+    std::ifstream file;
+    std::string path(argv[1]);
+    if (path != "-") {
+        file.open(path, std::ios::binary);
+        if (!file)
+            error("can't open " + path);
+    }
+
+    Decoder decoder(path == "-" ? std::cin : file, std::cout);
+    decoder.run();
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#!/usr/bin/env python2
+
+# Copyright (c) 2026
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script connects to the stats server of a running simulation, e.g.
+# one started with --stats-server=/tmp/gem5.sock or --stats-server=7000,
+# and prints the selected stats of every sample as CSV.
+
+import argparse
+import re
+import socket
+import struct
+import sys
+
+def read_exactly(s, size):
+    data = b""
+    while len(data) < size:
+        chunk = s.recv(size - len(data))
+        if not chunk:
+            raise EOFError("Connection closed")
+        data += chunk
+    return data
+
+def read_uint32(s):
+    return struct.unpack("=I", read_exactly(s, 4))[0]
+
+def read_uint64(s):
+    return struct.unpack("=Q", read_exactly(s, 8))[0]
+
+def connect(address):
+    if address.isdigit():
+        return socket.create_connection(("localhost", int(address)))
+    s = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    s.connect(address)
+    return s
+
+def read_samples(s):
+    """Yield the frequency, the period and the names of the columns,
+    then the samples"""
+    if read_exactly(s, 8) != b"gem5stsv":
+        raise ValueError("Not a stats server")
+    version = read_uint32(s)
+    if version != 1:
+        raise ValueError("Unsupported version %d" % version)
+    frequency = read_uint64(s)
+    period = read_uint64(s)
+
+    if read_exactly(s, 4) != b"SCHM":
+        raise ValueError("Missing schema")
+    names = []
+    for i in range(read_uint32(s)):
+        names.append(read_exactly(s, read_uint32(s)).decode())
+    yield frequency, period, names
+
+    while True:
+        if read_exactly(s, 4) != b"SMPL":
+            raise ValueError("Missing sample")
+        columns = read_uint32(s)
+        yield struct.unpack("=%dd" % columns, read_exactly(s, 8 * columns))
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Print the stats streamed by a simulation as CSV")
+    parser.add_argument("address",
+                        help="Port on localhost or Unix domain socket path")
+    parser.add_argument("-s", "--stat", action="append", default=[],
+                        help="Regular expression matching the stats to " \
+                        "print, all of them by default")
+    parser.add_argument("-l", "--list", action="store_true",
+                        help="List the streamed stats")
+    args = parser.parse_args()
+
+    samples = read_samples(connect(args.address))
+    frequency, period, names = next(samples)
+    if args.list:
+        print("\n".join(names[1:]))
+        return
+
+    patterns = [re.compile(p) for p in args.stat]
+    columns = [i for i, name in enumerate(names)
+               if i == 0 or not patterns or
+               any(p.search(name) for p in patterns)]
+
+    print(",".join(names[i] for i in columns))
+    try:
+        for sample in samples:
+            print(",".join("%d" % sample[i] if sample[i].is_integer() else
+                           repr(sample[i]) for i in columns))
+            sys.stdout.flush()
+    except (EOFError, KeyboardInterrupt):
+        pass
+
+if __name__ == "__main__":
+    main()